@@ -0,0 +1,149 @@
+// Source/AudioEngine/BlockEnvelope.cpp
+#include "../Source/AudioEngine/BlockEnvelope.h"
+#include "../Source/AudioEngine/FastMath.h"
+#include <algorithm>
+
+namespace
+{
+    // Exponential segments end within 1e-3 (-60 dB) of their target, then snap to it
+    const float exponentialLog2Residual = std::log2(0.001f);
+}
+
+void BlockEnvelope::prepare(double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    reset(currentValue);
+}
+
+void BlockEnvelope::reset(float value) noexcept
+{
+    currentValue = segmentStart = segmentTarget = value;
+    segmentLength = segmentPosition = 0;
+    stage = Stage::none;
+}
+
+void BlockEnvelope::rampTo(float target, float seconds, Shape shape) noexcept
+{
+    if (stage == Stage::none && target == getTargetValue())
+        return;
+
+    stage = Stage::none;
+    startSegment(target, seconds, shape);
+}
+
+void BlockEnvelope::noteOn() noexcept
+{
+    stage = Stage::attack;
+    startSegment(1.0f, adsr.attack, Shape::linear);
+}
+
+void BlockEnvelope::noteOff() noexcept
+{
+    stage = Stage::release;
+    startSegment(0.0f, adsr.release, Shape::exponential);
+}
+
+void BlockEnvelope::startSegment(float target, float seconds, Shape shape) noexcept
+{
+    segmentStart = currentValue;
+    segmentTarget = target;
+    segmentShape = shape;
+    segmentPosition = 0;
+    segmentLength = static_cast<int>(std::round(juce::jmax(0.0f, seconds) * static_cast<float>(sampleRate)));
+
+    if (segmentLength == 0)
+    {
+        currentValue = target;
+        advanceStage();
+    }
+}
+
+void BlockEnvelope::advanceStage() noexcept
+{
+    switch (stage)
+    {
+        case Stage::attack:
+            stage = Stage::decay;
+            startSegment(adsr.sustain, adsr.decay, Shape::exponential);
+            break;
+
+        case Stage::decay:
+            stage = Stage::sustain;
+            break;
+
+        case Stage::release:
+            stage = Stage::none;
+            break;
+
+        case Stage::sustain:
+        case Stage::none:
+        default:
+            break;
+    }
+}
+
+void BlockEnvelope::process(float* gains, int numSamples) noexcept
+{
+    int done = 0;
+
+    while (done < numSamples)
+    {
+        if (isSettled())
+        {
+            std::fill(gains + done, gains + numSamples, currentValue);
+            return;
+        }
+
+        const int count = juce::jmin(numSamples - done, segmentLength - segmentPosition);
+        renderSegment(gains + done, count);
+
+        segmentPosition += count;
+        done += count;
+        currentValue = gains[done - 1];
+
+        if (segmentPosition >= segmentLength)
+        {
+            // Land exactly on the target (exponential and S-curve ramps end a hair short)
+            currentValue = segmentTarget;
+            segmentLength = segmentPosition = 0;
+            advanceStage();
+        }
+    }
+}
+
+void BlockEnvelope::renderSegment(float* gains, int numSamples) const noexcept
+{
+    // Every value is a function of its position in the segment alone, so the
+    // loops carry no dependency from one sample to the next.
+    const float delta = segmentTarget - segmentStart;
+    const float inverseLength = 1.0f / static_cast<float>(segmentLength);
+    const float firstPosition = static_cast<float>(segmentPosition + 1);
+
+    switch (segmentShape)
+    {
+        case Shape::linear:
+            for (int i = 0; i < numSamples; ++i)
+                gains[i] = segmentStart + delta * ((firstPosition + static_cast<float>(i)) * inverseLength);
+            break;
+
+        case Shape::exponential:
+        {
+            // Remaining distance is delta * 0.001^(position / length)
+            const float exponentPerSample = exponentialLog2Residual * inverseLength;
+            for (int i = 0; i < numSamples; ++i)
+                gains[i] = segmentTarget - delta * FastMath::exp2<FastMath::Precision::fast>((firstPosition + static_cast<float>(i)) * exponentPerSample);
+            break;
+        }
+
+        case Shape::sCurve:
+        {
+            const float phasePerSample = FastMath::pi * inverseLength;
+            for (int i = 0; i < numSamples; ++i)
+                gains[i] = segmentStart + delta * (0.5f - 0.5f * FastMath::cos<FastMath::Precision::fast>((firstPosition + static_cast<float>(i)) * phasePerSample));
+            break;
+        }
+
+        default:
+            break;
+    }
+}
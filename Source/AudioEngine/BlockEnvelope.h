@@ -0,0 +1,81 @@
+// Source/AudioEngine/BlockEnvelope.h
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+
+//==============================================================================
+/*
+    Gain envelope rendered a block at a time.
+
+    The envelope is a sequence of ramp segments. process() fills a whole block
+    of gain values from a closed-form expression of the sample position, with
+    no per-sample state or branches, so each segment's loop vectorises.
+    isSettled() tells the caller when the value is constant, e.g. to skip a
+    silent source entirely.
+
+    Segments come either from rampTo() for one-off transitions (linear,
+    exponential or the S-shaped activation curve), or from the ADSR stages
+    started by noteOn() and noteOff().
+*/
+class BlockEnvelope
+{
+public:
+    enum class Shape
+    {
+        linear,      // Constant slope
+        exponential, // One-pole approach, within -60 dB of the target when the ramp ends
+        sCurve       // Raised cosine: gentle start and finish, used for power up/down
+    };
+
+    struct ADSRParameters
+    {
+        float attack = 0.01f;  // Seconds, linear
+        float decay = 0.1f;    // Seconds, exponential
+        float sustain = 1.0f;  // Level
+        float release = 0.1f;  // Seconds, exponential
+    };
+
+    BlockEnvelope() = default;
+
+    void prepare(double newSampleRate) noexcept;
+
+    /** @brief Jumps to 'value', cancelling any ramp or ADSR stage. */
+    void reset(float value = 0.0f) noexcept;
+
+    /** @brief Ramps from the current value to 'target'. Asking for the target already
+        being approached keeps the running ramp, so this can be called every block.
+    */
+    void rampTo(float target, float seconds, Shape shape = Shape::linear) noexcept;
+
+    void setADSRParameters(const ADSRParameters& newParameters) noexcept { adsr = newParameters; }
+    void noteOn() noexcept;  // Attack from the current value to 1, then decay to sustain
+    void noteOff() noexcept; // Release from the current value to 0
+
+    /** @brief Writes the next numSamples gain values to 'gains'. */
+    void process(float* gains, int numSamples) noexcept;
+
+    /** @brief True while the value is constant: no ramp running and no ADSR stage pending. */
+    bool isSettled() const noexcept { return segmentLength == 0; }
+
+    float getCurrentValue() const noexcept { return currentValue; }
+    float getTargetValue() const noexcept { return isSettled() ? currentValue : segmentTarget; }
+
+private:
+    enum class Stage { none, attack, decay, sustain, release };
+
+    void startSegment(float target, float seconds, Shape shape) noexcept;
+    void renderSegment(float* gains, int numSamples) const noexcept;
+    void advanceStage() noexcept;
+
+    double sampleRate = 44100.0;
+    float currentValue = 0.0f; // Value of the last rendered sample
+
+    float segmentStart = 0.0f;
+    float segmentTarget = 0.0f;
+    int segmentLength = 0;     // 0 when settled
+    int segmentPosition = 0;
+    Shape segmentShape = Shape::linear;
+
+    ADSRParameters adsr;
+    Stage stage = Stage::none;
+};
@@ -0,0 +1,184 @@
+// Source/AudioEngine/EngineSpatializer.cpp
+#include "../Source/AudioEngine/EngineSpatializer.h"
+#include "../Source/AudioEngine/FastMath.h"
+#include <cmath>
+
+void EngineSpatializer::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = static_cast<float>(spec.sampleRate);
+    maxBlockSize = static_cast<int>(spec.maximumBlockSize);
+
+    // The longest delay plus one block of writes ahead of the read position, plus the interpolator's reach
+    const int maxDelaySamples = static_cast<int>(std::ceil(maxDistance / speedOfSound * sampleRate));
+    const int size = juce::nextPowerOfTwo(maxDelaySamples + maxBlockSize + interpolationTaps);
+    delayLine.assign(static_cast<size_t>(size), 0.0f);
+    delayMask = size - 1;
+
+    for (auto& tap : taps)
+        tap.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+    fractions.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+    delayed.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+
+    reset();
+}
+
+void EngineSpatializer::reset() noexcept
+{
+    std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+    writeIndex = 0;
+    airState = 0.0f;
+    hasPosition = false;
+}
+
+void EngineSpatializer::setPosition(float azimuthDegrees, float distanceMetres, float dopplerAmount) noexcept
+{
+    targetAzimuth = juce::jlimit(-90.0f, 90.0f, azimuthDegrees);
+    targetDistance = juce::jlimit(referenceDistance, maxDistance, distanceMetres);
+    targetDoppler = juce::jlimit(0.0f, 1.0f, dopplerAmount);
+}
+
+EngineSpatializer::Targets EngineSpatializer::computeTargets() const noexcept
+{
+    Targets targets;
+
+    // Constant power: -3 dB per side in the centre
+    const float panAngle = (azimuth + 90.0f) * (FastMath::halfPi / 180.0f);
+    const float distanceGain = referenceDistance / distance;
+    targets.leftGain = distanceGain * FastMath::cos<FastMath::Precision::fast>(panAngle);
+    targets.rightGain = distanceGain * FastMath::sin<FastMath::Precision::fast>(panAngle);
+
+    const float maxDelay = static_cast<float>(delayLine.size() - static_cast<size_t>(maxBlockSize + interpolationTaps));
+    targets.delay = juce::jlimit(minDelaySamples, maxDelay, doppler * distance / speedOfSound * sampleRate);
+
+    const float airCutoff = juce::jmin(airCutoffAtSource / (1.0f + distance / airDistanceScale), 0.45f * sampleRate);
+    targets.airCoefficient = 1.0f - std::exp(-FastMath::twoPi * airCutoff / sampleRate);
+    return targets;
+}
+
+void EngineSpatializer::interpolate(int numSamples, float startDelay, float endDelay) noexcept
+{
+    // writeIndex is the slot after the newest sample; the block starts numSamples before it
+    const int blockStart = writeIndex - numSamples;
+    const float delayStep = (endDelay - startDelay) / static_cast<float>(numSamples);
+
+    // Pass 1: gather the four taps around each read position (positions -1, 0, 1, 2)
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float readOffset = static_cast<float>(i) - (startDelay + delayStep * static_cast<float>(i + 1));
+        const float whole = std::floor(readOffset);
+        const int base = blockStart + static_cast<int>(whole) - 1;
+
+        fractions[static_cast<size_t>(i)] = readOffset - whole;
+        for (int t = 0; t < interpolationTaps; ++t)
+            taps[t][static_cast<size_t>(i)] = delayLine[static_cast<size_t>((base + t) & delayMask)];
+    }
+
+    // Pass 2: third-order Lagrange weights, branch-free so the loop vectorises
+    const float* x0 = taps[0].data();
+    const float* x1 = taps[1].data();
+    const float* x2 = taps[2].data();
+    const float* x3 = taps[3].data();
+    const float* d = fractions.data();
+    float* out = delayed.data();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float dm1 = d[i] - 1.0f;
+        const float dm2 = d[i] - 2.0f;
+        const float dp1 = d[i] + 1.0f;
+        const float c0 = -d[i] * dm1 * dm2 * (1.0f / 6.0f);
+        const float c1 = dp1 * dm1 * dm2 * 0.5f;
+        const float c2 = -dp1 * d[i] * dm2 * 0.5f;
+        const float c3 = dp1 * d[i] * dm1 * (1.0f / 6.0f);
+        out[i] = c0 * x0[i] + c1 * x1[i] + c2 * x2[i] + c3 * x3[i];
+    }
+}
+
+template <typename SampleType>
+void EngineSpatializer::process(const juce::dsp::AudioBlock<SampleType>& monoInput, juce::dsp::AudioBlock<SampleType>& output) noexcept
+{
+    const int numSamples = static_cast<int>(juce::jmin(monoInput.getNumSamples(), output.getNumSamples()));
+    if (numSamples <= 0 || monoInput.getNumChannels() == 0 || delayLine.empty())
+        return;
+
+    // Longer blocks are split so the scratch arrays always fit
+    if (numSamples > maxBlockSize)
+    {
+        for (int start = 0; start < numSamples; start += maxBlockSize)
+        {
+            const auto length = static_cast<size_t>(juce::jmin(maxBlockSize, numSamples - start));
+            const auto inputPart = monoInput.getSubBlock(static_cast<size_t>(start), length);
+            auto outputPart = output.getSubBlock(static_cast<size_t>(start), length);
+            process(inputPart, outputPart);
+        }
+        return;
+    }
+
+    // Control rate: glide towards the target, or jump to it after a reset
+    if (hasPosition)
+    {
+        const float smoothing = 1.0f - std::exp(-static_cast<float>(numSamples) / (positionSmoothingSeconds * sampleRate));
+        azimuth += smoothing * (targetAzimuth - azimuth);
+        distance += smoothing * (targetDistance - distance);
+        doppler += smoothing * (targetDoppler - doppler);
+    }
+    else
+    {
+        azimuth = targetAzimuth;
+        distance = targetDistance;
+        doppler = targetDoppler;
+    }
+
+    const Targets next = computeTargets();
+    const Targets start = hasPosition ? current : next;
+    hasPosition = true;
+
+    // Write the block, then read it back through the moving delay
+    const auto* input = monoInput.getChannelPointer(0);
+    for (int i = 0; i < numSamples; ++i)
+        delayLine[static_cast<size_t>((writeIndex + i) & delayMask)] = static_cast<float>(input[i]);
+    writeIndex = (writeIndex + numSamples) & delayMask;
+
+    interpolate(numSamples, start.delay, next.delay);
+
+    // Air absorption
+    float* signal = delayed.data();
+    for (int i = 0; i < numSamples; ++i)
+    {
+        airState += next.airCoefficient * (signal[i] - airState);
+        signal[i] = airState;
+    }
+
+    // Gains ramp from the previous block's values
+    const float step = 1.0f / static_cast<float>(numSamples);
+    const size_t numChannels = output.getNumChannels();
+
+    if (numChannels == 1)
+    {
+        auto* mono = output.getChannelPointer(0);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float position = step * static_cast<float>(i + 1);
+            const float gain = (start.leftGain + start.rightGain) + position * ((next.leftGain + next.rightGain) - (start.leftGain + start.rightGain));
+            mono[i] += static_cast<SampleType>(signal[i] * gain * 0.5f);
+        }
+    }
+    else
+    {
+        // Channels beyond the first two get the centre of the pair
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            const float from = channel == 0 ? start.leftGain : channel == 1 ? start.rightGain : 0.5f * (start.leftGain + start.rightGain);
+            const float to = channel == 0 ? next.leftGain : channel == 1 ? next.rightGain : 0.5f * (next.leftGain + next.rightGain);
+            auto* destination = output.getChannelPointer(channel);
+
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] += static_cast<SampleType>(signal[i] * (from + step * static_cast<float>(i + 1) * (to - from)));
+        }
+    }
+
+    current = next;
+}
+
+template void EngineSpatializer::process<float>(const juce::dsp::AudioBlock<float>&, juce::dsp::AudioBlock<float>&) noexcept;
+template void EngineSpatializer::process<double>(const juce::dsp::AudioBlock<double>&, juce::dsp::AudioBlock<double>&) noexcept;
@@ -0,0 +1,180 @@
+// Source/AudioEngine/EngineUpsampler.cpp
+#include "../Source/AudioEngine/EngineUpsampler.h"
+#include <cmath>
+
+int EngineUpsampler::chooseFactor(double sampleRate, double bandwidth) noexcept
+{
+    if (bandwidth <= 0.0)
+        return 1;
+
+    int result = 1;
+    while (result < maxFactor && sampleRate / (2 * result) * passbandFraction >= bandwidth)
+        result *= 2;
+    return result;
+}
+
+void EngineUpsampler::prepare(const juce::dsp::ProcessSpec& hostSpec, int newFactor)
+{
+    factor = juce::jlimit(1, maxFactor, newFactor);
+
+    // With outputs held over, a host block never needs more than this many low-rate samples
+    const int maxHostBlockSize = juce::jmax(1, static_cast<int>(hostSpec.maximumBlockSize));
+    const int maxLowRateBlockSize = (maxHostBlockSize + factor - 1) / factor;
+    engineSpec = { hostSpec.sampleRate / factor, static_cast<juce::uint32>(maxLowRateBlockSize), hostSpec.numChannels };
+
+    if (factor == 1)
+    {
+        // Full rate: the engine is called directly and nothing here is used
+        phaseCoefficients.clear();
+        history.clear();
+        heldOutputs.clear();
+        lowRateBuffer.setSize(0, 0);
+        upsampled.clear();
+        return;
+    }
+
+    // Blackman-windowed sinc at the low-rate Nyquist frequency, sampled at the host rate.
+    // The window is offset by half a tap so no tap at either end is wasted on zero.
+    const int prototypeLength = factor * tapsPerPhase;
+    const double centre = 0.5 * (prototypeLength - 1);
+    std::vector<double> prototype(static_cast<size_t>(prototypeLength));
+    for (int i = 0; i < prototypeLength; ++i)
+    {
+        const double t = (i - centre) / factor;
+        const double phase = juce::MathConstants<double>::twoPi * (i + 0.5) / prototypeLength;
+        const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        const double sinc = std::abs(t) < 1.0e-9 ? 1.0 : std::sin(juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+        prototype[static_cast<size_t>(i)] = sinc * window;
+    }
+
+    // Phase p, tap j (input m - j) is prototype[p + factor * j]; each phase passes DC at unity
+    phaseCoefficients.assign(static_cast<size_t>(factor), {});
+    for (int p = 0; p < factor; ++p)
+    {
+        double sum = 0.0;
+        for (int j = 0; j < tapsPerPhase; ++j)
+            sum += prototype[static_cast<size_t>(p + factor * j)];
+
+        for (int j = 0; j < tapsPerPhase; ++j)
+            phaseCoefficients[static_cast<size_t>(p)][static_cast<size_t>(tapsPerPhase - 1 - j)]
+                = static_cast<float>(prototype[static_cast<size_t>(p + factor * j)] / sum);
+    }
+
+    const auto numChannels = static_cast<size_t>(hostSpec.numChannels);
+    history.assign(numChannels, std::vector<float>(2 * tapsPerPhase, 0.0f));
+    heldOutputs.assign(numChannels, std::vector<float>(static_cast<size_t>(factor), 0.0f));
+    lowRateBuffer.setSize(static_cast<int>(numChannels), maxLowRateBlockSize);
+    upsampled.assign(static_cast<size_t>(maxLowRateBlockSize * factor), 0.0f);
+
+    reset();
+}
+
+void EngineUpsampler::reset() noexcept
+{
+    for (auto& channelHistory : history)
+        std::fill(channelHistory.begin(), channelHistory.end(), 0.0f);
+    historyPosition = 0;
+    numHeld = 0;
+    heldStart = 0;
+    numChannelsInUse = 0;
+}
+
+template <typename SampleType>
+void EngineUpsampler::process(SoundEngineBase& engine, juce::dsp::AudioBlock<SampleType>& output) noexcept
+{
+    const int numSamples = static_cast<int>(output.getNumSamples());
+    const int numChannels = juce::jmin(static_cast<int>(output.getNumChannels()), lowRateBuffer.getNumChannels());
+    if (numSamples == 0 || numChannels == 0)
+        return;
+
+    // Longer blocks are split so the scratch buffers always fit
+    const int maxHostBlockSize = static_cast<int>(engineSpec.maximumBlockSize) * factor;
+    if (numSamples > maxHostBlockSize)
+    {
+        for (int start = 0; start < numSamples; start += maxHostBlockSize)
+        {
+            auto part = output.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(juce::jmin(maxHostBlockSize, numSamples - start)));
+            process(engine, part);
+        }
+        return;
+    }
+
+    // Channels that join (motion switched off, say) carry on from channel 0 rather than from stale state
+    for (int channel = juce::jmax(1, numChannelsInUse); channel < numChannels; ++channel)
+    {
+        std::copy(history[0].begin(), history[0].end(), history[static_cast<size_t>(channel)].begin());
+        std::copy(heldOutputs[0].begin(), heldOutputs[0].end(), heldOutputs[static_cast<size_t>(channel)].begin());
+    }
+    numChannelsInUse = numChannels;
+
+    // Held outputs first, then as many low-rate samples as the rest of the block needs
+    const int fromHeld = juce::jmin(numHeld, numSamples);
+    const int remaining = numSamples - fromHeld;
+    const int numLowRate = (remaining + factor - 1) / factor;
+
+    auto lowRate = juce::dsp::AudioBlock<float>(lowRateBuffer)
+                       .getSubsetChannelBlock(0, static_cast<size_t>(numChannels))
+                       .getSubBlock(0, static_cast<size_t>(numLowRate));
+    if (numLowRate > 0)
+    {
+        lowRate.clear();
+        juce::dsp::ProcessContextReplacing<float> context(lowRate);
+        engine.processAddingTo(context);
+    }
+
+    int position = historyPosition;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* destination = output.getChannelPointer(static_cast<size_t>(channel));
+        auto* held = heldOutputs[static_cast<size_t>(channel)].data();
+        for (int i = 0; i < fromHeld; ++i)
+            destination[i] += static_cast<SampleType>(held[heldStart + i]);
+
+        if (numLowRate == 0)
+            continue;
+
+        const auto* input = lowRate.getChannelPointer(static_cast<size_t>(channel));
+        auto* channelHistory = history[static_cast<size_t>(channel)].data();
+        float* interpolated = upsampled.data();
+        position = historyPosition;
+
+        for (int j = 0; j < numLowRate; ++j)
+        {
+            channelHistory[position] = input[j];
+            channelHistory[position + tapsPerPhase] = input[j];
+            position = position + 1 == tapsPerPhase ? 0 : position + 1;
+
+            // Oldest to newest input, in the order of the coefficients
+            const float* taps = channelHistory + position;
+            for (const auto& coefficients : phaseCoefficients)
+            {
+                float sum = 0.0f;
+                for (int k = 0; k < tapsPerPhase; ++k)
+                    sum += coefficients[static_cast<size_t>(k)] * taps[k];
+                *interpolated++ = sum;
+            }
+        }
+
+        for (int i = 0; i < remaining; ++i)
+            destination[fromHeld + i] += static_cast<SampleType>(upsampled[static_cast<size_t>(i)]);
+
+        // What the block did not use of the last low-rate sample waits for the next one
+        std::copy(upsampled.begin() + remaining, upsampled.begin() + numLowRate * factor, held);
+    }
+
+    if (numLowRate > 0)
+    {
+        historyPosition = position;
+        numHeld = numLowRate * factor - remaining;
+        heldStart = 0;
+    }
+    else
+    {
+        numHeld -= fromHeld;
+        heldStart += fromHeld;
+    }
+}
+
+template void EngineUpsampler::process<float>(SoundEngineBase&, juce::dsp::AudioBlock<float>&) noexcept;
+template void EngineUpsampler::process<double>(SoundEngineBase&, juce::dsp::AudioBlock<double>&) noexcept;
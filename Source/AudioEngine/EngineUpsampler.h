@@ -0,0 +1,84 @@
+// Source/AudioEngine/EngineUpsampler.h
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <vector>
+#include "../Source/AudioEngine/SoundEngineBase.h"
+
+//==============================================================================
+/*
+    Runs one engine at a fraction of the host rate and brings its output back
+    up to it.
+
+    An engine that declares a bandwidth (SoundEngineBase::getBandwidth()) only
+    needs a sample rate of about four times that bandwidth. chooseFactor() picks
+    the largest power of two, up to maxFactor, that keeps the bandwidth inside
+    passbandFraction of the reduced rate. The engine is prepared with
+    getEngineSpec() and renders directly at that rate; no decimation filter is
+    needed because nothing is ever rendered at the host rate.
+
+    process() renders just enough low-rate samples for the host-rate block and
+    interpolates them with a polyphase FIR: a Blackman-windowed sinc with its
+    cutoff at the low-rate Nyquist frequency, split into 'factor' phases of
+    tapsPerPhase taps. Each output sample is one short dot product over
+    contiguous history, so the upsampler costs tapsPerPhase multiply-adds per
+    host sample and channel, whatever the factor. Images of the passband are
+    about 70 dB down.
+
+    Host blocks need not be multiples of the factor. Outputs of the last
+    low-rate sample that the block did not use are kept for the next one, so
+    the engine runs at most one low-rate sample ahead.
+
+    The interpolator delays the engine by tapsPerPhase / 2 low-rate samples
+    (0.125 ms at a 48 kHz internal rate). The other engines are not delayed to
+    match; an offset this short between layers is not audible.
+*/
+class EngineUpsampler
+{
+public:
+    static constexpr int maxFactor = 8;
+    static constexpr int tapsPerPhase = 12;
+    static constexpr double passbandFraction = 0.25; // Of the reduced rate; images start at 1 - passbandFraction
+
+    EngineUpsampler() = default;
+
+    /** @brief Largest power-of-two factor that keeps 'bandwidth' (Hz) in the passband. 1 for full-band engines (0). */
+    static int chooseFactor(double sampleRate, double bandwidth) noexcept;
+
+    /** @brief Allocates for host blocks of hostSpec.maximumBlockSize at 'factor'. Call off the audio thread. */
+    void prepare(const juce::dsp::ProcessSpec& hostSpec, int factor);
+
+    /** @brief Clears the interpolator history and any held outputs. */
+    void reset() noexcept;
+
+    int getFactor() const noexcept { return factor; }
+
+    /** @brief Spec to prepare the engine with: the reduced rate and its block size. */
+    juce::dsp::ProcessSpec getEngineSpec() const noexcept { return engineSpec; }
+
+    /** @brief Renders 'engine' at the reduced rate and adds it, upsampled, to 'output'. */
+    template <typename SampleType>
+    void process(SoundEngineBase& engine, juce::dsp::AudioBlock<SampleType>& output) noexcept;
+
+private:
+    int factor = 1;
+    juce::dsp::ProcessSpec engineSpec{ 44100.0, 1, 2 };
+
+    // Phase p interpolates p / factor of a sample after the newest input; newest tap last
+    std::vector<std::array<float, tapsPerPhase>> phaseCoefficients;
+
+    // Per channel: doubled history of low-rate samples, and outputs held for the next block
+    std::vector<std::vector<float>> history;
+    std::vector<std::vector<float>> heldOutputs;
+    int historyPosition = 0;
+    int numHeld = 0;
+    int heldStart = 0;
+    int numChannelsInUse = 0;
+
+    // One block: the engine's low-rate output, then one channel of interpolated samples
+    juce::AudioBuffer<float> lowRateBuffer;
+    std::vector<float> upsampled;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineUpsampler)
+};
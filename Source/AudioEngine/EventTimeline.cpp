@@ -0,0 +1,240 @@
+// Source/AudioEngine/EventTimeline.cpp
+#include "../Source/AudioEngine/EventTimeline.h"
+#include <cmath>
+
+EventTimeline::EventTimeline() = default;
+
+void EventTimeline::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    samplesPerBeat = sampleRate * 60.0 / juce::jmax(1.0, transportState.bpm);
+}
+
+void EventTimeline::resetOverrides() noexcept
+{
+    activationLatch = Latch::none;
+    hasSeenParameterTrigger = false;
+    sweepActive = false;
+}
+
+bool EventTimeline::schedule(const TimelineEvent& event)
+{
+    const auto scope = fifo.write(1);
+    if (scope.blockSize1 > 0)
+        fifoEvents[static_cast<size_t>(scope.startIndex1)] = event;
+    else if (scope.blockSize2 > 0)
+        fifoEvents[static_cast<size_t>(scope.startIndex2)] = event;
+    else
+        return false;
+
+    return true;
+}
+
+void EventTimeline::setTransport(const TransportState& transport) noexcept
+{
+    // Where the last block ended, in samples at the tempo it played at
+    const double drift = (transport.ppqPosition - blockStartBeat) * samplesPerBeat;
+    const bool jumped = std::abs(drift) > jumpToleranceSeconds * sampleRate;
+
+    transportState = transport;
+    blockStartBeat = transport.ppqPosition;
+    samplesPerBeat = sampleRate * 60.0 / juce::jmax(1.0, transport.bpm);
+
+    if (jumped)
+        relocate();
+}
+
+void EventTimeline::relocate() noexcept
+{
+    // Events before the new position count as played; the ones after it play again
+    nextEvent = 0;
+    while (nextEvent < numEvents && getUnclampedOffsetOf(events[static_cast<size_t>(nextEvent)]) < 0.0)
+        ++nextEvent;
+    blockEndEvent = nextEvent;
+
+    // A sweep only applies while the playhead is inside it
+    sweepActive = false;
+    for (int i = nextEvent - 1; i >= 0; --i)
+    {
+        const auto& event = events[static_cast<size_t>(i)];
+        if (event.type == TimelineEvent::Type::servoSweep && event.beat + event.lengthInBeats > blockStartBeat)
+        {
+            dispatch(event);
+            break;
+        }
+    }
+}
+
+//==============================================================================
+void EventTimeline::drainFifo() noexcept
+{
+    const auto scope = fifo.read(fifo.getNumReady());
+
+    for (int i = 0; i < scope.blockSize1; ++i)
+        insertSorted(fifoEvents[static_cast<size_t>(scope.startIndex1 + i)]);
+    for (int i = 0; i < scope.blockSize2; ++i)
+        insertSorted(fifoEvents[static_cast<size_t>(scope.startIndex2 + i)]);
+}
+
+void EventTimeline::insertSorted(const TimelineEvent& event) noexcept
+{
+    // Behind the playhead: firing it now would be late, so it is dropped. A sweep
+    // still in progress is kept behind the cursor and picked up where it is.
+    const bool behind = getUnclampedOffsetOf(event) < 0.0;
+    const bool sweepInProgress = event.type == TimelineEvent::Type::servoSweep
+                                 && event.beat + event.lengthInBeats > blockStartBeat;
+    if (behind && !sweepInProgress)
+        return;
+
+    // The array is preallocated. When it is full, the oldest played event makes room;
+    // if none has played yet the new event is dropped.
+    if (numEvents >= maxEvents)
+    {
+        if (nextEvent == 0)
+        {
+            jassertfalse;
+            return;
+        }
+
+        for (int i = 1; i < numEvents; ++i)
+            events[static_cast<size_t>(i - 1)] = events[static_cast<size_t>(i)];
+        --numEvents;
+        --nextEvent;
+        blockEndEvent = juce::jmax(nextEvent, blockEndEvent - 1);
+    }
+
+    // Insertion from the back: events usually arrive in beat order.
+    int index = numEvents;
+    while (index > 0 && events[static_cast<size_t>(index - 1)].beat > event.beat)
+    {
+        events[static_cast<size_t>(index)] = events[static_cast<size_t>(index - 1)];
+        --index;
+    }
+
+    events[static_cast<size_t>(index)] = event;
+    ++numEvents;
+
+    // Equal beats keep their order, so an event at the playhead lands at or after the cursor
+    if (index < nextEvent || (behind && index == nextEvent))
+        ++nextEvent;
+
+    if (behind)
+        dispatch(event);
+}
+
+void EventTimeline::beginBlock(int numSamples) noexcept
+{
+    drainFifo();
+
+    // Everything scheduled before the clear request has been drained by now
+    if (clearRequested.exchange(false))
+    {
+        numEvents = 0;
+        nextEvent = 0;
+        resetOverrides();
+    }
+
+    blockLength = numSamples;
+    blockEndEvent = nextEvent;
+
+    if (!transportState.isPlaying)
+        return;
+
+    while (blockEndEvent < numEvents && getUnclampedOffsetOf(events[static_cast<size_t>(blockEndEvent)]) < numSamples)
+        ++blockEndEvent;
+}
+
+double EventTimeline::getUnclampedOffsetOf(const TimelineEvent& event) const noexcept
+{
+    // First sample at or after the event's beat. The tolerance absorbs the rounding
+    // of host positions accumulated in floating point.
+    return std::ceil((event.beat - blockStartBeat) * samplesPerBeat - 1.0e-6);
+}
+
+int EventTimeline::getOffsetOf(const TimelineEvent& event) const noexcept
+{
+    // Events the playhead skipped within the jump tolerance land on the first sample
+    return static_cast<int>(juce::jlimit(0.0, static_cast<double>(juce::jmax(0, blockLength - 1)), getUnclampedOffsetOf(event)));
+}
+
+double EventTimeline::getBeatAt(int sampleOffset) const noexcept
+{
+    return blockStartBeat + static_cast<double>(sampleOffset) / samplesPerBeat;
+}
+
+int EventTimeline::getNextEventOffset() const noexcept
+{
+    return nextEvent < blockEndEvent ? getOffsetOf(events[static_cast<size_t>(nextEvent)]) : -1;
+}
+
+void EventTimeline::dispatchEventsUpTo(int sampleOffset) noexcept
+{
+    while (nextEvent < blockEndEvent
+           && getOffsetOf(events[static_cast<size_t>(nextEvent)]) <= sampleOffset)
+    {
+        dispatch(events[static_cast<size_t>(nextEvent)]);
+        ++nextEvent;
+    }
+}
+
+void EventTimeline::dispatch(const TimelineEvent& event) noexcept
+{
+    switch (event.type)
+    {
+        case TimelineEvent::Type::powerCoreActivate:
+            activationLatch = Latch::on;
+            break;
+
+        case TimelineEvent::Type::powerCoreDeactivate:
+            activationLatch = Latch::off;
+            break;
+
+        case TimelineEvent::Type::servoSweep:
+            if (event.lengthInBeats > 0.0 && event.startValue > 0.0f && event.endValue > 0.0f)
+            {
+                activeSweep = event;
+                sweepActive = true;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void EventTimeline::applyOverrides(EngineParameterSet& params, int sampleOffset) noexcept
+{
+    // Toggling the parameter hands control back to it
+    const bool parameterTrigger = params.powerCore.activationTrigger;
+    if (hasSeenParameterTrigger && parameterTrigger != lastParameterTrigger)
+        activationLatch = Latch::none;
+    lastParameterTrigger = parameterTrigger;
+    hasSeenParameterTrigger = true;
+
+    if (activationLatch != Latch::none)
+        params.powerCore.activationTrigger = (activationLatch == Latch::on);
+
+    if (sweepActive)
+    {
+        const double progress = (getBeatAt(sampleOffset) - activeSweep.beat) / activeSweep.lengthInBeats;
+
+        if (progress >= 1.0)
+        {
+            sweepActive = false;
+        }
+        else
+        {
+            const auto clamped = static_cast<float>(juce::jmax(0.0, progress));
+            params.servo.pitch = activeSweep.startValue * std::pow(activeSweep.endValue / activeSweep.startValue, clamped);
+        }
+    }
+}
+
+void EventTimeline::endBlock() noexcept
+{
+    if (transportState.isPlaying)
+        blockStartBeat = getBeatAt(blockLength);
+
+    blockEndEvent = nextEvent;
+    blockLength = 0;
+}
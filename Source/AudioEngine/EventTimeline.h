@@ -0,0 +1,144 @@
+// Source/AudioEngine/EventTimeline.h
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "../Source/Parameters/Parameters.h" // For EngineParameterSet
+#include <array>
+#include <atomic>
+
+// Host transport at the start of a block
+struct TransportState
+{
+    bool isPlaying = false;
+    double ppqPosition = 0.0; // In quarter notes
+    double bpm = 120.0;
+};
+
+// A mecha event placed on the musical timeline
+struct TimelineEvent
+{
+    enum class Type
+    {
+        powerCoreActivate,   // Latches the power core on
+        powerCoreDeactivate, // Latches the power core off
+        servoSweep           // Servo pitch from startValue to endValue (Hz) over lengthInBeats
+    };
+
+    Type type = Type::powerCoreActivate;
+    double beat = 0.0;          // PPQ position
+    double lengthInBeats = 0.0; // servoSweep only
+    float startValue = 0.0f;
+    float endValue = 0.0f;
+};
+
+//==============================================================================
+/*
+    Timeline of mecha events scheduled against host transport positions.
+
+    One non-audio thread schedules events through a lock-free FIFO. The audio
+    thread moves them into a fixed-size array kept sorted by beat, and during
+    each block reports the exact sample offset of every event whose beat lies
+    in the block's window [blockStartBeat, blockEndBeat). MechaSoundEngine
+    splits its sub-blocks there, so an event takes effect on its own sample
+    whatever the host buffer size.
+
+    Dispatching moves a cursor through the array; nothing is removed. When the
+    host position jumps (a loop, a rewind, a relocation) the cursor is rebuilt
+    at the new position, so events play again on every pass and the ones that
+    were jumped over do not fire. Events already behind the playhead when they
+    are scheduled are dropped, except a sweep still in progress, which starts
+    part way through. When the array is full, the oldest event behind the
+    cursor makes room for a new one.
+
+    Dispatched events become overrides on top of the parameters:
+    - activation events latch powerCoreActivationTrigger until the parameter
+      itself is toggled again;
+    - a servo sweep replaces the servo pitch (exponentially, in Hz) until it
+      ends, after which the parameter value applies again. A jump into the
+      middle of a sweep picks it up at that point.
+
+    Nothing is dispatched while the transport is stopped.
+*/
+class EventTimeline
+{
+public:
+    EventTimeline();
+
+    void prepare(double newSampleRate);
+
+    /** @brief Releases all overrides. Scheduled events are kept. */
+    void resetOverrides() noexcept;
+
+    //==============================================================================
+    // Producer side: one non-audio thread
+
+    /** @brief Queues an event. Returns false if the queue is full; try again later. */
+    bool schedule(const TimelineEvent& event);
+
+    /** @brief Drops every event scheduled so far, and all overrides, at the start of the next block. */
+    void clear() noexcept { clearRequested.store(true); }
+
+    //==============================================================================
+    // Audio thread
+
+    /** @brief Sets the transport position for the next block (once per host block).
+        A position that is not where the last block ended moves the dispatch cursor there.
+    */
+    void setTransport(const TransportState& transport) noexcept;
+
+    /** @brief Starts a block of numSamples at the current transport position. */
+    void beginBlock(int numSamples) noexcept;
+
+    /** @brief Offset of the next undispatched event in this block, or -1. */
+    int getNextEventOffset() const noexcept;
+
+    /** @brief Dispatches every event due at or before 'sampleOffset'. */
+    void dispatchEventsUpTo(int sampleOffset) noexcept;
+
+    /** @brief Applies the active overrides for the sub-block starting at 'sampleOffset'. */
+    void applyOverrides(EngineParameterSet& params, int sampleOffset) noexcept;
+
+    /** @brief Moves the transport on by the block length. */
+    void endBlock() noexcept;
+
+    static constexpr int fifoSize = 64;
+    static constexpr int maxEvents = 128;
+    static constexpr double jumpToleranceSeconds = 0.005; // Host rounding and tempo changes drift less than this
+
+private:
+    enum class Latch { none, on, off };
+
+    void drainFifo() noexcept;
+    void insertSorted(const TimelineEvent& event) noexcept;
+    void relocate() noexcept;
+    void dispatch(const TimelineEvent& event) noexcept;
+    double getUnclampedOffsetOf(const TimelineEvent& event) const noexcept;
+    int getOffsetOf(const TimelineEvent& event) const noexcept;
+    double getBeatAt(int sampleOffset) const noexcept;
+
+    // Producer -> audio thread
+    juce::AbstractFifo fifo{ fifoSize };
+    std::array<TimelineEvent, fifoSize> fifoEvents;
+    std::atomic<bool> clearRequested{ false };
+
+    // Audio thread only
+    std::array<TimelineEvent, maxEvents> events; // Sorted by beat
+    int numEvents = 0;
+    int nextEvent = 0;     // First event not yet reached by the playhead
+    int blockEndEvent = 0; // First event after the current block
+
+    double sampleRate = 44100.0;
+    TransportState transportState;
+    double blockStartBeat = 0.0;
+    double samplesPerBeat = 22050.0;
+    int blockLength = 0;
+
+    Latch activationLatch = Latch::none;
+    bool lastParameterTrigger = false;
+    bool hasSeenParameterTrigger = false;
+
+    TimelineEvent activeSweep;
+    bool sweepActive = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EventTimeline)
+};
@@ -0,0 +1,115 @@
+// Source/AudioEngine/FastDSP.h
+#pragma once
+
+#include "../Source/AudioEngine/FastMath.h"
+#include <juce_dsp/juce_dsp.h>
+
+//==============================================================================
+/*
+    Mono sine oscillator built on FastMath::sin.
+
+    A drop-in for juce::dsp::Oscillator<float> initialised with std::sin, minus
+    the std::function call per sample and the internal frequency smoothing
+    (parameters already arrive interpolated per sub-block). The phase runs in
+    [-pi, pi), starting at 0.
+*/
+template <FastMath::Precision P>
+class FastSineOscillator
+{
+public:
+    void prepare(const juce::dsp::ProcessSpec& spec) noexcept
+    {
+        sampleRate = static_cast<float>(spec.sampleRate);
+        reset();
+    }
+
+    void reset() noexcept { phase = 0.0f; }
+
+    /** @brief Sets the frequency in Hz, limited to below Nyquist so one wrap per sample is enough. */
+    void setFrequency(float newFrequency) noexcept
+    {
+        increment = juce::jlimit(0.0f, FastMath::pi * 0.999f, FastMath::twoPi * newFrequency / sampleRate);
+    }
+
+    float processSample() noexcept
+    {
+        const float output = FastMath::sin<P>(phase);
+        phase += increment;
+        if (phase >= FastMath::pi)
+            phase -= FastMath::twoPi;
+        return output;
+    }
+
+    /** @brief Moves the phase on by numSamples without producing output, e.g. while the source is silent. */
+    void advance(int numSamples) noexcept
+    {
+        phase += increment * static_cast<float>(numSamples);
+        phase -= FastMath::twoPi * std::floor((phase + FastMath::pi) * FastMath::inverseTwoPi);
+    }
+
+private:
+    float sampleRate = 44100.0f;
+    float phase = 0.0f;
+    float increment = 0.0f;
+};
+
+//==============================================================================
+/*
+    Mono lowpass with the same topology and response as
+    juce::dsp::StateVariableTPTFilter, but with the cutoff prewarp done by
+    FastMath::tan, so the cutoff can be swept every sample without a std::tan
+    call each time.
+*/
+template <FastMath::Precision P>
+class FastTPTLowpass
+{
+public:
+    void prepare(const juce::dsp::ProcessSpec& spec) noexcept
+    {
+        sampleRate = static_cast<float>(spec.sampleRate);
+        updateCoefficients();
+        reset();
+    }
+
+    void reset() noexcept { s1 = s2 = 0.0f; }
+
+    void setCutoffFrequency(float newCutoff) noexcept
+    {
+        cutoff = newCutoff;
+        updateCoefficients();
+    }
+
+    /** @brief Resonance as in the JUCE filter: 1/sqrt(2) is flat, higher values peak. */
+    void setResonance(float newResonance) noexcept
+    {
+        R2 = 1.0f / juce::jmax(newResonance, 0.01f);
+        updateCoefficients();
+    }
+
+    float processSample(float input) noexcept
+    {
+        const float yHP = h * (input - s1 * (g + R2) - s2);
+
+        const float yBP = yHP * g + s1;
+        s1 = yHP * g + yBP;
+
+        const float yLP = yBP * g + s2;
+        s2 = yBP * g + yLP;
+
+        return yLP;
+    }
+
+private:
+    void updateCoefficients() noexcept
+    {
+        const float limitedCutoff = juce::jlimit(10.0f, sampleRate * 0.45f, cutoff);
+        g = FastMath::tan<P>(FastMath::pi * limitedCutoff / sampleRate);
+        h = 1.0f / (1.0f + R2 * g + g * g);
+    }
+
+    float sampleRate = 44100.0f;
+    float cutoff = 1000.0f;
+    float R2 = 1.41421356f; // 1 / resonance
+    float g = 0.0f, h = 0.0f;
+    float s1 = 0.0f, s2 = 0.0f;
+};
@@ -0,0 +1,160 @@
+// Source/AudioEngine/FastMath.h
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/*
+    Approximate math kernels for the per-sample DSP paths.
+
+    Every function is templated on a Precision so each call site states the
+    error it can tolerate; Precision::exact forwards to the std version, which
+    keeps A/B comparisons a one-word change. The approximations are branch-free
+    polynomials or rationals on float, so loops over arrays auto-vectorise.
+
+    Measured maximum errors against the std double-precision results
+    (dense sweeps over the stated domains, float arithmetic):
+
+        function   domain               accurate               fast
+        sin/cos    |x| <= pi            7.7e-7 abs             6.8e-5 abs
+        tanh       all x                2.0e-7 abs             2.4e-2 abs
+        exp2       -126 .. 127          1.6e-7 rel             7.5e-5 rel
+        tan        0 .. 0.45 pi         4.1e-6 rel             3.7e-4 rel
+
+    For reference, -100 dB is 1e-5: 'accurate' is at the level of float
+    rounding and fine for anything audible, 'fast' suits modulators, control
+    signals and coefficient calculation (a 3.7e-4 error in a prewarped cutoff
+    is under a hundredth of a semitone).
+*/
+namespace FastMath
+{
+    enum class Precision
+    {
+        exact,    // std:: functions
+        accurate, // Errors close to float resolution
+        fast      // Cheapest kernels, errors around 1e-4 (tanh: 2e-2)
+    };
+
+    constexpr float pi = 3.14159265358979f;
+    constexpr float halfPi = 1.57079632679490f;
+    constexpr float twoPi = 6.28318530717959f;
+    constexpr float inverseTwoPi = 0.159154943091895f;
+    constexpr float inversePi = 0.318309886183791f;
+    constexpr float maxHalfTurns = 16777216.0f; // 2^24: sin() reduces by half turns, and floats stop resolving them here
+
+    //==============================================================================
+    /** @brief Sine. Arguments are wrapped into one period; the error grows slowly with |x| (3e-6 at |x| = 64).
+        Past |x| = 2^24 pi, where a float no longer resolves the phase, the result is bounded but meaningless. */
+    template <Precision P>
+    inline float sin(float x) noexcept
+    {
+        if constexpr (P == Precision::exact)
+        {
+            return std::sin(x);
+        }
+        else
+        {
+            // Reduce by half turns to [-pi/2, pi/2] using sin(x - q pi) == (-1)^q sin(x).
+            // q is rounded through an int conversion and the sign comes from its
+            // parity: no selects and no std::floor, which GCC only vectorises
+            // with -fno-trapping-math, so loops over arrays of phases vectorise.
+            // The half turns are clamped so the conversion stays defined for huge, infinite
+            // and NaN arguments (the comparisons send NaN to the bound); r is clamped with
+            // them, which only trims float rounding for ordinary arguments. Both compile to
+            // min/max instructions.
+            float turns = x * inversePi;
+            turns = turns < maxHalfTurns ? turns : maxHalfTurns;
+            turns = -maxHalfTurns < turns ? turns : -maxHalfTurns;
+            const int32_t q = static_cast<int32_t>(turns + std::copysign(0.5f, turns));
+            float r = x - pi * static_cast<float>(q);
+            r = r < halfPi ? r : halfPi;
+            r = -halfPi < r ? r : -halfPi;
+            const float sign = 1.0f - 2.0f * static_cast<float>(q & 1);
+            const float r2 = r * r;
+
+            // Odd minimax polynomials on [-pi/2, pi/2]
+            if constexpr (P == Precision::accurate)
+                return sign * r * (0.99999661588f + r2 * (-0.16664828370f + r2 * (0.0083063251034f + r2 * -0.00018363650539f)));
+            else
+                return sign * r * (0.99969677056f + r2 * (-0.16567307331f + r2 * 0.0075143746597f));
+        }
+    }
+
+    /** @brief Cosine, via sin(x + pi/2). */
+    template <Precision P>
+    inline float cos(float x) noexcept
+    {
+        if constexpr (P == Precision::exact)
+            return std::cos(x);
+        else
+            return sin<P>(x + halfPi);
+    }
+
+    /** @brief Tangent for filter prewarping, where x = pi * cutoff / sampleRate lies in [0, pi/2). */
+    template <Precision P>
+    inline float tan(float x) noexcept
+    {
+        if constexpr (P == Precision::exact)
+            return std::tan(x);
+        else
+            return sin<P>(x) / cos<P>(x);
+    }
+
+    //==============================================================================
+    /** @brief 2^x. The result is clamped to the normal float range, 2^-126 .. 2^127. */
+    template <Precision P>
+    inline float exp2(float x) noexcept
+    {
+        if constexpr (P == Precision::exact)
+        {
+            return std::exp2(x);
+        }
+        else
+        {
+            // 2^x = 2^whole * 2^fraction: the fraction by polynomial, the whole part
+            // straight into the float exponent field.
+            x = std::clamp(x, -126.0f, 127.0f);
+            const float whole = std::floor(x);
+            const float f = x - whole;
+
+            float mantissa;
+            if constexpr (P == Precision::accurate)
+                mantissa = 0.99999992507f + f * (0.69315307308f + f * (0.24015361756f + f * (0.055826317258f + f * (0.0089893404420f + f * 0.0018775767221f))));
+            else
+                mantissa = 0.99992522286f + f * (0.69583351453f + f * (0.22606718225f + f * 0.078024524479f));
+
+            const std::int32_t exponentBits = (static_cast<std::int32_t>(whole) + 127) << 23;
+            float scale;
+            std::memcpy(&scale, &exponentBits, sizeof(scale));
+            return mantissa * scale;
+        }
+    }
+
+    //==============================================================================
+    /** @brief Hyperbolic tangent, saturating exactly at +-1. */
+    template <Precision P>
+    inline float tanh(float x) noexcept
+    {
+        if constexpr (P == Precision::exact)
+        {
+            return std::tanh(x);
+        }
+        else if constexpr (P == Precision::accurate)
+        {
+            // tanh(x) = 1 - 2 / (e^2x + 1). At |x| = 9.5 that rounds to exactly +-1 in float
+            // (at 9 it is still one step short).
+            x = std::clamp(x, -9.5f, 9.5f);
+            const float e2x = exp2<Precision::accurate>(x * 2.88539008178f); // 2 / ln(2)
+            return 1.0f - 2.0f / (e2x + 1.0f);
+        }
+        else
+        {
+            // 3/2 Pade approximant, equal to +-1 at |x| = 3
+            x = std::clamp(x, -3.0f, 3.0f);
+            const float x2 = x * x;
+            return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+        }
+    }
+}
@@ -0,0 +1,372 @@
+// Source/AudioEngine/GranularEngine.cpp
+#include "../Source/AudioEngine/GranularEngine.h"
+#include <cmath>
+
+namespace
+{
+    constexpr juce::int64 randomSeed = 0x6772616e; // Same grain sequence on every reset
+    constexpr double defaultSourceSeconds = 1.0;
+}
+
+GranularEngine::GranularEngine()
+    : random(randomSeed)
+{
+    isEnabledFlag = true;
+}
+
+GranularEngine::~GranularEngine()
+{
+    releaseRetiredSources();
+
+    delete pendingSource.exchange(nullptr);
+    for (auto* source : { currentSource, drainingSource })
+        if (source != defaultSource.get())
+            delete source;
+}
+
+//==============================================================================
+void GranularEngine::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    const bool rateChanged = spec.sampleRate != currentSampleRate || defaultSource == nullptr;
+    currentSampleRate = spec.sampleRate;
+    currentBlockSize = static_cast<int>(spec.maximumBlockSize);
+
+    // Not processing, so the handover state can be settled directly
+    releaseRetiredSources();
+    if (drainingSource != defaultSource.get())
+        delete drainingSource;
+    drainingSource = nullptr;
+
+    if (auto* next = pendingSource.exchange(nullptr))
+    {
+        if (currentSource != defaultSource.get())
+            delete currentSource;
+        currentSource = next;
+    }
+
+    if (rateChanged)
+    {
+        const bool usingDefault = currentSource == nullptr || currentSource == defaultSource.get();
+        defaultSource = createGearGrindSource(currentSampleRate);
+        if (usingDefault)
+            currentSource = defaultSource.get();
+    }
+
+    reset();
+}
+
+void GranularEngine::reset()
+{
+    for (auto& grain : grains)
+        grain.source = nullptr;
+
+    numActiveGrains.store(0, std::memory_order_relaxed);
+    spawnAccumulator = 0.0f;
+    random.setSeed(randomSeed);
+}
+
+void GranularEngine::updateParameters(const EngineParameterSet& allParams)
+{
+    currentParams = allParams.granular;
+}
+
+//==============================================================================
+void GranularEngine::setSource(const juce::AudioBuffer<float>& buffer, double sourceSampleRate)
+{
+    const int numChannels = buffer.getNumChannels();
+    const int length = buffer.getNumSamples();
+    if (numChannels == 0 || length == 0 || sourceSampleRate <= 0.0)
+        return;
+
+    auto source = std::make_unique<Source>();
+    source->length = length;
+    source->sampleRate = sourceSampleRate;
+    source->samples.assign(static_cast<size_t>(length) + 1, 0.0f);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::addWithMultiply(source->samples.data(), buffer.getReadPointer(channel),
+                                                     1.0f / static_cast<float>(numChannels), length);
+    source->samples[static_cast<size_t>(length)] = source->samples[0]; // Reads wrap around
+
+    releaseRetiredSources();
+
+    // A source still pending was never seen by the audio thread
+    delete pendingSource.exchange(source.release(), std::memory_order_acq_rel);
+}
+
+void GranularEngine::pickUpPendingSource() noexcept
+{
+    if (drainingSource != nullptr)
+    {
+        for (const auto& grain : grains)
+            if (grain.source == drainingSource)
+                return; // Still playing out; the next source waits
+
+        if (drainingSource != defaultSource.get())
+        {
+            if (retiredFifo.getFreeSpace() == 0)
+                return;
+
+            const auto scope = retiredFifo.write(1);
+            if (scope.blockSize1 > 0)
+                retiredSources[static_cast<size_t>(scope.startIndex1)] = drainingSource;
+            else
+                retiredSources[static_cast<size_t>(scope.startIndex2)] = drainingSource;
+        }
+
+        drainingSource = nullptr;
+    }
+
+    if (pendingSource.load(std::memory_order_relaxed) == nullptr)
+        return;
+
+    if (auto* next = pendingSource.exchange(nullptr, std::memory_order_acq_rel))
+    {
+        drainingSource = currentSource;
+        currentSource = next;
+    }
+}
+
+void GranularEngine::releaseRetiredSources()
+{
+    const auto scope = retiredFifo.read(retiredFifo.getNumReady());
+    for (int i = 0; i < scope.blockSize1; ++i)
+        delete retiredSources[static_cast<size_t>(scope.startIndex1 + i)];
+    for (int i = 0; i < scope.blockSize2; ++i)
+        delete retiredSources[static_cast<size_t>(scope.startIndex2 + i)];
+}
+
+std::unique_ptr<GranularEngine::Source> GranularEngine::createGearGrindSource(double sampleRate)
+{
+    // Gear teeth striking at an uneven rate, each ringing a few inharmonic
+    // partials, over grinding noise that swells with every strike. Strikes
+    // that run past the end wrap to the start, so the buffer loops cleanly.
+    auto source = std::make_unique<Source>();
+    source->sampleRate = sampleRate;
+    source->length = juce::jmax(1, juce::roundToInt(sampleRate * defaultSourceSeconds));
+    source->samples.assign(static_cast<size_t>(source->length) + 1, 0.0f);
+
+    const int length = source->length;
+    auto* samples = source->samples.data();
+    juce::Random generator(randomSeed + 1);
+
+    constexpr std::array<float, 3> partials{ 1730.0f, 2870.0f, 4610.0f };
+    constexpr std::array<float, 3> partialGains{ 1.0f, 0.6f, 0.35f };
+    const int ringLength = juce::roundToInt(sampleRate * 0.012);
+    const float decayPerSample = std::exp(-1.0f / static_cast<float>(sampleRate * 0.003));
+
+    std::vector<float> strikeEnvelope(static_cast<size_t>(length), 0.0f);
+    const double meanToothInterval = sampleRate / 38.0;
+
+    for (double strike = 0.0; strike < length; strike += meanToothInterval * (0.85 + 0.3 * generator.nextDouble()))
+    {
+        const int start = static_cast<int>(strike);
+        const float strength = 0.6f + 0.4f * generator.nextFloat();
+        float envelope = strength;
+
+        for (int n = 0; n < ringLength; ++n)
+        {
+            const float t = static_cast<float>(n / sampleRate);
+            float ring = 0.0f;
+            for (size_t p = 0; p < partials.size(); ++p)
+                ring += partialGains[p] * std::sin(FastMath::twoPi * partials[p] * t);
+
+            const auto index = static_cast<size_t>((start + n) % length);
+            samples[index] += envelope * ring;
+            strikeEnvelope[index] += envelope;
+            envelope *= decayPerSample;
+        }
+    }
+
+    // Grinding noise, lowpassed and swelling with the strikes
+    const float noiseCoefficient = 1.0f - std::exp(-FastMath::twoPi * 3000.0f / static_cast<float>(sampleRate));
+    float noiseState = 0.0f;
+    for (int n = 0; n < length; ++n)
+    {
+        noiseState += noiseCoefficient * ((generator.nextFloat() * 2.0f - 1.0f) - noiseState);
+        samples[n] += noiseState * (0.3f + 0.7f * juce::jmin(1.0f, strikeEnvelope[static_cast<size_t>(n)]));
+    }
+
+    const auto range = juce::FloatVectorOperations::findMinAndMax(samples, length);
+    const float peak = juce::jmax(std::abs(range.getStart()), std::abs(range.getEnd()));
+    if (peak > 0.0f)
+        juce::FloatVectorOperations::multiply(samples, 0.5f / peak, length);
+
+    samples[length] = samples[0];
+    return source;
+}
+
+//==============================================================================
+void GranularEngine::processAddingTo(juce::dsp::ProcessContextReplacing<float>& context)
+{
+    processInternal(context.getOutputBlock());
+}
+
+void GranularEngine::processAddingTo(juce::dsp::ProcessContextReplacing<double>& context)
+{
+    processInternal(context.getOutputBlock());
+}
+
+template <typename SampleType>
+void GranularEngine::processInternal(const juce::dsp::AudioBlock<SampleType>& outputBlock)
+{
+    pickUpPendingSource();
+
+    if (!isEnabledFlag || currentSource == nullptr)
+        return;
+
+    // Grains already playing finish even when the level drops to zero
+    if (currentParams.level < 0.001f && numActiveGrains.load(std::memory_order_relaxed) == 0)
+        return;
+
+    withChannelLayout(outputBlock.getNumChannels(), [&](auto layout)
+    {
+        renderBlock<SampleType, decltype(layout)::value>(outputBlock);
+    });
+}
+
+template <typename SampleType, size_t NumChannels>
+void GranularEngine::renderBlock(const juce::dsp::AudioBlock<SampleType>& outputBlock)
+{
+    // NumChannels is 1 or 2 for the unrolled mono/stereo paths, 0 for any other layout
+    const size_t numChannels = NumChannels > 0 ? NumChannels : outputBlock.getNumChannels();
+    const size_t numSamples = outputBlock.getNumSamples();
+
+    for (size_t start = 0; start < numSamples; start += chunkSize)
+    {
+        const size_t count = juce::jmin(static_cast<size_t>(chunkSize), numSamples - start);
+        renderMono(static_cast<int>(count));
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* output = outputBlock.getChannelPointer(channel) + start;
+            for (size_t sample = 0; sample < count; ++sample)
+                output[sample] += static_cast<SampleType>(monoBuffer[sample]);
+        }
+    }
+}
+
+void GranularEngine::renderMono(int numSamples) noexcept
+{
+    std::fill(monoBuffer.begin(), monoBuffer.begin() + numSamples, 0.0f);
+
+    if (currentParams.level >= 0.001f)
+        spawnGrains(numSamples);
+
+    int active = 0;
+    for (auto& grain : grains)
+    {
+        if (grain.source == nullptr)
+            continue;
+
+        renderGrain(grain, numSamples);
+        active += grain.source != nullptr ? 1 : 0;
+    }
+
+    numActiveGrains.store(active, std::memory_order_relaxed);
+}
+
+void GranularEngine::spawnGrains(int numSamples) noexcept
+{
+    const auto sampleRate = static_cast<float>(currentSampleRate);
+    spawnAccumulator += juce::jmax(0.0f, currentParams.density) * static_cast<float>(numSamples) / sampleRate;
+
+    const int due = static_cast<int>(spawnAccumulator);
+    spawnAccumulator -= static_cast<float>(due); // Grains over the per-chunk cap are dropped, not deferred
+    const int toSpawn = juce::jmin(due, maxNewGrainsPerChunk);
+    if (toSpawn == 0)
+        return;
+
+    const int grainLength = juce::jmax(16, juce::roundToInt(currentParams.grainSize * sampleRate));
+    const float spray = juce::jlimit(0.0f, 1.0f, currentParams.spray);
+
+    // Overlapping grains add up; keep the texture near the level setting
+    const float overlap = juce::jmax(1.0f, currentParams.density * currentParams.grainSize);
+    const float gain = currentParams.level / std::sqrt(overlap);
+
+    size_t slot = 0;
+    for (int i = 0; i < toSpawn; ++i)
+    {
+        while (slot < grains.size() && grains[slot].source != nullptr)
+            ++slot;
+
+        if (slot == grains.size())
+            return; // Pool full: the density limit
+
+        const float pitchJitter = spray * 12.0f * (random.nextFloat() * 2.0f - 1.0f);
+        const float positionJitter = spray * 0.5f * (random.nextFloat() * 2.0f - 1.0f);
+        const float ratio = FastMath::exp2<FastMath::Precision::accurate>((currentParams.pitch + pitchJitter) / 12.0f);
+
+        float position = currentParams.position + positionJitter;
+        position -= std::floor(position);
+
+        auto& grain = grains[slot];
+        grain.source = currentSource;
+        grain.readPosition = static_cast<double>(position) * currentSource->length;
+        grain.readIncrement = ratio * currentSource->sampleRate / currentSampleRate;
+        grain.windowPhase = 0.0f;
+        grain.windowIncrement = 1.0f / static_cast<float>(grainLength);
+        grain.gain = gain;
+        grain.samplesLeft = grainLength;
+        grain.startOffset = i * numSamples / toSpawn;
+    }
+}
+
+void GranularEngine::renderGrain(Grain& grain, int numSamples) noexcept
+{
+    const int start = grain.startOffset;
+    const int count = juce::jmin(numSamples - start, grain.samplesLeft);
+    grain.startOffset = 0;
+
+    // Hann window, vectorised over the chunk
+    const float phase = grain.windowPhase;
+    const float increment = grain.windowIncrement;
+    for (int n = 0; n < count; ++n)
+        windowBuffer[static_cast<size_t>(n)] = 0.5f - 0.5f * FastMath::cos<FastMath::Precision::fast>(FastMath::twoPi * (phase + static_cast<float>(n) * increment));
+
+    // Interpolated read, wrapping around the source
+    const auto* samples = grain.source->samples.data();
+    const double length = grain.source->length;
+    double position = grain.readPosition;
+    for (int n = 0; n < count; ++n)
+    {
+        const auto index = static_cast<int>(position);
+        const auto fraction = static_cast<float>(position - index);
+        grainBuffer[static_cast<size_t>(n)] = samples[index] + fraction * (samples[index + 1] - samples[index]);
+
+        position += grain.readIncrement;
+        if (position >= length)
+            position = std::fmod(position, length);
+    }
+
+    juce::FloatVectorOperations::multiply(grainBuffer.data(), windowBuffer.data(), count);
+    juce::FloatVectorOperations::addWithMultiply(monoBuffer.data() + start, grainBuffer.data(), grain.gain, count);
+
+    grain.readPosition = position;
+    grain.windowPhase += static_cast<float>(count) * increment;
+    grain.samplesLeft -= count;
+    if (grain.samplesLeft <= 0)
+        grain.source = nullptr;
+}
+
+//==============================================================================
+void GranularEngine::setEnabled(bool enabled)
+{
+    isEnabledFlag = enabled;
+}
+
+bool GranularEngine::getEnabled() const
+{
+    return isEnabledFlag;
+}
+
+double GranularEngine::getCPUUsage() const
+{
+    return 0.0;
+}
+
+size_t GranularEngine::getMemoryUsage() const
+{
+    // Loaded sources belong to the audio thread and are not counted
+    return sizeof(*this) + (defaultSource != nullptr ? defaultSource->samples.size() * sizeof(float) : 0);
+}
@@ -0,0 +1,116 @@
+// Source/AudioEngine/GranularEngine.h
+#pragma once
+
+#include "../Source/AudioEngine/SoundEngineBase.h"
+#include "../Source/AudioEngine/FastMath.h"
+#include "../Parameters/Parameters.h" // For EngineParameterSet (needed by updateParameters)
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/*
+    Granular texture engine for gear grind and hydraulic chatter.
+
+    Grains are Hann-windowed snippets of a mono source buffer, each with its
+    own read position, pitch and gain. They come from a fixed pool of
+    maxGrains, so nothing is allocated while playing. When the pool is full,
+    new grains are dropped. This bounds the CPU cost at maxGrains grains,
+    whatever the density and grain size.
+
+    Each grain renders a chunk at a time. The window is computed with
+    FastMath::cos over the chunk and applied with FloatVectorOperations, and
+    both vectorise; only the interpolated source read is per sample.
+
+    The source is a procedural gear grind rendered in prepare(). Any other
+    buffer can replace it through setSource() from a non-audio thread;
+    MechaSoundEngine does this with the recording chosen as the grain source. The swap happens at the start
+    of a block. Grains still reading the previous source play out first, and
+    the old buffer is freed on the next setSource() or prepare() call.
+*/
+class GranularEngine : public SoundEngineBase
+{
+public:
+    static constexpr int maxGrains = 64;
+    static constexpr int maxNewGrainsPerChunk = 8; // Caps bursts at high density
+
+    GranularEngine();
+    ~GranularEngine() override;
+
+    // --- SoundEngineBase overrides ---
+    void prepare(const juce::dsp::ProcessSpec& spec) override;
+    void reset() override;
+    void processAddingTo(juce::dsp::ProcessContextReplacing<float>& context) override;
+    void processAddingTo(juce::dsp::ProcessContextReplacing<double>& context) override;
+    void updateParameters(const EngineParameterSet& allParams) override;
+    void setEnabled(bool enabled) override;
+    bool getEnabled() const override;
+    double getCPUUsage() const override;
+    size_t getMemoryUsage() const override;
+
+    /** @brief Replaces the grain source; channels are mixed to mono. Any non-audio thread. */
+    void setSource(const juce::AudioBuffer<float>& buffer, double sourceSampleRate);
+
+    /** @brief Number of grains currently playing, for metering. */
+    int getNumActiveGrains() const noexcept { return numActiveGrains.load(std::memory_order_relaxed); }
+
+private:
+    struct Source
+    {
+        std::vector<float> samples; // One extra sample at the end, equal to the first, for interpolation
+        int length = 0;
+        double sampleRate = 44100.0;
+    };
+
+    struct Grain
+    {
+        const Source* source = nullptr; // nullptr while the slot is free
+        double readPosition = 0.0;      // In source samples
+        double readIncrement = 1.0;
+        float windowPhase = 0.0f;       // 0-1 over the grain
+        float windowIncrement = 0.0f;
+        float gain = 0.0f;
+        int samplesLeft = 0;
+        int startOffset = 0;            // Samples into the current chunk before the grain starts
+    };
+
+    template <typename SampleType>
+    void processInternal(const juce::dsp::AudioBlock<SampleType>& outputBlock);
+
+    template <typename SampleType, size_t NumChannels>
+    void renderBlock(const juce::dsp::AudioBlock<SampleType>& outputBlock);
+
+    void renderMono(int numSamples) noexcept;
+    void spawnGrains(int numSamples) noexcept;
+    void renderGrain(Grain& grain, int numSamples) noexcept;
+
+    // Source handover
+    void pickUpPendingSource() noexcept;
+    void releaseRetiredSources();
+    static std::unique_ptr<Source> createGearGrindSource(double sampleRate);
+
+    static constexpr int chunkSize = 32;
+    static constexpr int retiredCapacity = 4;
+
+    std::unique_ptr<Source> defaultSource;           // Owned for the engine's lifetime once prepared
+    std::atomic<Source*> pendingSource{ nullptr };   // Set by setSource(), taken by the audio thread
+    Source* currentSource = nullptr;                 // Audio thread
+    Source* drainingSource = nullptr;                // Audio thread: previous source, still read by grains
+    juce::AbstractFifo retiredFifo{ retiredCapacity };
+    std::array<Source*, retiredCapacity> retiredSources{};
+
+    std::array<Grain, maxGrains> grains{};
+    std::atomic<int> numActiveGrains{ 0 };
+    float spawnAccumulator = 0.0f;
+    juce::Random random;
+
+    alignas(16) std::array<float, chunkSize> monoBuffer{};
+    alignas(16) std::array<float, chunkSize> windowBuffer{};
+    alignas(16) std::array<float, chunkSize> grainBuffer{};
+
+    GranularParams currentParams;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GranularEngine)
+};
@@ -0,0 +1,226 @@
+// Source/AudioEngine/ImpulseResponseLibrary.cpp
+#include "../Source/AudioEngine/ImpulseResponseLibrary.h"
+#include <cmath>
+#include <map>
+
+namespace
+{
+    constexpr double rt60Constant = 6.907755; // ln(1000): amplitude falls 60 dB over one RT60
+
+    double getDecayGain(double timeSeconds, double rt60Seconds)
+    {
+        return std::exp(-rt60Constant * timeSeconds / rt60Seconds);
+    }
+
+    // Unit energy, so the wet signal sits at about the level of the dry one
+    void normaliseEnergy(std::vector<float>& impulseResponse)
+    {
+        double energy = 0.0;
+        for (const float sample : impulseResponse)
+            energy += static_cast<double>(sample) * sample;
+
+        if (energy > 0.0)
+        {
+            const auto gain = static_cast<float>(1.0 / std::sqrt(energy));
+            for (auto& sample : impulseResponse)
+                sample *= gain;
+        }
+    }
+
+    // Ringing plates: inharmonic modes, the high ones dying first
+    void addHullModes(std::vector<float>& ir, double sampleRate, juce::Random& random)
+    {
+        constexpr int numModes = 32;
+        const double nyquistLimit = 0.45 * sampleRate;
+
+        for (int mode = 0; mode < numModes; ++mode)
+        {
+            const double frequency = 140.0 * std::pow(1.0 + mode, 1.3) * (0.9 + 0.2 * random.nextDouble());
+            if (frequency >= nyquistLimit)
+                break;
+
+            const double rt60 = juce::jlimit(0.08, 0.9, 0.9 * std::sqrt(300.0 / frequency));
+            const double amplitude = (0.3 + 0.7 * random.nextDouble()) / std::sqrt(1.0 + mode);
+            const double phase = juce::MathConstants<double>::twoPi * random.nextDouble();
+            const double phaseIncrement = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+            for (size_t i = 0; i < ir.size(); ++i)
+            {
+                const double time = static_cast<double>(i) / sampleRate;
+                ir[i] += static_cast<float>(amplitude * getDecayGain(time, rt60) * std::sin(phase + phaseIncrement * static_cast<double>(i)));
+            }
+        }
+
+        // Strike transient
+        const int strikeLength = juce::jmin(static_cast<int>(ir.size()), static_cast<int>(0.005 * sampleRate));
+        for (int i = 0; i < strikeLength; ++i)
+            ir[static_cast<size_t>(i)] += 0.5f * (1.0f - static_cast<float>(i) / static_cast<float>(strikeLength)) * (random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    // Discrete echoes off nearby walls
+    void addEarlyReflections(std::vector<float>& ir, double sampleRate, juce::Random& random,
+                             int numReflections, double firstSeconds, double lastSeconds, double rt60)
+    {
+        for (int i = 0; i < numReflections; ++i)
+        {
+            const double time = firstSeconds + (lastSeconds - firstSeconds) * random.nextDouble();
+            const auto index = static_cast<size_t>(time * sampleRate);
+            if (index >= ir.size())
+                continue;
+
+            const double sign = random.nextBool() ? 1.0 : -1.0;
+            ir[index] += static_cast<float>(sign * (0.4 + 0.6 * random.nextDouble()) * getDecayGain(time, rt60));
+        }
+    }
+
+    // Dense exponentially decaying noise. 'brightness' 0..1 sets the initial one-pole lowpass
+    // and 'darkening' how much it closes over the tail (air absorption).
+    void addDiffuseTail(std::vector<float>& ir, double sampleRate, juce::Random& random,
+                        double onsetSeconds, double rt60, double brightness, double darkening, float level)
+    {
+        const auto onset = static_cast<size_t>(onsetSeconds * sampleRate);
+        const double fadeInSamples = juce::jmax(1.0, 0.02 * sampleRate);
+        float lowpassState = 0.0f;
+
+        for (size_t i = onset; i < ir.size(); ++i)
+        {
+            const double time = static_cast<double>(i) / sampleRate;
+            const double progress = static_cast<double>(i) / static_cast<double>(ir.size());
+            const auto coefficient = static_cast<float>(juce::jlimit(0.02, 1.0, brightness * (1.0 - darkening * progress)));
+
+            lowpassState += coefficient * ((random.nextFloat() * 2.0f - 1.0f) - lowpassState);
+
+            const double fadeIn = juce::jmin(1.0, static_cast<double>(i - onset) / fadeInSamples);
+            ir[i] += level * static_cast<float>(fadeIn * getDecayGain(time, rt60)) * lowpassState;
+        }
+    }
+}
+
+//==============================================================================
+// The kernels for one sample rate, built on their own thread and shared by
+// every library prepared at that rate
+class ImpulseResponseLibrary::KernelSet : private juce::Thread
+{
+public:
+    explicit KernelSet(double rate)
+        : juce::Thread("Impulse response builder"), sampleRate(rate)
+    {
+        for (auto& kernel : published)
+            kernel.store(nullptr);
+
+        startThread();
+    }
+
+    ~KernelSet() override
+    {
+        stopThread(2000);
+    }
+
+    const ConvolutionKernel* getKernel(int space) const noexcept
+    {
+        return published[static_cast<size_t>(space)].load(std::memory_order_acquire);
+    }
+
+private:
+    void run() override
+    {
+        for (int space = off + 1; space < numSpaces; ++space)
+        {
+            if (threadShouldExit())
+                return;
+
+            const auto index = static_cast<size_t>(space);
+            kernels[index] = PartitionedConvolver::createKernel(createImpulseResponse(space, sampleRate));
+            published[index].store(kernels[index].get(), std::memory_order_release);
+        }
+    }
+
+    const double sampleRate;
+    std::array<std::unique_ptr<ConvolutionKernel>, numSpaces> kernels;       // Written by the build thread
+    std::array<std::atomic<const ConvolutionKernel*>, numSpaces> published{}; // Read by the audio threads
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(KernelSet)
+};
+
+//==============================================================================
+ImpulseResponseLibrary::ImpulseResponseLibrary() = default;
+
+ImpulseResponseLibrary::~ImpulseResponseLibrary() = default;
+
+void ImpulseResponseLibrary::prepare(double sampleRate)
+{
+    if (sampleRate <= 0.0 || sampleRate == preparedSampleRate)
+        return;
+
+    // Releasing the old set stops its build if no other library still uses it
+    kernelSet = getSharedKernelSet(sampleRate);
+    preparedSampleRate = sampleRate;
+}
+
+const ConvolutionKernel* ImpulseResponseLibrary::getKernel(int space) const noexcept
+{
+    if (space <= off || space >= numSpaces || kernelSet == nullptr)
+        return nullptr;
+
+    return kernelSet->getKernel(space);
+}
+
+std::shared_ptr<ImpulseResponseLibrary::KernelSet> ImpulseResponseLibrary::getSharedKernelSet(double sampleRate)
+{
+    // Only prepare() comes here, never the audio thread, so a lock is fine.
+    // The cache holds weak references: it never keeps a set alive by itself.
+    static juce::CriticalSection cacheLock;
+    static std::map<double, std::weak_ptr<KernelSet>> cache;
+
+    const juce::ScopedLock lock(cacheLock);
+
+    for (auto it = cache.begin(); it != cache.end();)
+        it = it->second.expired() ? cache.erase(it) : std::next(it);
+
+    auto& entry = cache[sampleRate];
+    if (auto existing = entry.lock())
+        return existing;
+
+    auto created = std::make_shared<KernelSet>(sampleRate);
+    entry = created;
+    return created;
+}
+
+int ImpulseResponseLibrary::getMaxLengthInSamples(double sampleRate) noexcept
+{
+    return static_cast<int>(std::ceil(maxLengthSeconds * sampleRate));
+}
+
+std::vector<float> ImpulseResponseLibrary::createImpulseResponse(int space, double sampleRate)
+{
+    // Fixed seeds: the same space always sounds the same
+    juce::Random random(0x6d656368 + space);
+    std::vector<float> ir;
+
+    switch (space)
+    {
+        case metalHull:
+            ir.assign(static_cast<size_t>(0.9 * sampleRate), 0.0f);
+            addHullModes(ir, sampleRate, random);
+            addDiffuseTail(ir, sampleRate, random, 0.002, 0.35, 0.5, 0.6, 0.15f);
+            break;
+
+        case cockpit:
+            ir.assign(static_cast<size_t>(0.3 * sampleRate), 0.0f);
+            addEarlyReflections(ir, sampleRate, random, 12, 0.0015, 0.018, 0.22);
+            addDiffuseTail(ir, sampleRate, random, 0.003, 0.22, 0.9, 0.3, 0.35f);
+            break;
+
+        case hangar:
+            ir.assign(static_cast<size_t>(maxLengthSeconds * sampleRate), 0.0f);
+            addEarlyReflections(ir, sampleRate, random, 8, 0.025, 0.12, 1.3);
+            addDiffuseTail(ir, sampleRate, random, 0.04, 1.3, 0.6, 0.9, 0.5f);
+            break;
+
+        default:
+            break;
+    }
+
+    normaliseEnergy(ir);
+    return ir;
+}
@@ -0,0 +1,67 @@
+// Source/AudioEngine/ImpulseResponseLibrary.h
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "../Source/AudioEngine/PartitionedConvolver.h" // For ConvolutionKernel
+#include <array>
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+/*
+    Convolution kernels for the resonant spaces of the mecha: metal hull,
+    cockpit and hangar.
+
+    The impulse responses are synthesised procedurally (deterministic seeds)
+    and partitioned into FFT kernels on a background thread whenever the sample
+    rate changes. Each kernel is published through an atomic pointer once it is
+    complete; until then getKernel() returns nullptr and the convolver stays
+    bypassed. One library is shared by all engine slots.
+
+    The kernels only depend on the sample rate, so every library in the
+    process shares one read-only set per rate. The first library to ask for
+    a rate starts its build; the others pick up the same kernels, so a host
+    running hundreds of instances builds and caches them once. A set is freed
+    with the last library that uses it.
+
+    Kernels are only released in prepare() and the destructor, which hosts
+    never call while audio is being processed.
+*/
+class ImpulseResponseLibrary
+{
+public:
+    // Matches the choices of the convolutionSpace parameter
+    enum Space
+    {
+        off = 0,
+        metalHull,
+        cockpit,
+        hangar,
+        numSpaces
+    };
+
+    static constexpr double maxLengthSeconds = 1.5;
+
+    ImpulseResponseLibrary();
+    ~ImpulseResponseLibrary();
+
+    /** @brief Starts building the kernels for 'sampleRate' unless they exist already. */
+    void prepare(double sampleRate);
+
+    /** @brief Audio thread: the kernel for a space, or nullptr while it is being built (or for 'off'). */
+    const ConvolutionKernel* getKernel(int space) const noexcept;
+
+    /** @brief Longest impulse response at 'sampleRate', for sizing convolvers. */
+    static int getMaxLengthInSamples(double sampleRate) noexcept;
+
+private:
+    class KernelSet;
+
+    static std::shared_ptr<KernelSet> getSharedKernelSet(double sampleRate);
+    static std::vector<float> createImpulseResponse(int space, double sampleRate);
+
+    double preparedSampleRate = 0.0;
+    std::shared_ptr<KernelSet> kernelSet; // Replaced in prepare() only
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImpulseResponseLibrary)
+};
@@ -0,0 +1,226 @@
+// Source/AudioEngine/LookaheadLimiter.cpp
+#include "../Source/AudioEngine/LookaheadLimiter.h"
+#include <cmath>
+
+void LookaheadLimiter::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+    numChannels = static_cast<int>(spec.numChannels);
+    maxBlockSize = juce::jmax(1, static_cast<int>(spec.maximumBlockSize));
+    lookaheadSamples = juce::jmax(1, juce::roundToInt(lookaheadSeconds * sampleRate));
+
+    // A peak found at detector time k lies between samples k - detectorDelay and the one after it.
+    // The moving average reaches a drop lookaheadSamples - 1 samples after it was held.
+    latencySamples = lookaheadSamples - 1 + detectorDelay;
+
+    // Interpolator: Blackman-windowed sinc, cut off at the input Nyquist frequency. The centre
+    // tap lands on an input sample, so phase 0 is that sample itself (input n - detectorDelay)
+    // and phase p sits p / oversampling of a sample after it.
+    constexpr int prototypeLength = oversampling * tapsPerPhase + 1;
+    constexpr int centre = prototypeLength / 2;
+    std::array<double, prototypeLength> prototype{};
+    for (int i = 0; i < prototypeLength; ++i)
+    {
+        const double t = static_cast<double>(i - centre) / oversampling;
+        const double phase = juce::MathConstants<double>::twoPi * i / (prototypeLength - 1);
+        const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        const double sinc = i == centre ? 1.0 : std::sin(juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+        prototype[static_cast<size_t>(i)] = sinc * window;
+    }
+
+    // Phase p, tap j (input n - j) is prototype[p + oversampling * j]; each phase passes DC at unity
+    for (int p = 1; p < oversampling; ++p)
+    {
+        double sum = 0.0;
+        for (int j = 0; j < tapsPerPhase; ++j)
+            sum += prototype[static_cast<size_t>(p + oversampling * j)];
+
+        for (int j = 0; j < tapsPerPhase; ++j)
+            phaseCoefficients[static_cast<size_t>(p - 1)][static_cast<size_t>(tapsPerPhase - 1 - j)]
+                = static_cast<float>(prototype[static_cast<size_t>(p + oversampling * j)] / sum);
+    }
+
+    history.assign(static_cast<size_t>(numChannels), std::vector<float>(2 * tapsPerPhase, 0.0f));
+
+    // The window holds at most lookahead + 1 entries, plus one while a new one is pushed
+    const int windowSize = juce::nextPowerOfTwo(lookaheadSamples + 2);
+    windowSamples.assign(static_cast<size_t>(windowSize), 0);
+    windowGains.assign(static_cast<size_t>(windowSize), 1.0f);
+    windowMask = windowSize - 1;
+
+    averageRing.assign(static_cast<size_t>(lookaheadSamples), 1.0f);
+
+    const int delaySize = juce::nextPowerOfTwo(latencySamples + maxBlockSize);
+    delayLines.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(delaySize), 0.0f));
+    delayMask = delaySize - 1;
+
+    peaks.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+    gains.assign(static_cast<size_t>(maxBlockSize), 1.0f);
+
+    reset();
+}
+
+void LookaheadLimiter::reset() noexcept
+{
+    for (auto& channelHistory : history)
+        std::fill(channelHistory.begin(), channelHistory.end(), 0.0f);
+    historyPosition = 0;
+
+    windowFront = 0;
+    windowCount = 0;
+    sampleCounter = 0;
+
+    envelope = 1.0f;
+    std::fill(averageRing.begin(), averageRing.end(), 1.0f);
+    averagePosition = 0;
+    averageSum = static_cast<double>(averageRing.size());
+
+    for (auto& line : delayLines)
+        std::fill(line.begin(), line.end(), 0.0f);
+    delayWritePosition = 0;
+
+    currentGain.store(1.0f, std::memory_order_relaxed);
+}
+
+void LookaheadLimiter::setParameters(const LimiterParams& params) noexcept
+{
+    enabled = params.enabled;
+    ceiling = juce::Decibels::decibelsToGain(params.ceilingDb);
+    releaseCoefficient = 1.0f - static_cast<float>(std::exp(-1.0 / (juce::jmax(0.001f, params.releaseSeconds) * sampleRate)));
+}
+
+template <typename SampleType>
+void LookaheadLimiter::process(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    if (numSamples == 0 || delayLines.empty())
+        return;
+
+    int length = 0;
+    for (int start = 0; start < numSamples; start += length)
+    {
+        length = juce::jmin(maxBlockSize, numSamples - start);
+        const auto chunk = block.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(length));
+
+        detectPeaks(chunk, length);
+        computeGains(length);
+        applyGains(chunk, length);
+    }
+
+    currentGain.store(gains[static_cast<size_t>(length - 1)], std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+void LookaheadLimiter::detectPeaks(const juce::dsp::AudioBlock<SampleType>& block, int numSamples) noexcept
+{
+    std::fill(peaks.begin(), peaks.begin() + numSamples, 0.0f);
+
+    const int channels = juce::jmin(numChannels, static_cast<int>(block.getNumChannels()));
+    int position = historyPosition;
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        const auto* input = block.getChannelPointer(static_cast<size_t>(channel));
+        auto* channelHistory = history[static_cast<size_t>(channel)].data();
+        position = historyPosition;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto sample = static_cast<float>(input[i]);
+            channelHistory[position] = sample;
+            channelHistory[position + tapsPerPhase] = sample;
+            position = position + 1 == tapsPerPhase ? 0 : position + 1;
+
+            // Skipped while disabled; the history stays current for when it is enabled
+            if (!enabled)
+                continue;
+
+            // Oldest to newest input, in the order of the coefficients
+            const float* taps = channelHistory + position;
+            float peak = std::abs(taps[tapsPerPhase - 1 - detectorDelay]);
+
+            for (const auto& coefficients : phaseCoefficients)
+            {
+                float sum = 0.0f;
+                for (int k = 0; k < tapsPerPhase; ++k)
+                    sum += coefficients[static_cast<size_t>(k)] * taps[k];
+                peak = juce::jmax(peak, std::abs(sum));
+            }
+
+            peaks[static_cast<size_t>(i)] = juce::jmax(peaks[static_cast<size_t>(i)], peak);
+        }
+    }
+
+    historyPosition = position;
+}
+
+void LookaheadLimiter::computeGains(int numSamples) noexcept
+{
+    const juce::int64 windowLength = lookaheadSamples + 1;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float peak = peaks[static_cast<size_t>(i)];
+        const float required = peak > ceiling ? ceiling / peak : 1.0f;
+
+        // Monotonic deque: drop every newer entry that needs at least as much gain,
+        // so the front is always the minimum of the window
+        while (windowCount > 0 && windowGains[static_cast<size_t>((windowFront + windowCount - 1) & windowMask)] >= required)
+            --windowCount;
+
+        const auto back = static_cast<size_t>((windowFront + windowCount) & windowMask);
+        windowSamples[back] = sampleCounter;
+        windowGains[back] = required;
+        ++windowCount;
+
+        if (windowSamples[static_cast<size_t>(windowFront)] <= sampleCounter - windowLength)
+        {
+            windowFront = (windowFront + 1) & windowMask;
+            --windowCount;
+        }
+
+        const float held = windowGains[static_cast<size_t>(windowFront)];
+        ++sampleCounter;
+
+        // Instant attack (the average below shapes it), exponential release
+        envelope = held < envelope ? held : envelope + releaseCoefficient * (held - envelope);
+
+        averageSum += envelope - averageRing[static_cast<size_t>(averagePosition)];
+        averageRing[static_cast<size_t>(averagePosition)] = envelope;
+        if (++averagePosition == lookaheadSamples)
+        {
+            // Resum once per lap so rounding in the running sum cannot build up
+            averagePosition = 0;
+            averageSum = 0.0;
+            for (const float value : averageRing)
+                averageSum += value;
+        }
+
+        gains[static_cast<size_t>(i)] = static_cast<float>(averageSum / lookaheadSamples);
+    }
+}
+
+template <typename SampleType>
+void LookaheadLimiter::applyGains(const juce::dsp::AudioBlock<SampleType>& block, int numSamples) noexcept
+{
+    const int channels = juce::jmin(numChannels, static_cast<int>(block.getNumChannels()));
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        auto* samples = block.getChannelPointer(static_cast<size_t>(channel));
+        auto* line = delayLines[static_cast<size_t>(channel)].data();
+
+        // The whole chunk goes in first: with short latencies the reads reach into it
+        for (int i = 0; i < numSamples; ++i)
+            line[(delayWritePosition + i) & delayMask] = static_cast<float>(samples[i]);
+
+        const int readPosition = delayWritePosition - latencySamples;
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<SampleType>(line[(readPosition + i) & delayMask] * gains[static_cast<size_t>(i)]);
+    }
+
+    delayWritePosition = (delayWritePosition + numSamples) & delayMask;
+}
+
+template void LookaheadLimiter::process<float>(const juce::dsp::AudioBlock<float>&) noexcept;
+template void LookaheadLimiter::process<double>(const juce::dsp::AudioBlock<double>&) noexcept;
@@ -0,0 +1,107 @@
+// Source/AudioEngine/LookaheadLimiter.h
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "../Parameters/Parameters.h" // For LimiterParams
+
+//==============================================================================
+/*
+    Lookahead true-peak limiter for the master output.
+
+    Each block goes through three passes:
+
+    1. Detection. Every channel is interpolated 4x with a polyphase FIR (three
+       12-tap phases between each pair of samples, as in ITU-R BS.1770) to
+       estimate the peaks between samples. The peak of each sample, linked
+       across channels, sets the gain it needs to stay at the ceiling.
+    2. Gain. The smallest required gain over the last lookahead + 1 samples is
+       held. This is an O(1) sliding-window minimum on a monotonic deque. The
+       held gain drops at once and recovers with the release time. A moving
+       average over the lookahead turns each drop into a ramp that ends on the
+       peak. The average is a running sum, also O(1).
+    3. Output. The audio is delayed to meet its gain, so the ceiling holds
+       without clipping.
+
+    The delay is reported as latency whether or not the limiter is enabled.
+    While disabled, the gain eases back to unity and detection is skipped, so
+    switching it on or off neither clicks nor shifts the timing.
+*/
+class LookaheadLimiter
+{
+public:
+    static constexpr double lookaheadSeconds = 0.002;
+    static constexpr int oversampling = 4;
+    static constexpr int tapsPerPhase = 12;
+    static constexpr int detectorDelay = tapsPerPhase / 2; // Samples between an input and the interpolated peaks around it
+
+    LookaheadLimiter() = default;
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset() noexcept;
+
+    /** @brief Samples between input and output, fixed from prepare() on. */
+    int getLatencySamples() const noexcept { return latencySamples; }
+
+    /** @brief Audio thread: ceiling and release for the next block. */
+    void setParameters(const LimiterParams& params) noexcept;
+
+    /** @brief Limits 'block' in place. Any block length is accepted. */
+    template <typename SampleType>
+    void process(const juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+    /** @brief Gain applied to the last sample of the latest block, for metering. */
+    float getCurrentGain() const noexcept { return currentGain.load(std::memory_order_relaxed); }
+
+private:
+    template <typename SampleType>
+    void detectPeaks(const juce::dsp::AudioBlock<SampleType>& block, int numSamples) noexcept;
+    void computeGains(int numSamples) noexcept;
+    template <typename SampleType>
+    void applyGains(const juce::dsp::AudioBlock<SampleType>& block, int numSamples) noexcept;
+
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+    int maxBlockSize = 0;
+    int lookaheadSamples = 1;
+    int latencySamples = 0;
+
+    bool enabled = false;
+    float ceiling = 1.0f;
+    float releaseCoefficient = 1.0f;
+
+    // Polyphase interpolator: coefficients of the phases between samples, newest tap last;
+    // a doubled history per channel so every dot product reads contiguous samples
+    std::array<std::array<float, tapsPerPhase>, oversampling - 1> phaseCoefficients{};
+    std::vector<std::vector<float>> history;
+    int historyPosition = 0;
+
+    // Sliding-window minimum of the required gain, as a ring of (sample, gain)
+    std::vector<juce::int64> windowSamples;
+    std::vector<float> windowGains;
+    int windowMask = 0;
+    int windowFront = 0;
+    int windowCount = 0;
+    juce::int64 sampleCounter = 0;
+
+    // Release envelope and moving average
+    float envelope = 1.0f;
+    std::vector<float> averageRing;
+    int averagePosition = 0;
+    double averageSum = 0.0;
+
+    // Audio delay, a power of two per channel
+    std::vector<std::vector<float>> delayLines;
+    int delayMask = 0;
+    int delayWritePosition = 0;
+
+    // One block: linked peaks, then gains
+    std::vector<float> peaks;
+    std::vector<float> gains;
+
+    std::atomic<float> currentGain{ 1.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LookaheadLimiter)
+};
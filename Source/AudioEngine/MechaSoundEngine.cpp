@@ -1,114 +1,864 @@
 // Source/AudioEngine/MechaSoundEngine.cpp
 #include "../Source/AudioEngine/MechaSoundEngine.h"
 #include "../Source/AudioEngine/ServoEngine.h" // Include concrete engine implementations
+#include "../Source/AudioEngine/ServoBankEngine.h"
+#include "../Source/AudioEngine/GranularEngine.h"
+#include "../Source/AudioEngine/SamplePlaybackEngine.h"
 #include "../Source/AudioEngine/PowerCoreEngine.h"
+#include "../Source/Diagnostics/SpectrumAnalyser.h"
+#include <juce_audio_formats/juce_audio_formats.h> // For reading grain sources
 #include <juce_core/juce_core.h> // For juce::jmap
+#include <type_traits>
+
+namespace
+{
+    // Engine 'slot' of 'numSlots' fanned out around the azimuth, first slot leftmost
+    void positionSpatializer(EngineSpatializer& spatializer, const SpatialParams& spatial, size_t slot, size_t numSlots) noexcept
+    {
+        const float offset = numSlots > 1 ? 2.0f * static_cast<float>(slot) / static_cast<float>(numSlots - 1) - 1.0f : 0.0f;
+        spatializer.setPosition(spatial.azimuth + offset * spatial.spread * MechaSoundEngine::spatialSpreadDegrees,
+                                spatial.distance, spatial.doppler);
+    }
+
+    // destination += source * gain, with the gain ramping linearly over 'length' samples
+    // from 'position' on: up from 0 to 1 for a fade-in, down from 1 to 0 otherwise
+    template <typename SampleType>
+    void addWithLinearFade(const juce::dsp::AudioBlock<SampleType>& destination, const juce::dsp::AudioBlock<SampleType>& source,
+                           int position, int length, bool fadeIn) noexcept
+    {
+        const size_t numChannels = juce::jmin(destination.getNumChannels(), source.getNumChannels());
+        const size_t numSamples = juce::jmin(destination.getNumSamples(), source.getNumSamples());
+        const auto fadeLength = static_cast<SampleType>(length);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* output = destination.getChannelPointer(channel);
+            const auto* input = source.getChannelPointer(channel);
+
+            for (size_t sample = 0; sample < numSamples; ++sample)
+            {
+                const auto rise = juce::jmin(SampleType(1), static_cast<SampleType>(position + static_cast<int>(sample) + 1) / fadeLength);
+                output[sample] += input[sample] * (fadeIn ? rise : SampleType(1) - rise);
+            }
+        }
+    }
+}
 
 MechaSoundEngine::MechaSoundEngine()
 {
-    // Create and add sound engines
-    // In Batch 1, only ServoEngine is added. Future engines will be added here.
-    soundEngines.push_back(std::make_unique<ServoEngine>());
-    soundEngines.push_back(std::make_unique<PowerCoreEngine>());
-    // For example, later:
-    // soundEngines.push_back(std::make_unique<PowerCoreEngine>());
-    // soundEngines.push_back(std::make_unique<ThrusterEngine>());
+    // Default layout; more engines can be inserted at runtime
+    editEngines.push_back(createEntry(EngineType::servo));
+    editEngines.push_back(createEntry(EngineType::powerCore));
+    editEngines.push_back(createEntry(EngineType::granular));
+    editEngines.push_back(createEntry(EngineType::samplePlayback));
+    activeEngines = new EngineList(editEngines);
 }
 
 MechaSoundEngine::~MechaSoundEngine()
 {
-    // unique_ptr will handle cleanup
+    delete pendingEngines.exchange(nullptr);
+    delete outgoingEngines;
+    delete activeEngines;
+    releaseRetiredEngines();
+}
+
+//==============================================================================
+juce::String MechaSoundEngine::getEngineTypeName(EngineType type)
+{
+    switch (type)
+    {
+        case EngineType::servo:     return "Servo";
+        case EngineType::powerCore: return "Power Core";
+        case EngineType::servoBank: return "Servo Bank";
+        case EngineType::granular:  return "Granular";
+        case EngineType::samplePlayback: return "Foley";
+        default:                    return {};
+    }
+}
+
+bool MechaSoundEngine::getEngineTypeFromName(const juce::String& name, EngineType& type)
+{
+    for (const auto candidate : { EngineType::servo, EngineType::powerCore, EngineType::servoBank, EngineType::granular,
+                                  EngineType::samplePlayback })
+    {
+        if (getEngineTypeName(candidate) == name)
+        {
+            type = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+MechaSoundEngine::EngineEntry MechaSoundEngine::createEntry(EngineType type) const
+{
+    EngineEntry entry{ type, createEngine(type), std::make_shared<EngineSpatializer>(), std::make_shared<EngineUpsampler>() };
+    if (entry.engine == nullptr)
+        return entry;
+
+    // Ready to run before the audio thread can see it
+    if (enginesPrepared)
+        prepareEntry(entry);
+    entry.engine->reset();
+    return entry;
+}
+
+void MechaSoundEngine::prepareEntry(EngineEntry& entry) const
+{
+    // An engine that declares a bandwidth is prepared at the reduced rate its upsampler picks
+    const int factor = EngineUpsampler::chooseFactor(engineSpec.sampleRate, entry.engine->getBandwidth());
+    entry.upsampler->prepare(engineSpec, factor);
+    entry.engine->prepare(entry.upsampler->getEngineSpec());
+    entry.spatializer->prepare(getSpatializerSpec());
+}
+
+juce::dsp::ProcessSpec MechaSoundEngine::getSpatializerSpec() const noexcept
+{
+    // Spatialised engines render mono; the spatializer makes the stereo image
+    auto spec = engineSpec;
+    spec.numChannels = 1;
+    return spec;
+}
+
+std::shared_ptr<SoundEngineBase> MechaSoundEngine::createEngine(EngineType type) const
+{
+    std::shared_ptr<SoundEngineBase> engine;
+
+    switch (type)
+    {
+        case EngineType::servo:     engine = std::make_shared<ServoEngine>(); break;
+        case EngineType::powerCore: engine = std::make_shared<PowerCoreEngine>(); break;
+        case EngineType::servoBank:
+        {
+            auto bank = std::make_shared<ServoBankEngine>();
+            bank->setBankSettings(servoBankSettings);
+            engine = bank;
+            break;
+        }
+        case EngineType::granular:
+        {
+            auto granular = std::make_shared<GranularEngine>();
+            if (grainSourceRate > 0.0)
+                granular->setSource(grainSource, grainSourceRate);
+            engine = granular;
+            break;
+        }
+        case EngineType::samplePlayback:
+        {
+            auto player = std::make_shared<SamplePlaybackEngine>();
+            player->setPrefetchThread(samplePrefetchThread);
+            if (sampleSource != nullptr)
+                player->setSource(sampleSource, sampleFile);
+            player->setNonRealtime(nonRealtime.load(std::memory_order_relaxed));
+            engine = player;
+            break;
+        }
+        default:                    return nullptr;
+    }
+
+    return engine;
+}
+
+bool MechaSoundEngine::addEngine(EngineType type)
+{
+    if (static_cast<int>(editEngines.size()) >= maxEngines)
+        return false;
+
+    auto entries = editEngines;
+    entries.push_back(createEntry(type));
+    publishEngines(std::move(entries));
+    return true;
+}
+
+bool MechaSoundEngine::removeEngine(int index)
+{
+    if (index < 0 || index >= static_cast<int>(editEngines.size()))
+        return false;
+
+    auto entries = editEngines;
+    entries.erase(entries.begin() + index);
+    publishEngines(std::move(entries));
+    return true;
+}
+
+void MechaSoundEngine::setEngineLayout(const std::vector<EngineType>& layout)
+{
+    // Reuse running engines in order, type by type, so unchanged ones keep sounding
+    std::vector<bool> used(editEngines.size(), false);
+    EngineList entries;
+
+    for (const auto type : layout)
+    {
+        if (static_cast<int>(entries.size()) >= maxEngines)
+            break;
+
+        const EngineEntry* reused = nullptr;
+        for (size_t i = 0; i < editEngines.size() && reused == nullptr; ++i)
+        {
+            if (!used[i] && editEngines[i].type == type)
+            {
+                used[i] = true;
+                reused = &editEngines[i];
+            }
+        }
+
+        entries.push_back(reused != nullptr ? *reused : createEntry(type));
+    }
+
+    publishEngines(std::move(entries));
+}
+
+void MechaSoundEngine::setSamplePrefetchThread(SamplePrefetchThread* thread)
+{
+    samplePrefetchThread = thread;
+
+    for (const auto& entry : editEngines)
+        if (entry.type == EngineType::samplePlayback)
+            static_cast<SamplePlaybackEngine&>(*entry.engine).setPrefetchThread(thread);
+}
+
+bool MechaSoundEngine::setSampleFile(const juce::File& file)
+{
+    auto source = SamplePlaybackEngine::openFile(file);
+    if (source == nullptr)
+        return false;
+
+    setSampleSource(std::move(source), file);
+    return true;
+}
+
+void MechaSoundEngine::setSampleSource(std::shared_ptr<SamplePlaybackEngine::FrameSource> source, const juce::File& file)
+{
+    // The file is mapped once and every engine streams the same mapping
+    for (const auto& entry : editEngines)
+        if (entry.type == EngineType::samplePlayback)
+            static_cast<SamplePlaybackEngine&>(*entry.engine).setSource(source, file);
+
+    sampleSource = std::move(source);
+    sampleFile = file;
+}
+
+bool MechaSoundEngine::setGrainSourceFile(const juce::File& file)
+{
+    juce::AudioBuffer<float> buffer;
+    double sampleRate = 0.0;
+    if (!readGrainSourceFile(file, buffer, sampleRate))
+        return false;
+
+    setGrainSource(buffer, sampleRate, file);
+    return true;
+}
+
+bool MechaSoundEngine::readGrainSourceFile(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+    if (reader == nullptr || reader->numChannels == 0 || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+        return false;
+
+    const auto length = static_cast<int>(juce::jmin(reader->lengthInSamples,
+                                                    static_cast<juce::int64>(maxGrainSourceSeconds * reader->sampleRate)));
+    juce::AudioBuffer<float> decoded(static_cast<int>(reader->numChannels), length);
+    if (!reader->read(&decoded, 0, length, 0, true, true))
+        return false;
+
+    buffer = std::move(decoded);
+    sampleRate = reader->sampleRate;
+    return true;
+}
+
+void MechaSoundEngine::setGrainSource(const juce::AudioBuffer<float>& buffer, double sampleRate, const juce::File& file)
+{
+    jassert(sampleRate > 0.0);
+
+    grainSource = buffer;
+    grainSourceRate = sampleRate;
+    grainSourceFile = file;
+
+    // Each engine keeps its own mono copy and swaps it in at the start of a block
+    for (const auto& entry : editEngines)
+        if (entry.type == EngineType::granular)
+            static_cast<GranularEngine&>(*entry.engine).setSource(grainSource, grainSourceRate);
+}
+
+void MechaSoundEngine::setServoBankSettings(const ServoBankEngine::BankSettings& settings)
+{
+    servoBankSettings = settings;
+
+    // Stored atomically per servo; the banks pick them up at their next parameter update
+    for (const auto& entry : editEngines)
+        if (entry.type == EngineType::servoBank)
+            static_cast<ServoBankEngine&>(*entry.engine).setBankSettings(settings);
+}
+
+std::vector<MechaSoundEngine::EngineType> MechaSoundEngine::getEngineLayout() const
+{
+    std::vector<EngineType> layout;
+    for (const auto& entry : editEngines)
+        layout.push_back(entry.type);
+    return layout;
+}
+
+void MechaSoundEngine::publishEngines(EngineList entries)
+{
+    releaseRetiredEngines();
+    editEngines = entries;
+
+    // A list replaced before the audio thread picked it up was never seen there
+    delete pendingEngines.exchange(new EngineList(std::move(entries)));
+}
+
+void MechaSoundEngine::releaseRetiredEngines()
+{
+    const auto scope = retiredFifo.read(retiredFifo.getNumReady());
+
+    for (int i = 0; i < scope.blockSize1; ++i)
+        delete retiredEngines[static_cast<size_t>(scope.startIndex1 + i)];
+    for (int i = 0; i < scope.blockSize2; ++i)
+        delete retiredEngines[static_cast<size_t>(scope.startIndex2 + i)];
+}
+
+void MechaSoundEngine::beginEngineTransition() noexcept
+{
+    // One transition at a time, and only when the old list can be handed back
+    if (outgoingEngines != nullptr || retiredFifo.getFreeSpace() == 0)
+        return;
+
+    auto* next = pendingEngines.exchange(nullptr);
+    if (next == nullptr)
+        return;
+
+    auto contains = [](const EngineList& list, const SoundEngineBase* engine)
+    {
+        for (const auto& entry : list)
+            if (entry.engine.get() == engine)
+                return true;
+        return false;
+    };
+
+    // Inserted engines fade in, removed ones fade out; the rest carry on untouched
+    bool anyFade = false;
+    for (size_t i = 0; i < next->size() && i < fadingIn.size(); ++i)
+    {
+        fadingIn[i] = !contains(*activeEngines, (*next)[i].engine.get());
+        anyFade = anyFade || fadingIn[i];
+    }
+    for (size_t i = 0; i < activeEngines->size() && i < fadingOut.size(); ++i)
+    {
+        fadingOut[i] = !contains(*next, (*activeEngines)[i].engine.get());
+        anyFade = anyFade || fadingOut[i];
+    }
+
+    outgoingEngines = activeEngines;
+    activeEngines = next;
+    transitionPosition = 0;
+
+    if (!anyFade)
+        finishEngineTransition();
+}
+
+void MechaSoundEngine::applyNonRealtime() noexcept
+{
+    // Only when the mode or the list changes; engines of a new list were created
+    // with the mode current at the time, which may since have changed
+    const bool isNonRealtime = nonRealtime.load(std::memory_order_relaxed);
+    if (isNonRealtime == appliedNonRealtime && activeEngines == appliedNonRealtimeTo)
+        return;
+
+    for (const auto& entry : *activeEngines)
+        if (entry.type == EngineType::samplePlayback)
+            static_cast<SamplePlaybackEngine&>(*entry.engine).setNonRealtime(isNonRealtime);
+
+    appliedNonRealtime = isNonRealtime;
+    appliedNonRealtimeTo = activeEngines;
+}
+
+void MechaSoundEngine::finishEngineTransition() noexcept
+{
+    if (outgoingEngines == nullptr)
+        return;
+
+    // Space was checked when the transition began
+    const auto scope = retiredFifo.write(1);
+    if (scope.blockSize1 > 0)
+        retiredEngines[static_cast<size_t>(scope.startIndex1)] = outgoingEngines;
+    else if (scope.blockSize2 > 0)
+        retiredEngines[static_cast<size_t>(scope.startIndex2)] = outgoingEngines;
+    else
+        jassertfalse;
+
+    outgoingEngines = nullptr;
+    fadingIn.fill(false);
+    fadingOut.fill(false);
 }
 
 void MechaSoundEngine::prepare(const juce::dsp::ProcessSpec& spec)
 {
+    // Everything below only ever sees sub-blocks, whatever block size the host announces
+    auto subBlockSpec = spec;
+    subBlockSpec.maximumBlockSize = static_cast<juce::uint32>(subBlockSize);
+
     // Prepare Hiss components
-    noiseGen.prepare(spec);
-    hissFilter.prepare(spec);
+    noiseGen.prepare(subBlockSpec);
+    hissFilter.prepare(subBlockSpec);
     hissFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass); // [cite: 18]
 
-    // Prepare all managed sound engines
-    for (auto& engine : soundEngines)
+    // Audio is stopped: settle any list change right away
+    releaseRetiredEngines();
+    if (auto* next = pendingEngines.exchange(nullptr))
     {
-        engine->prepare(spec);
+        delete outgoingEngines;
+        outgoingEngines = nullptr;
+        delete activeEngines;
+        activeEngines = next;
     }
+    else if (outgoingEngines != nullptr)
+    {
+        delete outgoingEngines;
+        outgoingEngines = nullptr;
+    }
+    fadingIn.fill(false);
+    fadingOut.fill(false);
+
+    // Prepare all managed sound engines
+    engineSpec = subBlockSpec;
+    enginesPrepared = true;
+    for (auto& entry : *activeEngines)
+        prepareEntry(entry);
+    transitionLength = juce::jmax(1, juce::roundToInt(spec.sampleRate * engineFadeSeconds));
+    engineScratch.setSize(static_cast<int>(spec.numChannels), static_cast<int>(subBlockSize));
+    engineScratchDouble.setSize(static_cast<int>(spec.numChannels), static_cast<int>(subBlockSize));
+    monoScratch.setSize(1, static_cast<int>(subBlockSize));
+    monoScratchDouble.setSize(1, static_cast<int>(subBlockSize));
+    motionScratch.setSize(static_cast<int>(spec.numChannels), static_cast<int>(subBlockSize));
+    motionScratchDouble.setSize(static_cast<int>(spec.numChannels), static_cast<int>(subBlockSize));
+
+    for (auto& convolver : convolvers)
+        convolver.prepare(subBlockSpec, ImpulseResponseLibrary::getMaxLengthInSamples(spec.sampleRate));
+    spaceFadeLength = juce::jmax(1, juce::roundToInt(spec.sampleRate * spaceFadeSeconds));
+    timeline.prepare(spec.sampleRate);
+    modulation.prepare(spec.sampleRate);
     reset();
 }
 
 void MechaSoundEngine::reset()
+{
+    resetState(nullptr);
+}
+
+void MechaSoundEngine::resetTo(const EngineParameterSet& params)
+{
+    resetState(&params);
+}
+
+void MechaSoundEngine::resetState(const EngineParameterSet* settleOn)
 {
     // Reset Hiss components
     noiseGen.reset();
     hissFilter.reset();
 
-    // Reset all managed sound engines
-    for (auto& engine : soundEngines)
+    // Reset all managed sound engines; a pending fade has nothing left to fade
+    finishEngineTransition();
+    for (auto& entry : *activeEngines)
     {
-        engine->reset();
+        if (settleOn != nullptr)
+            entry.engine->resetTo(*settleOn);
+        else
+            entry.engine->reset();
+        entry.spatializer->reset();
+        entry.upsampler->reset();
     }
+    for (auto& convolver : convolvers)
+        convolver.reset();
+    convolvers[static_cast<size_t>(1 - liveConvolver)].setKernel(nullptr);
+    spaceFadePosition = spaceFadeLength;
+
+    // A slot settled on a snapshot starts with its motion setting, not a crossfade into it
+    motionFadePosition = transitionLength;
+    if (settleOn != nullptr)
+        spatialWasEnabled = settleOn->spatial.enabled;
+    modulation.reset();
+
+    // Settled on a set, the first call starts from it instead of ramping
+    hasPreviousParams = settleOn != nullptr;
+    if (settleOn != nullptr)
+        previousParams = *settleOn;
+}
+
+template <typename SampleType>
+void MechaSoundEngine::process(juce::AudioBuffer<SampleType>& buffer, const EngineParameterSet& allParams)
+{
+    process(juce::dsp::AudioBlock<SampleType>(buffer), allParams);
 }
 
-void MechaSoundEngine::process(juce::AudioBuffer<float>& buffer, const EngineParameterSet& allParams)
+template <typename SampleType>
+void MechaSoundEngine::process(const juce::dsp::AudioBlock<SampleType>& block, const EngineParameterSet& allParams)
 {
-    // 1. Update parameters for all engines
-    for (auto& engine : soundEngines)
+    const size_t numSamples = block.getNumSamples();
+    if (numSamples == 0)
+        return;
+
+    if (!hasPreviousParams)
     {
-        engine->updateParameters(allParams);
-        // Optionally, you could setEnabled here based on global or specific APVTS params
-        // For example, if you add a global enable for each engine type in APVTS:
-        // if (engine_is_servo) engine->setEnabled(apvts_servo_global_enable_param_value);
+        previousParams = allParams;
+        hasPreviousParams = true;
     }
 
-    // 2. Process Hiss (directly in MechaSoundEngine for now)
-    // Buffer should be cleared by PluginProcessor before this call if this is the first processing stage.
-    // Or, MechaSoundEngine ensures it's cleared before hiss processing.
-    // Assuming PluginProcessor clears it.
+    timeline.beginBlock(static_cast<int>(numSamples));
+    modulation.beginBlock();
+    beginEngineTransition();
+    applyNonRealtime();
+
+    // Fixed-size sub-blocks keep the engines' working set hot in L1 and make
+    // the control rate independent of the host buffer size. A timeline event
+    // ends the current sub-block early so the next one starts on its sample.
+    size_t start = 0;
+
+    while (start < numSamples)
+    {
+        timeline.dispatchEventsUpTo(static_cast<int>(start));
+
+        size_t end = juce::jmin(start + subBlockSize, numSamples);
+        const int nextEvent = timeline.getNextEventOffset();
+        if (nextEvent > static_cast<int>(start) && static_cast<size_t>(nextEvent) < end)
+            end = static_cast<size_t>(nextEvent);
+
+        // Control-rate update: ramp from the previous set so the new values are reached at the end of this call
+        const float position = static_cast<float>(end) / static_cast<float>(numSamples);
+        interpolateParameterSet(previousParams, allParams, position, controlParams);
+        timeline.applyOverrides(controlParams, static_cast<int>(start));
+        modulation.process(controlParams, static_cast<int>(end - start));
+
+        auto subBlock = block.getSubBlock(start, end - start);
+        processSubBlock(subBlock, controlParams);
+
+        start = end;
+    }
+
+    timeline.endBlock();
+    previousParams = allParams;
+}
+
+int MechaSoundEngine::getNumActiveEngines() const noexcept
+{
+    int count = 0;
+    for (const auto& entry : *activeEngines)
+        if (entry.engine->getEnabled())
+            ++count;
+    return count;
+}
+
+void MechaSoundEngine::advanceTimeline(size_t numSamples)
+{
+    if (numSamples == 0)
+        return;
+
+    timeline.beginBlock(static_cast<int>(numSamples));
+    timeline.dispatchEventsUpTo(static_cast<int>(numSamples));
+    timeline.endBlock();
+}
 
-    juce::dsp::AudioBlock<float> tempProcessingBlock(buffer); // Create a block for processing
-    juce::dsp::ProcessContextReplacing<float> hissContext(tempProcessingBlock);
+template <typename SampleType>
+void MechaSoundEngine::processSubBlock(juce::dsp::AudioBlock<SampleType>& block, const EngineParameterSet& params)
+{
+    // 1. Update parameters for all engines, including any fading out
+    for (auto& entry : *activeEngines)
+    {
+        entry.engine->updateParameters(params);
+    }
+    if (outgoingEngines != nullptr)
+    {
+        for (size_t i = 0; i < outgoingEngines->size() && i < fadingOut.size(); ++i)
+            if (fadingOut[i])
+                (*outgoingEngines)[i].engine->updateParameters(params);
+    }
 
-    if (allParams.hiss.level > 0.001f)
+    // 2. Process Hiss (directly in MechaSoundEngine for now)
+    // The block is expected to be cleared by the caller; hiss writes the base layer
+    // and leaves the block untouched (silent) when its level is negligible.
+    if (params.hiss.level > 0.001f)
     {
-        hissFilter.setCutoffFrequency(allParams.hiss.cutoff);
+        juce::dsp::ProcessContextReplacing<SampleType> hissContext(block);
+
+        hissFilter.setCutoffFrequency(params.hiss.cutoff);
         // Map resonance: Q range 0.1-18.0 to filter resonance 0.1-0.95 [cite: 1] (MechaSoundEngine.cpp)
-        hissFilter.setResonance(juce::jmap(allParams.hiss.resonanceQ, 0.1f, 18.0f, 0.1f, 0.95f));
+        hissFilter.setResonance(juce::jmap(params.hiss.resonanceQ, 0.1f, 18.0f, 0.1f, 0.95f));
+
+        noiseGen.setColour(static_cast<NoiseColour>(juce::jlimit(0, 3, params.hiss.colour)));
+        noiseGen.process(hissContext); // block now contains noise
+        processHissFilter(block); // block now contains filtered noise
+        block.multiplyBy(static_cast<SampleType>(params.hiss.level)); // Apply hiss level
+    }
+
+    // 3. Process all managed sound engines
+    // Each engine's processAddingTo will add its sound to the block on top of the hiss.
+    processEngines(block, params.spatial);
+
+    // 4. Resonant space on the sum. 'Off' (or a kernel still being built) bypasses it.
+    processSpace(block, params.convolution);
+}
+
+template <typename SampleType>
+void MechaSoundEngine::processSpace(juce::dsp::AudioBlock<SampleType>& block, const ConvolutionParams& params)
+{
+    const auto* kernel = impulseResponses != nullptr ? impulseResponses->getKernel(params.space) : nullptr;
+
+    // A new kernel starts in the idle convolver; a change during a crossfade waits for it to end
+    if (kernel != convolvers[static_cast<size_t>(liveConvolver)].getKernel() && spaceFadePosition >= spaceFadeLength)
+    {
+        liveConvolver = 1 - liveConvolver;
+        auto& incoming = convolvers[static_cast<size_t>(liveConvolver)];
+        incoming.reset();
+        incoming.setKernel(kernel);
+        spaceFadePosition = 0;
+    }
 
-        noiseGen.process(hissContext); // tempProcessingBlock (buffer) now contains noise
-        hissFilter.process(hissContext); // tempProcessingBlock (buffer) now contains filtered noise
-        buffer.applyGain(allParams.hiss.level); // Apply hiss level to the main buffer
+    auto& live = convolvers[static_cast<size_t>(liveConvolver)];
+    if (spaceFadePosition >= spaceFadeLength)
+    {
+        live.process(block, params.mix);
+        return;
+    }
+
+    // The outgoing space renders a copy of the mix, the incoming one the block itself;
+    // either leaves its input dry while bypassed, so 'Off' fades like any other space
+    auto& outgoing = convolvers[static_cast<size_t>(1 - liveConvolver)];
+    const size_t numSamples = block.getNumSamples();
+    juce::dsp::AudioBlock<SampleType> scratchBlock(getEngineScratch<SampleType>());
+    const size_t numChannels = juce::jmin(block.getNumChannels(), scratchBlock.getNumChannels());
+    auto scratch = scratchBlock.getSubsetChannelBlock(0, numChannels).getSubBlock(0, numSamples);
+
+    scratch.copyFrom(block.getSubsetChannelBlock(0, numChannels));
+    outgoing.process(scratch, params.mix);
+    live.process(block, params.mix);
+
+    const auto length = static_cast<SampleType>(spaceFadeLength);
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        auto* output = block.getChannelPointer(channel);
+        const auto* faded = scratch.getChannelPointer(channel);
+
+        for (size_t sample = 0; sample < numSamples; ++sample)
+        {
+            const auto gain = juce::jmin(SampleType(1), static_cast<SampleType>(spaceFadePosition + static_cast<int>(sample) + 1) / length);
+            output[sample] = faded[sample] + (output[sample] - faded[sample]) * gain;
+        }
+    }
+
+    spaceFadePosition += static_cast<int>(numSamples);
+    if (spaceFadePosition >= spaceFadeLength)
+        outgoing.setKernel(nullptr);
+}
+
+template <typename SampleType>
+void MechaSoundEngine::processEngines(juce::dsp::AudioBlock<SampleType>& block, const SpatialParams& spatial)
+{
+    const bool inTransition = outgoingEngines != nullptr;
+
+    // Toggling motion crossfades between the stereo and the spatialised renders over
+    // engineFadeSeconds. A toggle during the crossfade turns it around where it is.
+    if (spatial.enabled != spatialWasEnabled)
+    {
+        // Delay lines hold stale audio from the last time motion was on, unless it is still fading out
+        if (spatial.enabled && motionFadePosition >= transitionLength)
+        {
+            for (auto& entry : *activeEngines)
+                entry.spatializer->reset();
+            if (inTransition)
+                for (auto& entry : *outgoingEngines)
+                    entry.spatializer->reset();
+        }
+
+        motionFadePosition = transitionLength - juce::jmin(motionFadePosition, transitionLength);
+    }
+    spatialWasEnabled = spatial.enabled;
+    const bool placed = spatial.enabled || motionFadePosition < transitionLength;
+
+    for (size_t i = 0; i < activeEngines->size(); ++i)
+    {
+        auto& entry = (*activeEngines)[i];
+        auto& engine = *entry.engine;
+        if (!engine.isSounding())
+            continue;
+
+        // Engines with an analyser tap render alone so their output can be captured
+        const int tap = 1 + static_cast<int>(i);
+        const bool tapped = spectrumAnalyser != nullptr && tap < SpectrumAnalyser::numTaps && spectrumAnalyser->isTapEnabled(tap);
+
+        EngineSpatializer* spatializer = nullptr;
+        if (placed)
+        {
+            spatializer = entry.spatializer.get();
+            positionSpatializer(*spatializer, spatial, i, activeEngines->size());
+        }
+
+        if (inTransition && i < fadingIn.size() && fadingIn[i])
+            processEngineIsolated(entry, block, Ramp::fadeIn, tapped ? tap : -1, spatializer);
+        else if (tapped || spatializer != nullptr)
+            processEngineIsolated(entry, block, Ramp::none, tapped ? tap : -1, spatializer);
+        else
+            renderEngine(entry, block);
+    }
+
+    if (inTransition)
+    {
+        for (size_t i = 0; i < outgoingEngines->size() && i < fadingOut.size(); ++i)
+        {
+            auto& entry = (*outgoingEngines)[i];
+            if (!fadingOut[i] || !entry.engine->isSounding())
+                continue;
+
+            // Removed engines fade out where they were
+            EngineSpatializer* spatializer = nullptr;
+            if (placed)
+            {
+                spatializer = entry.spatializer.get();
+                positionSpatializer(*spatializer, spatial, i, outgoingEngines->size());
+            }
+
+            processEngineIsolated(entry, block, Ramp::fadeOut, -1, spatializer);
+        }
+
+        transitionPosition += static_cast<int>(block.getNumSamples());
+        if (transitionPosition >= transitionLength)
+            finishEngineTransition();
+    }
+
+    motionFadePosition = juce::jmin(transitionLength, motionFadePosition + static_cast<int>(block.getNumSamples()));
+}
+
+template <typename SampleType>
+void MechaSoundEngine::renderEngine(const EngineEntry& entry, juce::dsp::AudioBlock<SampleType>& block)
+{
+    if (entry.upsampler->getFactor() > 1)
+    {
+        entry.upsampler->process(*entry.engine, block);
+        return;
+    }
+
+    juce::dsp::ProcessContextReplacing<SampleType> context(block);
+    entry.engine->processAddingTo(context);
+}
+
+template <typename SampleType>
+void MechaSoundEngine::processEngineIsolated(const EngineEntry& entry, juce::dsp::AudioBlock<SampleType>& block, Ramp ramp, int tap,
+                                             EngineSpatializer* spatializer)
+{
+    // Render alone into the scratch block, then add it, with a linear ramp while fading
+    const size_t numSamples = block.getNumSamples();
+    juce::dsp::AudioBlock<SampleType> scratchBlock(getEngineScratch<SampleType>());
+    const size_t numChannels = juce::jmin(block.getNumChannels(), scratchBlock.getNumChannels());
+    auto scratch = scratchBlock.getSubsetChannelBlock(0, numChannels).getSubBlock(0, numSamples);
+
+    scratch.clear();
+    if (spatializer != nullptr)
+    {
+        juce::dsp::AudioBlock<SampleType> monoBlock(getMonoScratch<SampleType>());
+        auto mono = monoBlock.getSubBlock(0, numSamples);
+        mono.clear();
+
+        if (motionFadePosition < transitionLength)
+        {
+            renderMotionCrossfade(entry, mono, scratch, *spatializer);
+        }
+        else
+        {
+            renderEngine(entry, mono);
+            spatializer->process(mono, scratch);
+        }
     }
     else
     {
-        // If hiss is not active, ensure the buffer portion intended for hiss is silent.
-        // If PluginProcessor cleared the buffer, this is fine.
-        // If Hiss was supposed to write to a *part* of the buffer and other engines to others,
-        // more complex buffer management is needed. Current assumption: Hiss is the base layer.
-        // If hiss processed first and then others add, and hiss is 0, the buffer remains clear for others.
-        // If hiss processing modifies the buffer that others will add to,
-        // and hiss level is 0, it should effectively result in a clear buffer (or an untouched buffer)
-        // before other engines process.
-        // The applyGain(0) would effectively clear it IF it was full of hiss.
-        // If noiseGen/hissFilter were skipped, buffer remains as it was (hopefully cleared by Processor).
-        // Let's ensure buffer is what other engines expect if hiss is off:
-        // If hiss was the *only* thing and is now off, buffer should be clear.
-        // If hiss is one of many, and it's off, its contribution is zero.
-        // The original code cleared the buffer (if hiss was off) *after* the hiss block.
-        // This seems fine: if hiss is off, buffer is clear after this stage from PluginProcessor's clear.
-        // If hiss is on but level is 0, applyGain(0) makes its part 0.
+        renderEngine(entry, scratch);
     }
 
+    if (tap >= 0)
+        spectrumAnalyser->push(tap, scratch);
 
-    // 3. Process all managed sound engines
-    // Each engine's processAddingTo will add its sound to the buffer.
-    // The buffer currently contains the (potentially silent) hiss sound.
-    for (auto& engine : soundEngines)
+    if (ramp == Ramp::none)
     {
-        if (engine->getEnabled())
+        block.getSubsetChannelBlock(0, numChannels).add(scratch);
+        return;
+    }
+
+    addWithLinearFade(block, scratch, transitionPosition, transitionLength, ramp == Ramp::fadeIn);
+}
+
+template <typename SampleType>
+void MechaSoundEngine::renderMotionCrossfade(const EngineEntry& entry, juce::dsp::AudioBlock<SampleType>& mono,
+                                             juce::dsp::AudioBlock<SampleType>& output, EngineSpatializer& spatializer)
+{
+    // The engine renders once, in stereo; the spatialiser places its mono downmix
+    renderEngine(entry, output);
+
+    const size_t numChannels = output.getNumChannels();
+    const size_t numSamples = output.getNumSamples();
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        mono.addProductOf(output.getSingleChannelBlock(channel), SampleType(1) / static_cast<SampleType>(numChannels));
+
+    juce::dsp::AudioBlock<SampleType> motionBlock(getMotionScratch<SampleType>());
+    auto spatialised = motionBlock.getSubsetChannelBlock(0, numChannels).getSubBlock(0, numSamples);
+    spatialised.clear();
+    spatializer.process(mono, spatialised);
+
+    // Linear crossfade towards the spatialised render while motion is on, away from it while off:
+    // stereo + gain * (spatialised - stereo)
+    spatialised.subtract(output);
+    addWithLinearFade(output, spatialised, motionFadePosition, transitionLength, spatialWasEnabled);
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType>& MechaSoundEngine::getEngineScratch() noexcept
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return engineScratchDouble;
+    else
+        return engineScratch;
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType>& MechaSoundEngine::getMonoScratch() noexcept
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return monoScratchDouble;
+    else
+        return monoScratch;
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType>& MechaSoundEngine::getMotionScratch() noexcept
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return motionScratchDouble;
+    else
+        return motionScratch;
+}
+
+template <typename SampleType>
+void MechaSoundEngine::processHissFilter(juce::dsp::AudioBlock<SampleType>& block)
+{
+    if constexpr (std::is_same_v<SampleType, float>)
+    {
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        hissFilter.process(context);
+    }
+    else
+    {
+        // The filter state stays in float; run it sample by sample on the double block.
+        for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
         {
-            // Create a new context for each engine to ensure they operate on the current state of the buffer
-            juce::dsp::AudioBlock<float> engineBlock(buffer);
-            juce::dsp::ProcessContextReplacing<float> engineContext(engineBlock);
-            engine->processAddingTo(engineContext);
+            auto* channelData = block.getChannelPointer(channel);
+            for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+                channelData[sample] = static_cast<SampleType>(
+                    hissFilter.processSample(static_cast<int>(channel), static_cast<float>(channelData[sample])));
         }
     }
-}
\ No newline at end of file
+}
+
+template void MechaSoundEngine::process<float>(juce::AudioBuffer<float>&, const EngineParameterSet&);
+template void MechaSoundEngine::process<double>(juce::AudioBuffer<double>&, const EngineParameterSet&);
+template void MechaSoundEngine::process<float>(const juce::dsp::AudioBlock<float>&, const EngineParameterSet&);
+template void MechaSoundEngine::process<double>(const juce::dsp::AudioBlock<double>&, const EngineParameterSet&);
@@ -4,13 +4,25 @@
 #include <juce_dsp/juce_dsp.h>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <array>
 #include "../Source/AudioEngine/NoiseGenerator.h"     // Uses SimpleNoiseGenerator
 #include "../Source/AudioEngine/SoundEngineBase.h"    // For SoundEngineBase interface
+#include "../Source/AudioEngine/EventTimeline.h"      // For scheduled mecha events
+#include "../Source/AudioEngine/PartitionedConvolver.h"   // For the resonant space
+#include "../Source/AudioEngine/ImpulseResponseLibrary.h" // For the space kernels
+#include "../Source/AudioEngine/ModulationMatrix.h"   // For shared modulation sources
+#include "../Source/AudioEngine/EngineSpatializer.h"  // For the motion stage
+#include "../Source/AudioEngine/EngineUpsampler.h"    // For engines run at a reduced rate
+#include "../Source/AudioEngine/ServoBankEngine.h"    // For the servo bank settings
+#include "../Source/AudioEngine/SamplePlaybackEngine.h" // For the shared sample source
 #include "../Parameters/Parameters.h" // For EngineParameterSet
 
 // Forward declare concrete engines that will be managed
 class ServoEngine;
+class GranularEngine;
 class PowerCoreEngine;
+class SpectrumAnalyser;
 
 
 // The MechaSound::ParameterValues struct previously here can be removed
@@ -19,20 +31,264 @@ class PowerCoreEngine;
 class MechaSoundEngine
 {
 public:
+    // Engine types that can be inserted at runtime
+    enum class EngineType
+    {
+        servo,
+        powerCore,
+        servoBank,
+        granular,
+        samplePlayback
+    };
+
+    static juce::String getEngineTypeName(EngineType type);
+    static bool getEngineTypeFromName(const juce::String& name, EngineType& type);
+
     MechaSoundEngine();
     ~MechaSoundEngine();
 
     void prepare(const juce::dsp::ProcessSpec& spec);
     void reset();
 
-    // Main processing method, now takes EngineParameterSet
-    void process(juce::AudioBuffer<float>& buffer, const EngineParameterSet& allParams);
+    // Resets into the steady state of 'params' rather than to silence: envelopes start
+    // at their targets and the first call does not ramp from older parameters. For a
+    // slot that is crossfaded in on a program change.
+    void resetTo(const EngineParameterSet& params);
+
+    // Fixed noise seed for reproducible renders (-1 for non-deterministic).
+    // Applied at the next prepare() or reset().
+    void setNoiseSeed(juce::int64 seed) noexcept { noiseGen.setSeed(seed); }
+
+    // Kernels for the convolution spaces; shared between engines, must outlive this one.
+    // Without a library the convolution stage is bypassed.
+    void setImpulseResponseLibrary(const ImpulseResponseLibrary* library) noexcept { impulseResponses = library; }
+
+    // Thread that prefetches for every sample playback engine, current and future, shared
+    // with other MechaSoundEngines; must outlive this one. Without one, each sample
+    // playback engine runs a private thread. Message thread.
+    void setSamplePrefetchThread(SamplePrefetchThread* thread);
+
+    // Recording streamed by every sample playback engine, current and future. Message thread.
+    // Returns false if the file cannot be mapped; the previous one keeps playing.
+    bool setSampleFile(const juce::File& file);
+    juce::File getSampleFile() const { return sampleFile; }
+
+    // As setSampleFile(), with 'source' already opened from 'file' by
+    // SamplePlaybackEngine::openFile(); it may be shared with other MechaSoundEngines.
+    void setSampleSource(std::shared_ptr<SamplePlaybackEngine::FrameSource> source, const juce::File& file);
+
+    // Recording every granular engine, current and future, takes its grains from instead
+    // of the procedural gear grind (any format JUCE reads; at most maxGrainSourceSeconds
+    // of it). Message thread. Returns false if the file cannot be read; the previous
+    // source keeps playing.
+    bool setGrainSourceFile(const juce::File& file);
+    juce::File getGrainSourceFile() const { return grainSourceFile; }
+
+    // Decodes 'file' as setGrainSourceFile() would, for setGrainSource(). Returns false if it
+    // cannot be read. Any thread.
+    static bool readGrainSourceFile(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate);
+
+    // As setGrainSourceFile(), with 'buffer' already decoded from 'file' by readGrainSourceFile().
+    void setGrainSource(const juce::AudioBuffer<float>& buffer, double sampleRate, const juce::File& file);
+
+    static constexpr double maxGrainSourceSeconds = 30.0;
+
+    // Offline rendering: streaming engines wait for their data instead of dropping it.
+    // Any thread; the audio thread passes it on to the running engines at the next process().
+    void setNonRealtime(bool isNonRealtime) noexcept { nonRealtime.store(isNonRealtime, std::memory_order_relaxed); }
+
+    // Per-servo settings of every servo bank engine, current and future. Message thread.
+    void setServoBankSettings(const ServoBankEngine::BankSettings& settings);
+    const ServoBankEngine::BankSettings& getServoBankSettings() const noexcept { return servoBankSettings; }
+
+    // Runtime engine list, edited on the message thread. Every edit builds and prepares
+    // a new immutable list off the audio thread and publishes it with an atomic swap.
+    // The audio thread fades inserted and removed engines over engineFadeSeconds, then
+    // hands the old list back through a FIFO; it never locks, allocates or frees.
+    bool addEngine(EngineType type);
+    bool removeEngine(int index);
+    void setEngineLayout(const std::vector<EngineType>& layout); // Keeps running engines of matching types
+    std::vector<EngineType> getEngineLayout() const;
+
+    // Frees the engine lists the audio thread has retired. Every edit does this first.
+    void releaseRetiredEngines();
+
+    static constexpr int maxEngines = 8;
+    static constexpr double engineFadeSeconds = 0.02;
+
+    // Convolution space changes, and kernels arriving from the library, crossfade
+    // between two convolvers over this time instead of switching the tail abruptly.
+    static constexpr double spaceFadeSeconds = 0.05;
+
+    // Motion: with the spatial parameters enabled every engine renders mono through its
+    // own EngineSpatializer. The engines fan out evenly around the azimuth, first one
+    // leftmost, up to this far from it at full spread. Switching motion on or off
+    // crossfades between the two renders over engineFadeSeconds.
+    static constexpr float spatialSpreadDegrees = 60.0f;
+
+    // Modulation routes applied at control rate on top of the parameters. The owner
+    // attaches it to the parameter ranges and publishes settings through it.
+    ModulationMatrix& getModulationMatrix() noexcept { return modulation; }
+
+    // Event timeline. Events are scheduled from one non-audio thread and dispatched
+    // on their exact sample; setTransport() is called by the audio thread once per
+    // host block, before process().
+    bool scheduleEvent(const TimelineEvent& event) { return timeline.schedule(event); }
+    void clearEvents() noexcept { timeline.clear(); }
+    void setTransport(const TransportState& transport) noexcept { timeline.setTransport(transport); }
+
+    // Audio thread: enabled engines in the current list, for telemetry.
+    int getNumActiveEngines() const noexcept;
+
+    // Audio thread: analyser fed with the output of each engine slot (tap 1 + slot),
+    // or nullptr. Set by the owner before every process() call, on the live engine only.
+    void setSpectrumAnalyser(SpectrumAnalyser* analyserToFeed) noexcept { spectrumAnalyser = analyserToFeed; }
+
+    // Audio thread: dispatches the events of numSamples without rendering, for an
+    // engine that is not being processed, so its timeline state stays current.
+    void advanceTimeline(size_t numSamples);
+
+    // Main processing method, now takes EngineParameterSet.
+    // Instantiated for float and double buffers.
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, const EngineParameterSet& allParams);
+
+    // Block variant. Any block length is accepted: it is always processed in
+    // fixed sub-blocks, so nothing depends on the host's announced block size.
+    template <typename SampleType>
+    void process(const juce::dsp::AudioBlock<SampleType>& block, const EngineParameterSet& allParams);
+
+    // Engines always run on sub-blocks of at most this many samples. Parameters are
+    // updated at every sub-block boundary (control rate); timeline events start
+    // extra boundaries at their own sample. An engine that declares a bandwidth
+    // renders the same sub-block at a reduced rate through its EngineUpsampler.
+    static constexpr size_t subBlockSize = 32;
 
 private:
+    void resetState(const EngineParameterSet* settleOn);
+
+    template <typename SampleType>
+    void processSubBlock(juce::dsp::AudioBlock<SampleType>& block, const EngineParameterSet& params);
+
+    template <typename SampleType>
+    void processHissFilter(juce::dsp::AudioBlock<SampleType>& block);
+
+    struct EngineEntry
+    {
+        EngineType type;
+        std::shared_ptr<SoundEngineBase> engine; // Shared by consecutive lists; released on the message thread only
+        std::shared_ptr<EngineSpatializer> spatializer; // Travels with its engine, so moving slots keeps the delay line
+        std::shared_ptr<EngineUpsampler> upsampler;     // Factor 1 (unused) unless the engine declares a bandwidth
+    };
+    using EngineList = std::vector<EngineEntry>;
+
+    // Message thread
+    EngineEntry createEntry(EngineType type) const;
+    std::shared_ptr<SoundEngineBase> createEngine(EngineType type) const;
+    void prepareEntry(EngineEntry& entry) const;
+    juce::dsp::ProcessSpec getSpatializerSpec() const noexcept;
+    void publishEngines(EngineList entries);
+
+    // Audio thread
+    void beginEngineTransition() noexcept;
+    void finishEngineTransition() noexcept;
+    void applyNonRealtime() noexcept;
+
+    template <typename SampleType>
+    void processEngines(juce::dsp::AudioBlock<SampleType>& block, const SpatialParams& spatial);
+
+    enum class Ramp
+    {
+        none,
+        fadeIn,
+        fadeOut
+    };
+
+    // Adds the engine's output to 'block', through its upsampler if it runs at a reduced rate.
+    template <typename SampleType>
+    void renderEngine(const EngineEntry& entry, juce::dsp::AudioBlock<SampleType>& block);
+
+    // Renders one engine alone, adds it to 'block' with 'ramp' and feeds 'tap' (-1 for none).
+    // With a spatializer the engine renders mono and is placed by it.
+    template <typename SampleType>
+    void processEngineIsolated(const EngineEntry& entry, juce::dsp::AudioBlock<SampleType>& block, Ramp ramp, int tap,
+                               EngineSpatializer* spatializer);
+
+    // While motion is switched on or off: renders the engine in stereo into 'output' and
+    // crossfades it with the spatialised mono downmix ('mono' is cleared scratch).
+    template <typename SampleType>
+    void renderMotionCrossfade(const EngineEntry& entry, juce::dsp::AudioBlock<SampleType>& mono,
+                               juce::dsp::AudioBlock<SampleType>& output, EngineSpatializer& spatializer);
+
+    // Runs the resonant space on the mix, crossfading after a space change.
+    template <typename SampleType>
+    void processSpace(juce::dsp::AudioBlock<SampleType>& block, const ConvolutionParams& params);
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getEngineScratch() noexcept;
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getMonoScratch() noexcept;
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getMotionScratch() noexcept;
+
     // Hiss components (kept in MechaSoundEngine for now)
     SimpleNoiseGenerator noiseGen;
     juce::dsp::StateVariableTPTFilter<float> hissFilter; // TPT Filter for hiss [cite: 18]
 
-    // Collection of sound engines
-    std::vector<std::unique_ptr<SoundEngineBase>> soundEngines;
+    // Sound engines
+    EngineList editEngines;                           // Message thread: the latest published layout
+    juce::dsp::ProcessSpec engineSpec{ 44100.0, static_cast<juce::uint32>(subBlockSize), 2 };
+    bool enginesPrepared = false;
+
+    std::atomic<EngineList*> pendingEngines{ nullptr }; // Message thread -> audio thread
+
+    static constexpr int retiredQueueSize = 16;         // Audio thread -> message thread
+    juce::AbstractFifo retiredFifo{ retiredQueueSize };
+    std::array<EngineList*, retiredQueueSize> retiredEngines{};
+
+    EngineList* activeEngines = nullptr;   // Audio thread
+    EngineList* outgoingEngines = nullptr; // Previous list, while its removed engines fade out
+    std::array<bool, maxEngines> fadingIn{};
+    std::array<bool, maxEngines> fadingOut{};
+    int transitionPosition = 0;
+    int transitionLength = 1;
+    juce::AudioBuffer<float> engineScratch; // One sub-block, for fading or analysed engines and space crossfades
+    juce::AudioBuffer<double> engineScratchDouble;
+    juce::AudioBuffer<float> monoScratch;   // One mono sub-block, for spatialised engines
+    juce::AudioBuffer<double> monoScratchDouble;
+    juce::AudioBuffer<float> motionScratch; // One sub-block, the spatialised side of a motion crossfade
+    juce::AudioBuffer<double> motionScratchDouble;
+    bool spatialWasEnabled = false;
+    int motionFadePosition = 1; // Samples into the motion crossfade; transitionLength when none is running
+
+    // Resonant space: every source above feeds the live convolver, after the mix. A new
+    // space starts in the other one, from silence, and the outgoing one fades out.
+    std::array<PartitionedConvolver, 2> convolvers;
+    int liveConvolver = 0;
+    int spaceFadePosition = 0; // Samples into the crossfade; spaceFadeLength when none is running
+    int spaceFadeLength = 1;
+    const ImpulseResponseLibrary* impulseResponses = nullptr;
+
+    juce::File sampleFile; // Message thread
+    std::shared_ptr<SamplePlaybackEngine::FrameSource> sampleSource; // Message thread: mapped sampleFile, handed to new engines
+    SamplePrefetchThread* samplePrefetchThread = nullptr; // Message thread
+    juce::File grainSourceFile;           // Message thread
+    juce::AudioBuffer<float> grainSource; // Message thread: decoded grainSourceFile, handed to new granular engines
+    double grainSourceRate = 0.0;
+    ServoBankEngine::BankSettings servoBankSettings; // Message thread
+    std::atomic<bool> nonRealtime{ false };
+    bool appliedNonRealtime = false;                        // Audio thread: the value the engines in 'appliedNonRealtimeTo' have
+    const EngineList* appliedNonRealtimeTo = nullptr;
+
+    EventTimeline timeline;
+    ModulationMatrix modulation;
+    SpectrumAnalyser* spectrumAnalyser = nullptr; // Audio thread
+
+    // Control-rate state: parameters are ramped from the previous call's set
+    // to the new one across the sub-blocks of each call.
+    EngineParameterSet previousParams;
+    EngineParameterSet controlParams;
+    bool hasPreviousParams = false;
 };
\ No newline at end of file
@@ -0,0 +1,233 @@
+// Source/AudioEngine/ModulationMatrix.cpp
+#include "../Source/AudioEngine/ModulationMatrix.h"
+#include "../Source/AudioEngine/FastMath.h"
+#include <cmath>
+
+const juce::Identifier ModulationMatrix::stateType{ "ModulationMatrix" };
+
+namespace
+{
+    const juce::Identifier routeType{ "Route" };
+    const juce::Identifier sourceProperty{ "source" };
+    const juce::Identifier destinationProperty{ "destination" };
+    const juce::Identifier depthProperty{ "depth" };
+    const juce::Identifier lfo1RateProperty{ "lfo1Rate" };
+    const juce::Identifier lfo2RateProperty{ "lfo2Rate" };
+    const juce::Identifier randomRateProperty{ "randomRate" };
+
+    constexpr juce::int64 randomSeed = 0x6d6f64; // Same random sequence on every reset
+
+    int findParameterIndex(const juce::String& parameterID)
+    {
+        for (int i = 0; i < ParameterIndex::numParameters; ++i)
+            if (parameterID == getParameterID(i))
+                return i;
+        return -1;
+    }
+
+    float wrapPhase(float phase) noexcept
+    {
+        return phase - std::floor(phase);
+    }
+}
+
+//==============================================================================
+bool ModulationMatrix::isValidDestination(int parameterIndex)
+{
+    EngineParameterSet probe;
+    return parameterIndex >= 0 && parameterIndex < ParameterIndex::numParameters
+        && getContinuousParameter(probe, parameterIndex) != nullptr;
+}
+
+juce::String ModulationMatrix::getSourceName(Source source)
+{
+    switch (source)
+    {
+        case lfo1:     return "LFO 1";
+        case lfo2:     return "LFO 2";
+        case random:   return "Random";
+        case envelope: return "Core Envelope";
+        default:       break;
+    }
+
+    jassertfalse;
+    return {};
+}
+
+bool ModulationMatrix::Settings::addRoute(const Route& route)
+{
+    if (numRoutes >= maxRoutes || !isValidDestination(route.destination))
+        return false;
+
+    auto& added = routes[static_cast<size_t>(numRoutes++)];
+    added = route;
+    added.depth = juce::jlimit(-1.0f, 1.0f, route.depth);
+    return true;
+}
+
+void ModulationMatrix::Settings::removeRoute(int index)
+{
+    if (index < 0 || index >= numRoutes)
+        return;
+
+    for (int i = index; i < numRoutes - 1; ++i)
+        routes[static_cast<size_t>(i)] = routes[static_cast<size_t>(i + 1)];
+
+    --numRoutes;
+}
+
+juce::ValueTree ModulationMatrix::Settings::toValueTree() const
+{
+    juce::ValueTree tree(stateType);
+    tree.setProperty(lfo1RateProperty, lfo1Rate, nullptr);
+    tree.setProperty(lfo2RateProperty, lfo2Rate, nullptr);
+    tree.setProperty(randomRateProperty, randomRate, nullptr);
+
+    // Destinations are stored by parameter ID, so the layout can grow
+    for (int i = 0; i < numRoutes; ++i)
+    {
+        const auto& route = routes[static_cast<size_t>(i)];
+        juce::ValueTree routeTree(routeType);
+        routeTree.setProperty(sourceProperty, static_cast<int>(route.source), nullptr);
+        routeTree.setProperty(destinationProperty, getParameterID(route.destination), nullptr);
+        routeTree.setProperty(depthProperty, route.depth, nullptr);
+        tree.appendChild(routeTree, nullptr);
+    }
+
+    return tree;
+}
+
+ModulationMatrix::Settings ModulationMatrix::Settings::fromValueTree(const juce::ValueTree& tree)
+{
+    Settings settings;
+    if (!tree.hasType(stateType))
+        return settings;
+
+    settings.lfo1Rate = tree.getProperty(lfo1RateProperty, settings.lfo1Rate);
+    settings.lfo2Rate = tree.getProperty(lfo2RateProperty, settings.lfo2Rate);
+    settings.randomRate = tree.getProperty(randomRateProperty, settings.randomRate);
+
+    for (const auto& routeTree : tree)
+    {
+        if (!routeTree.hasType(routeType))
+            continue;
+
+        Route route;
+        route.source = static_cast<Source>(juce::jlimit(0, numSources - 1, static_cast<int>(routeTree.getProperty(sourceProperty, 0))));
+        route.destination = findParameterIndex(routeTree.getProperty(destinationProperty).toString());
+        route.depth = routeTree.getProperty(depthProperty, 0.0f);
+        settings.addRoute(route); // Skips unknown destinations
+    }
+
+    return settings;
+}
+
+//==============================================================================
+ModulationMatrix::ModulationMatrix()
+    : randomGenerator(randomSeed)
+{
+}
+
+void ModulationMatrix::attachToParameters(const juce::AudioProcessorValueTreeState& apvts)
+{
+    for (int i = 0; i < ParameterIndex::numParameters; ++i)
+    {
+        auto* param = apvts.getParameter(getParameterID(i));
+        jassert(param != nullptr);
+        ranges[static_cast<size_t>(i)] = param != nullptr ? &param->getNormalisableRange() : nullptr;
+    }
+}
+
+void ModulationMatrix::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    reset();
+}
+
+void ModulationMatrix::reset() noexcept
+{
+    lfo1Phase = lfo2Phase = randomPhase = 0.0f;
+    envelopeLevel = 0.0f;
+
+    randomGenerator.setSeed(randomSeed);
+    randomFrom = randomGenerator.nextFloat() * 2.0f - 1.0f;
+    randomTo = randomGenerator.nextFloat() * 2.0f - 1.0f;
+
+    sourceValues.fill(0.0f);
+}
+
+void ModulationMatrix::setSettings(const Settings& newSettings)
+{
+    const juce::SpinLock::ScopedLockType lock(settingsLock);
+    liveSettings = newSettings;
+}
+
+void ModulationMatrix::beginBlock() noexcept
+{
+    const juce::SpinLock::ScopedTryLockType lock(settingsLock);
+    if (lock.isLocked())
+        activeSettings = liveSettings;
+}
+
+//==============================================================================
+void ModulationMatrix::process(EngineParameterSet& params, int numSamples) noexcept
+{
+    if (activeSettings.numRoutes > 0)
+    {
+        updateSources();
+
+        // Sum per destination first, so each destination is converted once
+        destinationOffsets.fill(0.0f);
+        for (int i = 0; i < activeSettings.numRoutes; ++i)
+        {
+            const auto& route = activeSettings.routes[static_cast<size_t>(i)];
+            destinationOffsets[static_cast<size_t>(route.destination)] += route.depth * sourceValues[static_cast<size_t>(route.source)];
+        }
+
+        for (int i = 0; i < activeSettings.numRoutes; ++i)
+        {
+            const auto destination = static_cast<size_t>(activeSettings.routes[static_cast<size_t>(i)].destination);
+            const float offset = destinationOffsets[destination];
+            const auto* range = ranges[destination];
+            float* value = getContinuousParameter(params, static_cast<int>(destination));
+
+            if (offset == 0.0f || range == nullptr || value == nullptr)
+                continue;
+
+            *value = range->convertFrom0to1(juce::jlimit(0.0f, 1.0f, range->convertTo0to1(*value) + offset));
+            destinationOffsets[destination] = 0.0f; // Several routes can share a destination
+        }
+    }
+
+    advanceSources(params, numSamples);
+}
+
+void ModulationMatrix::updateSources() noexcept
+{
+    sourceValues[lfo1] = FastMath::sin<FastMath::Precision::fast>(FastMath::twoPi * lfo1Phase - FastMath::pi);
+    sourceValues[lfo2] = 1.0f - 4.0f * std::abs(lfo2Phase - 0.5f);
+    sourceValues[random] = randomFrom + randomPhase * (randomTo - randomFrom);
+    sourceValues[envelope] = envelopeLevel;
+}
+
+void ModulationMatrix::advanceSources(const EngineParameterSet& params, int numSamples) noexcept
+{
+    const float seconds = static_cast<float>(numSamples / sampleRate);
+
+    lfo1Phase = wrapPhase(lfo1Phase + activeSettings.lfo1Rate * seconds);
+    lfo2Phase = wrapPhase(lfo2Phase + activeSettings.lfo2Rate * seconds);
+
+    randomPhase += activeSettings.randomRate * seconds;
+    if (randomPhase >= 1.0f)
+    {
+        randomPhase = wrapPhase(randomPhase);
+        randomFrom = randomTo;
+        randomTo = randomGenerator.nextFloat() * 2.0f - 1.0f;
+    }
+
+    // Linear rise and fall over the activation time
+    const float target = params.powerCore.activationTrigger ? 1.0f : 0.0f;
+    const float step = seconds / juce::jmax(0.001f, params.powerCore.activationTime);
+    envelopeLevel = envelopeLevel < target ? juce::jmin(target, envelopeLevel + step)
+                                           : juce::jmax(target, envelopeLevel - step);
+}
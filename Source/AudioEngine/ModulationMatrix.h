@@ -0,0 +1,109 @@
+// Source/AudioEngine/ModulationMatrix.h
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "../Source/Parameters/Parameters.h" // For EngineParameterSet and ParameterIndex
+#include <array>
+
+//==============================================================================
+/*
+    Block-rate modulation matrix shared by all engines of a MechaSoundEngine.
+
+    A fixed set of sources (two LFOs, a smoothed random source and an envelope
+    following the power core activation) is evaluated once per sub-block.
+    Routes add 'depth * source' to any continuous parameter in its normalised
+    0-1 range. The offsets are summed into one slot per destination first, so
+    the cost depends on the number of routes and not on the engines: adding a
+    route never adds an oscillator.
+
+    Settings are edited on the message thread and published under a SpinLock;
+    the audio thread try-locks once per block and keeps the previous settings
+    if the lock is busy, like ParameterMorpher.
+*/
+class ModulationMatrix
+{
+public:
+    enum Source
+    {
+        lfo1 = 0,  // Sine, bipolar
+        lfo2,      // Triangle, bipolar
+        random,    // Smoothed random steps, bipolar
+        envelope,  // Follows the power core activation over its activation time, 0-1
+        numSources
+    };
+
+    struct Route
+    {
+        Source source = lfo1;
+        int destination = -1; // ParameterIndex of a continuous parameter
+        float depth = 0.0f;   // -1..1, in the destination's normalised range
+    };
+
+    static constexpr int maxRoutes = 16;
+
+    struct Settings
+    {
+        std::array<Route, maxRoutes> routes{};
+        int numRoutes = 0;
+        float lfo1Rate = 0.5f;   // Hz
+        float lfo2Rate = 3.0f;   // Hz
+        float randomRate = 2.0f; // New random values per second
+
+        /** @brief Adds a route. Returns false if the table is full or the destination is not continuous. */
+        bool addRoute(const Route& route);
+        void removeRoute(int index);
+
+        juce::ValueTree toValueTree() const;
+        static Settings fromValueTree(const juce::ValueTree& tree);
+    };
+
+    static const juce::Identifier stateType;
+
+    /** @brief True for the parameters a route can target: the continuous ones the engines read. */
+    static bool isValidDestination(int parameterIndex);
+    static juce::String getSourceName(Source source);
+
+    ModulationMatrix();
+
+    /** @brief Caches the parameter ranges used to apply offsets. Call once after the APVTS is built. */
+    void attachToParameters(const juce::AudioProcessorValueTreeState& apvts);
+
+    void prepare(double newSampleRate);
+    void reset() noexcept;
+
+    // --- Any non-audio thread ---
+    void setSettings(const Settings& newSettings);
+
+    // --- Audio thread ---
+    /** @brief Picks up new settings, if any. Call once per block. */
+    void beginBlock() noexcept;
+
+    /** @brief Applies the routes to 'params' for the sub-block, then advances the sources by numSamples. */
+    void process(EngineParameterSet& params, int numSamples) noexcept;
+
+    float getSourceValue(Source source) const noexcept { return sourceValues[static_cast<size_t>(source)]; }
+
+private:
+    void updateSources() noexcept;
+    void advanceSources(const EngineParameterSet& params, int numSamples) noexcept;
+
+    Settings liveSettings;   // Guarded by settingsLock
+    juce::SpinLock settingsLock;
+
+    // Audio thread state
+    Settings activeSettings;
+    std::array<const juce::NormalisableRange<float>*, ParameterIndex::numParameters> ranges{};
+    std::array<float, ParameterIndex::numParameters> destinationOffsets{};
+    std::array<float, numSources> sourceValues{};
+
+    double sampleRate = 44100.0;
+    float lfo1Phase = 0.0f;      // 0-1
+    float lfo2Phase = 0.0f;
+    float randomPhase = 0.0f;
+    float randomFrom = 0.0f;
+    float randomTo = 0.0f;
+    float envelopeLevel = 0.0f;
+    juce::Random randomGenerator;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulationMatrix)
+};
@@ -1,4 +1,102 @@
 #include "NoiseGenerator.h"
 
-// Any non-inline, non-template member function definitions for SimpleNoiseGenerator
-// would go here. Currently, it's fully defined in the header.
\ No newline at end of file
+namespace
+{
+    // Output scaling so every colour sits at roughly the RMS level of the white source.
+    constexpr float pinkScale = 0.25f;  // 17 summed uniform terms
+    constexpr float brownScale = 10.0f;
+    constexpr float blueScale = 2.0f;
+
+    // Leaky integrator for brown noise (Paul Kellet's form: y = (y + 0.02 w) / 1.02)
+    constexpr float brownInputGain = 0.02f / 1.02f;
+    constexpr float brownLeak = 1.0f / 1.02f;
+
+    inline int countTrailingZeros(juce::uint32 value) noexcept
+    {
+        // Only called with value != 0. Averages one iteration for a running counter.
+        int count = 0;
+        while ((value & 1u) == 0)
+        {
+            value >>= 1;
+            ++count;
+        }
+        return count;
+    }
+}
+
+void SimpleNoiseGenerator::resetColourState()
+{
+    for (auto& state : channelStates)
+    {
+        state = ColourState();
+
+        // Start the Voss-McCartney rows filled so pink noise is at level from the first sample
+        for (auto& row : state.pinkRows)
+        {
+            row = distribution(generator);
+            state.pinkRunningSum += row;
+        }
+    }
+}
+
+float SimpleNoiseGenerator::nextPink(ColourState& state, float white)
+{
+    // Voss-McCartney: row k is refreshed every 2^(k+1) samples, chosen by the
+    // trailing zeros of a counter, so each sample costs one update regardless of row count.
+    state.pinkCounter = (state.pinkCounter + 1u) & ((1u << numPinkRows) - 1u);
+
+    if (state.pinkCounter != 0)
+    {
+        const auto row = static_cast<size_t>(countTrailingZeros(state.pinkCounter));
+        const float newValue = distribution(generator);
+        state.pinkRunningSum += newValue - state.pinkRows[row];
+        state.pinkRows[row] = newValue;
+    }
+
+    return (state.pinkRunningSum + white) * pinkScale;
+}
+
+template <typename SampleType>
+void SimpleNoiseGenerator::applyColour(SampleType* data, size_t numSamples, ColourState& state)
+{
+    // One branch per block; each loop is a straight pass over the white samples.
+    switch (colour)
+    {
+        case NoiseColour::pink:
+            for (size_t i = 0; i < numSamples; ++i)
+                data[i] = static_cast<SampleType>(nextPink(state, static_cast<float>(data[i])));
+            break;
+
+        case NoiseColour::brown:
+        {
+            float y = state.brownState;
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                y = brownLeak * y + brownInputGain * static_cast<float>(data[i]);
+                data[i] = static_cast<SampleType>(y * brownScale);
+            }
+            state.brownState = y;
+            break;
+        }
+
+        case NoiseColour::blue:
+        {
+            float previous = state.previousPink;
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const float pink = nextPink(state, static_cast<float>(data[i]));
+                data[i] = static_cast<SampleType>((pink - previous) * blueScale);
+                previous = pink;
+            }
+            state.previousPink = previous;
+            break;
+        }
+
+        case NoiseColour::white:
+        default:
+            break;
+    }
+}
+
+template void SimpleNoiseGenerator::applyColour<float>(float*, size_t, ColourState&);
+template void SimpleNoiseGenerator::applyColour<double>(double*, size_t, ColourState&);
@@ -1,30 +1,62 @@
 #pragma once
 
 #include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <vector>
 #include <random> // For std::mt19937, std::uniform_real_distribution, std::random_device
 
+// Spectral colour of the generated noise. Values match the hissColour parameter choices.
+enum class NoiseColour
+{
+    white = 0, // Flat
+    pink,      // -3 dB/octave, Voss-McCartney
+    brown,     // -6 dB/octave, leaky integrator
+    blue       // +3 dB/octave, differentiated pink
+};
+
 // --- Custom Noise Generator ---
 class SimpleNoiseGenerator
 {
 public:
-    SimpleNoiseGenerator() : distribution(-1.0f, 1.0f) {}
+    SimpleNoiseGenerator() : distribution(-1.0f, 1.0f)
+    {
+        // Non-deterministic seed, drawn once here rather than on every reset: random_device
+        // can be a syscall and reset() may run on the audio thread.
+        // Per your technical documentation: "Cryptographically secure seeding" [cite: 18]
+        generator.seed(std::random_device{}());
+    }
 
     void prepare(const juce::dsp::ProcessSpec& spec)
     {
         sampleRate = spec.sampleRate;
-        // Seed the generator. Using random_device for a non-deterministic seed.
-        // Per your technical documentation: "Cryptographically secure seeding" [cite: 18]
-        // std::random_device is suitable for this.
-        generator.seed(std::random_device{}());
+
+        // Colour state is per channel so stereo hiss stays decorrelated
+        channelStates.resize(spec.numChannels);
+        reset();
     }
 
     void reset()
     {
-        // Optionally re-seed or reset any state if needed.
-        // For mt19937, re-seeding is often done.
-        generator.seed(std::random_device{}());
+        // With a fixed seed every reset restarts the same sequence, which makes renders
+        // reproducible. Otherwise the generator simply continues its current stream.
+        const auto seed = fixedSeed.load();
+        if (seed >= 0)
+            generator.seed(static_cast<std::mt19937::result_type>(seed));
+
+        resetColourState();
     }
 
+    /** @brief Sets a fixed seed (0 to 2^32-1) applied on every reset, or -1 for a non-deterministic stream.
+        Safe to call from any thread; takes effect at the next prepare() or reset().
+    */
+    void setSeed(juce::int64 newSeed) noexcept { fixedSeed.store(newSeed); }
+    juce::int64 getSeed() const noexcept { return fixedSeed.load(); }
+
+    /** @brief Selects the noise colour. Colour state is kept, so switching does not click. */
+    void setColour(NoiseColour newColour) noexcept { colour = newColour; }
+    NoiseColour getColour() const noexcept { return colour; }
+
     template<typename ProcessContext>
     void process(const ProcessContext& context)
     {
@@ -33,10 +65,16 @@ public:
         for (size_t channel = 0; channel < outBlock.getNumChannels(); ++channel)
         {
             auto* channelData = outBlock.getChannelPointer(channel);
-            for (size_t sample = 0; sample < outBlock.getNumSamples(); ++sample)
+            const auto numSamples = outBlock.getNumSamples();
+
+            // White noise is the source for every colour; the colour pass then runs over the whole block.
+            for (size_t sample = 0; sample < numSamples; ++sample)
             {
                 channelData[sample] = distribution(generator);
             }
+
+            if (colour != NoiseColour::white && channel < channelStates.size())
+                applyColour(channelData, numSamples, channelStates[channel]);
         }
     }
 
@@ -47,7 +85,27 @@ public:
     }
 
 private:
+    static constexpr int numPinkRows = 16; // Voss-McCartney rows, flat to about fs / 2^16
+
+    struct ColourState
+    {
+        std::array<float, numPinkRows> pinkRows{};
+        float pinkRunningSum = 0.0f;
+        juce::uint32 pinkCounter = 0;
+        float brownState = 0.0f;
+        float previousPink = 0.0f;
+    };
+
+    void resetColourState();
+    template <typename SampleType>
+    void applyColour(SampleType* data, size_t numSamples, ColourState& state); // Instantiated for float and double
+    float nextPink(ColourState& state, float white);
+
     std::mt19937 generator; // Mersenne Twister [cite: 18]
     std::uniform_real_distribution<float> distribution; // Uniform real distribution [-1.0, 1.0] [cite: 18]
     double sampleRate = 44100.0; // Initialized, then set in prepare
-};
\ No newline at end of file
+
+    NoiseColour colour = NoiseColour::white;
+    std::vector<ColourState> channelStates;
+    std::atomic<juce::int64> fixedSeed{ -1 }; // -1: non-deterministic
+};
@@ -0,0 +1,149 @@
+// Source/AudioEngine/OfflineRenderer.cpp
+#include "../Source/AudioEngine/OfflineRenderer.h"
+
+namespace
+{
+    constexpr int stopTimeoutMilliseconds = 5000;
+    constexpr int writerWaitMilliseconds = 2;
+}
+
+OfflineRenderer::OfflineRenderer(const ImpulseResponseLibrary& library, const juce::AudioProcessorValueTreeState& apvts)
+    : juce::Thread("Offline render"),
+      impulseResponses(library),
+      parameterState(apvts)
+{
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    cancel();
+    writer.reset();
+    writerThread.stopThread(stopTimeoutMilliseconds);
+}
+
+//==============================================================================
+bool OfflineRenderer::start(const Job& job)
+{
+    if (isRendering() || job.lengthSeconds <= 0.0 || job.sampleRate <= 0.0 || job.numChannels <= 0)
+        return false;
+
+    // A finished render may still be leaving run()
+    stopThread(stopTimeoutMilliseconds);
+    writer.reset();
+    engine.reset();
+
+    job.outputFile.deleteFile();
+    auto stream = job.outputFile.createOutputStream();
+    if (stream == nullptr || stream->failedToOpen())
+        return false;
+
+    std::unique_ptr<juce::AudioFormatWriter> fileWriter(juce::WavAudioFormat().createWriterFor(
+        stream.get(), job.sampleRate, static_cast<unsigned int>(job.numChannels), job.bitsPerSample, {}, 0));
+    if (fileWriter == nullptr)
+        return false;
+    stream.release(); // Owned by the writer from here on
+
+    writerThread.startThread();
+    writer = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(fileWriter.release(), writerThread, writerBufferSize);
+
+    // A private engine, configured like the live ones but never seen by the audio thread
+    engine = std::make_unique<MechaSoundEngine>();
+    engine->setImpulseResponseLibrary(&impulseResponses);
+    engine->getModulationMatrix().attachToParameters(parameterState);
+    engine->getModulationMatrix().setSettings(job.modulation);
+    engine->setNoiseSeed(job.noiseSeed);
+    engine->setServoBankSettings(job.servoBank);
+    engine->setEngineLayout(job.engineLayout);
+    engine->setNonRealtime(true);
+    if (job.foleyFile != juce::File())
+        engine->setSampleFile(job.foleyFile);
+    if (job.grainSourceFile != juce::File())
+        engine->setGrainSourceFile(job.grainSourceFile);
+    for (const auto& event : job.timelineEvents)
+        engine->scheduleEvent(event);
+
+    outputFile = job.outputFile;
+    renderParams = job.params;
+    renderTransport = job.transport;
+    renderTransport.isPlaying = true;
+    renderGain = job.masterGain;
+    renderSampleRate = job.sampleRate;
+    renderChannels = job.numChannels;
+    totalSamples = static_cast<juce::int64>(job.lengthSeconds * job.sampleRate);
+
+    progress.store(0.0);
+    state.store(State::rendering);
+    startThread();
+    return true;
+}
+
+void OfflineRenderer::cancel()
+{
+    if (!isRendering())
+        return;
+
+    stopThread(stopTimeoutMilliseconds);
+
+    // Closing the writer flushes it; the partial file is then removed
+    writer.reset();
+    engine.reset();
+    outputFile.deleteFile();
+    state.store(State::cancelled);
+}
+
+//==============================================================================
+void OfflineRenderer::run()
+{
+    const juce::dsp::ProcessSpec spec{ renderSampleRate, static_cast<juce::uint32>(renderBlockSize), static_cast<juce::uint32>(renderChannels) };
+    engine->prepare(spec);
+    limiter.prepare(spec);
+    limiter.setParameters(renderParams.limiter);
+
+    // The first 'latency' samples only fill the limiter's delay line; the file starts after them
+    const juce::int64 latency = limiter.getLatencySamples();
+    const juce::int64 samplesToRender = totalSamples + latency;
+
+    juce::AudioBuffer<float> buffer(renderChannels, renderBlockSize);
+    std::vector<const float*> writePointers(static_cast<size_t>(renderChannels));
+    TransportState transport = renderTransport;
+    juce::int64 rendered = 0;
+
+    while (rendered < samplesToRender)
+    {
+        if (threadShouldExit())
+            return;
+
+        const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(renderBlockSize), samplesToRender - rendered));
+        const auto block = juce::dsp::AudioBlock<float>(buffer).getSubBlock(0, static_cast<size_t>(numSamples));
+        buffer.clear();
+
+        engine->setTransport(transport);
+        engine->process(block, renderParams);
+        buffer.applyGain(0, numSamples, renderGain);
+        limiter.process(block);
+
+        const int skip = static_cast<int>(juce::jlimit(static_cast<juce::int64>(0), static_cast<juce::int64>(numSamples), latency - rendered));
+        if (skip < numSamples)
+        {
+            for (int channel = 0; channel < renderChannels; ++channel)
+                writePointers[static_cast<size_t>(channel)] = buffer.getReadPointer(channel, skip);
+
+            // The disk thread can fall behind; wait for room instead of dropping audio
+            while (!writer->write(writePointers.data(), numSamples - skip))
+            {
+                if (threadShouldExit())
+                    return;
+                wait(writerWaitMilliseconds);
+            }
+        }
+
+        rendered += numSamples;
+        transport.ppqPosition += numSamples * transport.bpm / (60.0 * renderSampleRate);
+        progress.store(static_cast<double>(rendered) / static_cast<double>(samplesToRender));
+    }
+
+    // Flushes the queued samples and closes the file
+    writer.reset();
+    engine.reset();
+    state.store(State::finished);
+}
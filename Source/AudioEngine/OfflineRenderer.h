@@ -0,0 +1,110 @@
+// Source/AudioEngine/OfflineRenderer.h
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "../Source/AudioEngine/MechaSoundEngine.h"
+#include "../Source/AudioEngine/ImpulseResponseLibrary.h"
+#include "../Source/AudioEngine/ModulationMatrix.h"
+#include "../Source/AudioEngine/LookaheadLimiter.h"
+#include "../Parameters/Parameters.h"
+
+//==============================================================================
+/*
+    Renders the current sound to a WAV file, faster than realtime.
+
+    start() builds a private MechaSoundEngine from a snapshot of the plugin
+    state (parameters, engine layout, modulation, servo bank, noise seed, foley
+    file, grain source). A background thread renders it block by block, as fast as it can, into a
+    ThreadedWriter, which streams to disk on its own thread. The live engines
+    are never touched, so export and playback run side by side.
+
+    The snapshot is frozen at start(): knob moves during an export are not
+    heard in the file. The parameters are the ones the live engine runs on,
+    with the morph pad applied at its cursor. The render starts at the
+    host's transport position and tempo, and the timeline events in the job
+    fire at their beats as they do live.
+    The master limiter runs as it does live; its latency is trimmed from the
+    start of the file.
+
+    The impulse response library is shared with the live engines. Kernels are
+    only rebuilt in its prepare(), so the owner must cancel() any export
+    before preparing the library again.
+*/
+class OfflineRenderer : private juce::Thread
+{
+public:
+    struct Job
+    {
+        juce::File outputFile;
+        double lengthSeconds = 10.0;
+        double sampleRate = 48000.0;
+        int numChannels = 2;
+        int bitsPerSample = 24;
+
+        EngineParameterSet params;
+        float masterGain = 0.707f;
+        std::vector<MechaSoundEngine::EngineType> engineLayout;
+        ModulationMatrix::Settings modulation;
+        ServoBankEngine::BankSettings servoBank;
+        juce::int64 noiseSeed = -1;
+        juce::File foleyFile;
+        juce::File grainSourceFile;
+        TransportState transport;                 // Where and how fast the render starts; always playing
+        std::vector<TimelineEvent> timelineEvents; // At most EventTimeline::fifoSize
+    };
+
+    enum class State
+    {
+        idle,
+        rendering,
+        finished,
+        cancelled
+    };
+
+    OfflineRenderer(const ImpulseResponseLibrary& library, const juce::AudioProcessorValueTreeState& apvts);
+    ~OfflineRenderer() override;
+
+    // --- Message thread ---
+    /** @brief Starts rendering 'job'. Returns false if an export is running or the file cannot be created. */
+    bool start(const Job& job);
+
+    /** @brief Stops the export, if any, and waits for the thread. The partial file is deleted. */
+    void cancel();
+
+    // --- Any thread ---
+    State getState() const noexcept { return state.load(); }
+    bool isRendering() const noexcept { return getState() == State::rendering; }
+    double getProgress() const noexcept { return progress.load(); } // 0-1
+    juce::File getOutputFile() const { return outputFile; }
+
+    static constexpr int renderBlockSize = 512;
+    static constexpr int writerBufferSize = 1 << 16; // Samples per channel queued for the disk thread
+
+private:
+    void run() override;
+
+    const ImpulseResponseLibrary& impulseResponses;
+    const juce::AudioProcessorValueTreeState& parameterState;
+
+    // Set up by start(), used by the render thread only while it runs
+    juce::TimeSliceThread writerThread{ "Export writer" }; // Declared first: the writer detaches from it on destruction
+    std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> writer;
+    std::unique_ptr<MechaSoundEngine> engine;
+    LookaheadLimiter limiter;
+    juce::File outputFile;
+    EngineParameterSet renderParams;
+    TransportState renderTransport;
+    float renderGain = 1.0f;
+    double renderSampleRate = 48000.0;
+    int renderChannels = 2;
+    juce::int64 totalSamples = 0;
+
+    std::atomic<State> state{ State::idle };
+    std::atomic<double> progress{ 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
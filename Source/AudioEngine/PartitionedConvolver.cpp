@@ -0,0 +1,389 @@
+// Source/AudioEngine/PartitionedConvolver.cpp
+#include "../Source/AudioEngine/PartitionedConvolver.h"
+#include <algorithm>
+
+namespace
+{
+    int getOrderOf(int fftSize) noexcept
+    {
+        int order = 0;
+        while ((1 << order) < fftSize)
+            ++order;
+        return order;
+    }
+
+    int getNumPartitions(int numTaps, int partitionSize) noexcept
+    {
+        return numTaps > 0 ? (numTaps + partitionSize - 1) / partitionSize : 0;
+    }
+}
+
+//==============================================================================
+// One uniformly partitioned overlap-save stage (UPOLS). Every time a full
+// partition of input has arrived, the last two partitions are transformed into
+// the frequency-domain delay line and multiplied with the kernel partitions;
+// the second half of the inverse transform is the stage output.
+//
+// The work for a partition is split into units: per channel one forward FFT,
+// one multiply-accumulate per kernel partition and one inverse FFT. A stage
+// that starts at tap P plays its result during the next partition, so it runs
+// every unit as soon as the partition completes. A stage that starts at tap
+// 2P or later has a whole partition of slack: it spreads the units evenly over
+// the following partition's samples and plays the result one partition later.
+class PartitionedConvolver::Stage
+{
+public:
+    Stage(int stagePartitionSize, int stageStartTap, int maxStagePartitions, int numChannels)
+        : partitionSize(stagePartitionSize),
+          numBins(stagePartitionSize + 1),
+          maxPartitions(juce::jmax(1, maxStagePartitions)),
+          spreadWork(stageStartTap >= 2 * stagePartitionSize),
+          fft(getOrderOf(2 * stagePartitionSize)),
+          fftBuffer(static_cast<size_t>(4 * stagePartitionSize), 0.0f),
+          accumulator(static_cast<size_t>(2 * numBins), 0.0f)
+    {
+        channels.resize(static_cast<size_t>(numChannels));
+        for (auto& channel : channels)
+        {
+            channel.input.assign(static_cast<size_t>(2 * partitionSize), 0.0f);
+            channel.pendingInput.assign(static_cast<size_t>(2 * partitionSize), 0.0f);
+            channel.delayLine.assign(static_cast<size_t>(maxPartitions * 2 * numBins), 0.0f);
+            channel.output.assign(static_cast<size_t>(partitionSize), 0.0f);
+            channel.nextOutput.assign(static_cast<size_t>(partitionSize), 0.0f);
+        }
+    }
+
+    void reset() noexcept
+    {
+        for (auto& channel : channels)
+        {
+            std::fill(channel.input.begin(), channel.input.end(), 0.0f);
+            std::fill(channel.pendingInput.begin(), channel.pendingInput.end(), 0.0f);
+            std::fill(channel.delayLine.begin(), channel.delayLine.end(), 0.0f);
+            std::fill(channel.output.begin(), channel.output.end(), 0.0f);
+            std::fill(channel.nextOutput.begin(), channel.nextOutput.end(), 0.0f);
+        }
+        fill = 0;
+        delayLineIndex = 0;
+        workSlot = 0;
+        workChannels = 0;
+        unitsPerChannel = 0;
+        unitsDone = 0;
+    }
+
+    // Adds this stage's output to 'wet' and consumes 'dry'
+    void process(const ConvolutionKernel::Stage& kernelStage, const juce::AudioBuffer<float>& dry,
+                 juce::AudioBuffer<float>& wet, int numChannels, int numSamples) noexcept
+    {
+        int done = 0;
+
+        while (done < numSamples)
+        {
+            const int count = juce::jmin(numSamples - done, partitionSize - fill);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto& channel = channels[static_cast<size_t>(ch)];
+                std::copy(dry.getReadPointer(ch, done), dry.getReadPointer(ch, done) + count,
+                          channel.input.data() + partitionSize + fill);
+                juce::FloatVectorOperations::add(wet.getWritePointer(ch, done), channel.output.data() + fill, count);
+            }
+
+            fill += count;
+            done += count;
+
+            // The previous partition's work, in proportion to the time passed; all of it by the end
+            if (spreadWork)
+                runUnits(kernelStage, (getTotalUnits() * fill + partitionSize - 1) / partitionSize);
+
+            if (fill == partitionSize)
+            {
+                if (spreadWork)
+                    swapOutputs();
+
+                beginPartition(kernelStage, numChannels);
+
+                if (!spreadWork)
+                {
+                    runUnits(kernelStage, getTotalUnits());
+                    swapOutputs();
+                }
+
+                fill = 0;
+            }
+        }
+    }
+
+private:
+    struct Channel
+    {
+        std::vector<float> input;        // Previous partition, then the one being filled
+        std::vector<float> pendingInput; // The two partitions the current work transforms
+        std::vector<float> delayLine;    // maxPartitions input spectra
+        std::vector<float> output;       // Result being played
+        std::vector<float> nextOutput;   // Result being computed
+    };
+
+    int getTotalUnits() const noexcept { return workChannels * unitsPerChannel; }
+
+    // Takes a snapshot of the completed input and queues its work
+    void beginPartition(const ConvolutionKernel::Stage& kernelStage, int numChannels) noexcept
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto& channel = channels[static_cast<size_t>(ch)];
+            std::copy(channel.input.begin(), channel.input.end(), channel.pendingInput.begin());
+
+            // The partition just completed becomes the previous one
+            std::copy(channel.input.begin() + partitionSize, channel.input.end(), channel.input.begin());
+        }
+
+        workSlot = delayLineIndex;
+        delayLineIndex = (delayLineIndex + 1) % maxPartitions;
+        workChannels = numChannels;
+        unitsPerChannel = juce::jmin(kernelStage.numPartitions, maxPartitions) + 2;
+        unitsDone = 0;
+    }
+
+    void swapOutputs() noexcept
+    {
+        for (int ch = 0; ch < workChannels; ++ch)
+        {
+            auto& channel = channels[static_cast<size_t>(ch)];
+            std::swap(channel.output, channel.nextOutput);
+        }
+    }
+
+    // Runs the queued units up to (not including) 'target', in channel order
+    void runUnits(const ConvolutionKernel::Stage& kernelStage, int target) noexcept
+    {
+        const int binFloats = 2 * numBins;
+        target = juce::jmin(target, getTotalUnits());
+
+        for (; unitsDone < target; ++unitsDone)
+        {
+            auto& channel = channels[static_cast<size_t>(unitsDone / unitsPerChannel)];
+            const int step = unitsDone % unitsPerChannel;
+
+            if (step == 0)
+            {
+                // Spectrum of the two input partitions goes into the newest delay line slot
+                std::copy(channel.pendingInput.begin(), channel.pendingInput.end(), fftBuffer.begin());
+                std::fill(fftBuffer.begin() + 2 * partitionSize, fftBuffer.end(), 0.0f);
+                fft.performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+                std::copy(fftBuffer.begin(), fftBuffer.begin() + binFloats, channel.delayLine.data() + workSlot * binFloats);
+                std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+            }
+            else if (step < unitsPerChannel - 1)
+            {
+                // X[n - k] * H[k] for one kernel partition, bins interleaved as (re, im).
+                // A kernel swapped in since the work was queued may have fewer partitions.
+                const int k = step - 1;
+                if (k >= kernelStage.numPartitions)
+                    continue;
+
+                const int slot = (workSlot - k + maxPartitions) % maxPartitions;
+                const float* x = channel.delayLine.data() + slot * binFloats;
+                const float* h = kernelStage.spectra.data() + k * binFloats;
+                float* acc = accumulator.data();
+
+                for (int bin = 0; bin < binFloats; bin += 2)
+                {
+                    acc[bin] += x[bin] * h[bin] - x[bin + 1] * h[bin + 1];
+                    acc[bin + 1] += x[bin] * h[bin + 1] + x[bin + 1] * h[bin];
+                }
+            }
+            else
+            {
+                // JUCE's inverse transform is normalised and mirrors the upper half itself
+                std::copy(accumulator.begin(), accumulator.end(), fftBuffer.begin());
+                fft.performRealOnlyInverseTransform(fftBuffer.data());
+
+                // Overlap-save: the first half is circular aliasing, the second half is valid
+                std::copy(fftBuffer.begin() + partitionSize, fftBuffer.begin() + 2 * partitionSize, channel.nextOutput.begin());
+            }
+        }
+    }
+
+    const int partitionSize;
+    const int numBins;
+    const int maxPartitions;
+    const bool spreadWork;
+
+    juce::dsp::FFT fft;
+    std::vector<float> fftBuffer;   // 2 * fftSize floats, as juce::dsp::FFT requires
+    std::vector<float> accumulator; // The channel whose units are running
+    std::vector<Channel> channels;
+
+    int fill = 0;
+    int delayLineIndex = 0;
+
+    // Queued work for the last completed partition
+    int workSlot = 0;
+    int workChannels = 0;
+    int unitsPerChannel = 0;
+    int unitsDone = 0;
+};
+
+//==============================================================================
+PartitionedConvolver::PartitionedConvolver() = default;
+PartitionedConvolver::~PartitionedConvolver() = default;
+
+void PartitionedConvolver::prepare(const juce::dsp::ProcessSpec& spec, int maxImpulseLength)
+{
+    const int numChannels = static_cast<int>(spec.numChannels);
+    maxChunkSize = juce::jmax(1, static_cast<int>(spec.maximumBlockSize));
+
+    const int stageEnds[] = { stageStartTaps[1], juce::jmax(stageStartTaps[1], maxImpulseLength) };
+
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+        const int maxPartitions = getNumPartitions(stageEnds[i] - stageStartTaps[i], stagePartitionSizes[i]);
+        stages[i] = std::make_unique<Stage>(stagePartitionSizes[i], stageStartTaps[i], maxPartitions, numChannels);
+    }
+
+    dryBuffer.setSize(numChannels, maxChunkSize);
+    wetBuffer.setSize(numChannels, maxChunkSize);
+    headHistory.assign(static_cast<size_t>(numChannels),
+                       std::vector<float>(static_cast<size_t>(headSize - 1 + maxChunkSize), 0.0f));
+    headReversed.assign(static_cast<size_t>(headSize), 0.0f);
+
+    kernel = nullptr;
+    reset();
+}
+
+void PartitionedConvolver::reset()
+{
+    for (auto& stage : stages)
+        if (stage != nullptr)
+            stage->reset();
+
+    for (auto& history : headHistory)
+        std::fill(history.begin(), history.end(), 0.0f);
+}
+
+void PartitionedConvolver::setKernel(const ConvolutionKernel* newKernel) noexcept
+{
+    if (newKernel == kernel)
+        return;
+
+    // Coming out of bypass the delay lines hold stale input
+    if (kernel == nullptr)
+        reset();
+
+    kernel = newKernel;
+
+    if (kernel != nullptr)
+        std::reverse_copy(kernel->head.begin(), kernel->head.end(), headReversed.begin());
+}
+
+template <typename SampleType>
+void PartitionedConvolver::process(const juce::dsp::AudioBlock<SampleType>& block, float mix)
+{
+    if (kernel == nullptr || stages[0] == nullptr)
+        return;
+
+    const int numChannels = juce::jmin(static_cast<int>(block.getNumChannels()), dryBuffer.getNumChannels());
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const float wetGain = juce::jlimit(0.0f, 1.0f, mix);
+    const float dryGain = 1.0f - wetGain;
+
+    for (int start = 0; start < numSamples; start += maxChunkSize)
+    {
+        const int count = juce::jmin(maxChunkSize, numSamples - start);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const SampleType* in = block.getChannelPointer(static_cast<size_t>(ch)) + start;
+            float* dry = dryBuffer.getWritePointer(ch);
+            for (int i = 0; i < count; ++i)
+                dry[i] = static_cast<float>(in[i]);
+        }
+
+        processChunk(numChannels, count);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            SampleType* out = block.getChannelPointer(static_cast<size_t>(ch)) + start;
+            const float* dry = dryBuffer.getReadPointer(ch);
+            const float* wet = wetBuffer.getReadPointer(ch);
+            for (int i = 0; i < count; ++i)
+                out[i] = static_cast<SampleType>(dry[i] * dryGain + wet[i] * wetGain);
+        }
+    }
+}
+
+void PartitionedConvolver::processChunk(int numChannels, int numSamples)
+{
+    // Head: direct convolution over the first headSize taps, no latency
+    const float* taps = headReversed.data();
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& history = headHistory[static_cast<size_t>(ch)];
+        const float* dry = dryBuffer.getReadPointer(ch);
+        float* wet = wetBuffer.getWritePointer(ch);
+
+        std::copy(dry, dry + numSamples, history.data() + headSize - 1);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float* x = history.data() + i;
+            float sum = 0.0f;
+            for (int k = 0; k < headSize; ++k)
+                sum += taps[k] * x[k];
+            wet[i] = sum;
+        }
+
+        std::copy(history.data() + numSamples, history.data() + numSamples + headSize - 1, history.data());
+    }
+
+    // Tail: the partitioned stages add their part on top
+    for (size_t i = 0; i < stages.size(); ++i)
+        stages[i]->process(kernel->stages[i], dryBuffer, wetBuffer, numChannels, numSamples);
+}
+
+//==============================================================================
+std::unique_ptr<ConvolutionKernel> PartitionedConvolver::createKernel(const std::vector<float>& impulseResponse)
+{
+    auto newKernel = std::make_unique<ConvolutionKernel>();
+    const int length = static_cast<int>(impulseResponse.size());
+    newKernel->lengthInSamples = length;
+
+    newKernel->head.assign(static_cast<size_t>(headSize), 0.0f);
+    std::copy(impulseResponse.begin(), impulseResponse.begin() + juce::jmin(length, headSize), newKernel->head.begin());
+
+    const int stageEnds[] = { juce::jmin(length, stageStartTaps[1]), length };
+
+    for (size_t i = 0; i < newKernel->stages.size(); ++i)
+    {
+        const int partitionSize = stagePartitionSizes[i];
+        const int binFloats = 2 * (partitionSize + 1);
+        const int numPartitions = getNumPartitions(stageEnds[i] - stageStartTaps[i], partitionSize);
+
+        auto& stage = newKernel->stages[i];
+        stage.numPartitions = numPartitions;
+        stage.spectra.assign(static_cast<size_t>(numPartitions * binFloats), 0.0f);
+
+        juce::dsp::FFT fft(getOrderOf(2 * partitionSize));
+        std::vector<float> buffer(static_cast<size_t>(4 * partitionSize));
+
+        for (int k = 0; k < numPartitions; ++k)
+        {
+            // Partition k, zero-padded to the FFT size
+            std::fill(buffer.begin(), buffer.end(), 0.0f);
+            const int first = stageStartTaps[i] + k * partitionSize;
+            const int last = juce::jmin(first + partitionSize, stageEnds[i]);
+            std::copy(impulseResponse.begin() + first, impulseResponse.begin() + last, buffer.begin());
+
+            fft.performRealOnlyForwardTransform(buffer.data(), true);
+            std::copy(buffer.begin(), buffer.begin() + binFloats, stage.spectra.begin() + k * binFloats);
+        }
+    }
+
+    return newKernel;
+}
+
+template void PartitionedConvolver::process<float>(const juce::dsp::AudioBlock<float>&, float);
+template void PartitionedConvolver::process<double>(const juce::dsp::AudioBlock<double>&, float);
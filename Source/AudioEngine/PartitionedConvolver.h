@@ -0,0 +1,88 @@
+// Source/AudioEngine/PartitionedConvolver.h
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+// Impulse response split for PartitionedConvolver. Built off the audio thread
+// by PartitionedConvolver::createKernel() and never modified afterwards.
+struct ConvolutionKernel
+{
+    struct Stage
+    {
+        std::vector<float> spectra; // numPartitions * (partitionSize + 1) interleaved complex bins
+        int numPartitions = 0;
+    };
+
+    std::vector<float> head; // First headSize taps, applied in the time domain
+    std::array<Stage, 2> stages;
+    int lengthInSamples = 0;
+};
+
+//==============================================================================
+/*
+    Zero-latency, non-uniformly partitioned FFT convolution.
+
+    The impulse response is split in three:
+    - taps [0, 128) run as a direct FIR, so the output needs no look-ahead;
+    - taps [128, 2048) run as uniformly partitioned overlap-save with 128-sample
+      partitions;
+    - the rest runs with 1024-sample partitions.
+    The 128-sample stage starts at tap 128, so each FFT block is computed as
+    soon as its input block is complete and is played during the next one. The
+    1024-sample stage starts at tap 2048, a whole partition later than it has
+    to: its FFTs and multiply-accumulates are spread evenly over the next 1024
+    samples instead of landing in one sub-block, and the result is played in
+    the partition after that. No stage adds latency, and the large partitions
+    keep long tails cheap without a spike every 1024 samples.
+
+    Input spectra are kept in a frequency-domain delay line per stage, so a new
+    kernel (same sample rate) can be swapped in at any block with setKernel().
+*/
+class PartitionedConvolver
+{
+public:
+    static constexpr int headSize = 128;
+    static constexpr std::array<int, 2> stagePartitionSizes{ 128, 1024 };
+    static constexpr std::array<int, 2> stageStartTaps{ 128, 2048 }; // The second stage spreads its work (see Stage)
+
+    PartitionedConvolver();
+    ~PartitionedConvolver();
+
+    /** @brief Allocates everything for kernels up to maxImpulseLength samples. */
+    void prepare(const juce::dsp::ProcessSpec& spec, int maxImpulseLength);
+    void reset();
+
+    /** @brief Audio thread: selects the kernel to use, or nullptr to bypass. The kernel
+        must outlive its use and must not be longer than the prepared maximum.
+    */
+    void setKernel(const ConvolutionKernel* newKernel) noexcept;
+    bool isActive() const noexcept { return kernel != nullptr; }
+    const ConvolutionKernel* getKernel() const noexcept { return kernel; }
+
+    /** @brief Replaces the block with dry * (1 - mix) + wet * mix. Instantiated for float and double. */
+    template <typename SampleType>
+    void process(const juce::dsp::AudioBlock<SampleType>& block, float mix);
+
+    /** @brief Builds a kernel from an impulse response. Allocates; call from a background thread. */
+    static std::unique_ptr<ConvolutionKernel> createKernel(const std::vector<float>& impulseResponse);
+
+private:
+    class Stage;
+
+    void processChunk(int numChannels, int numSamples);
+
+    const ConvolutionKernel* kernel = nullptr;
+
+    std::array<std::unique_ptr<Stage>, 2> stages;
+
+    juce::AudioBuffer<float> dryBuffer;       // Float copy of the input chunk
+    juce::AudioBuffer<float> wetBuffer;
+    std::vector<std::vector<float>> headHistory; // Per channel: headSize - 1 past samples + one chunk
+    std::vector<float> headReversed;          // Head taps, reversed for a forward dot product
+    int maxChunkSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PartitionedConvolver)
+};
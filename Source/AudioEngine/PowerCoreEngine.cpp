@@ -1,19 +1,7 @@
 #include "PowerCoreEngine.h"
-#include <cmath> // For std::sin, std::tanh
 
 PowerCoreEngine::PowerCoreEngine()
 {
-    // Initialize oscillators with a sine wave function
-    fundamentalOsc.initialise([](float x) { return std::sin(x); });
-    pulsationLFO.initialise([](float x) { return std::sin(x); }); // Simple sine LFO for pulsation
-
-    // Initialize harmonic oscillators
-    for (int i = 0; i < MAX_HARMONICS; ++i)
-    {
-        harmonicOscillators.emplace_back();
-        harmonicOscillators.back().initialise([](float x) { return std::sin(x); });
-    }
-
     isEnabledFlag = true;
 }
 
@@ -33,9 +21,11 @@ void PowerCoreEngine::prepare(const juce::dsp::ProcessSpec& spec)
     humGain.prepare(spec);
     humGain.setGainLinear(0.0f);
 
-    // Ensure activationTime is positive before using it for smoothing reset
-    float initialActivationTime = (currentActivationTime > 0.001f) ? currentActivationTime : 2.0f; // Default if invalid
-    smoothedHumLevel.reset(spec.sampleRate, initialActivationTime);
+    humLevelEnvelope.prepare(spec.sampleRate);
+    activationEnvelope.prepare(spec.sampleRate);
+    humLevelGains.assign(juce::jmax<size_t>(1, spec.maximumBlockSize), 0.0f);
+    activationGains.assign(humLevelGains.size(), 0.0f);
+
     smoothedFilterCutoff.reset(spec.sampleRate, 0.05);
 
     reset();
@@ -52,13 +42,26 @@ void PowerCoreEngine::reset()
     toneFilter.reset();
     humGain.reset();
 
-    smoothedHumLevel.setCurrentAndTargetValue(0.0f);
     // Reset filter smoothed value too
     smoothedFilterCutoff.setCurrentAndTargetValue(currentFilterCutoff); // Assuming currentFilterCutoff has a sane default
+    toneFilter.setCutoffFrequency(currentFilterCutoff);
 
-    activationEnvelope = 0.0f;
-    isActivating = false;
-    isDeactivating = false;
+    // Start from silence; a core that is switched on powers up again
+    humLevelEnvelope.reset(0.0f);
+    activationEnvelope.reset(0.0f);
+    if (currentActivationTrigger)
+        activationEnvelope.rampTo(1.0f, currentActivationTime, BlockEnvelope::Shape::sCurve);
+}
+
+void PowerCoreEngine::resetTo(const EngineParameterSet& allParams)
+{
+    // Cache the target first so reset() sets the filter and oscillators from it
+    updateParameters(allParams);
+    reset();
+
+    // Already powered: no ramp from silence over activationTime
+    humLevelEnvelope.reset(currentHumLevel);
+    activationEnvelope.reset(currentActivationTrigger ? 1.0f : 0.0f);
 }
 
 void PowerCoreEngine::updateParameters(const EngineParameterSet& allParams)
@@ -72,17 +75,11 @@ void PowerCoreEngine::updateParameters(const EngineParameterSet& allParams)
 
     float newActivationTime = (params.activationTime > 0.001f) ? params.activationTime : 0.001f; // Ensure positive
 
-    if (params.activationTrigger && !currentActivationTrigger) {
-        isActivating = true;
-        isDeactivating = false;
-        // Calculate increment based on sample rate and new activation time
-        activationIncrement = (currentSampleRate > 0) ? (1.0f / (newActivationTime * static_cast<float>(currentSampleRate))) : 1.0f;
-    }
-    else if (!params.activationTrigger && currentActivationTrigger) {
-        isDeactivating = true;
-        isActivating = false;
-        activationIncrement = (currentSampleRate > 0) ? (1.0f / (newActivationTime * static_cast<float>(currentSampleRate))) : 1.0f;
-    }
+    // Power up or down from wherever the envelope is now [cite: 10]. A disabled core
+    // stays down; setEnabled(true) powers it up if the trigger is on by then.
+    if (params.activationTrigger != currentActivationTrigger && isEnabledFlag)
+        activationEnvelope.rampTo(params.activationTrigger ? 1.0f : 0.0f, newActivationTime, BlockEnvelope::Shape::sCurve);
+
     currentActivationTrigger = params.activationTrigger;
     currentActivationTime = newActivationTime;
 
@@ -91,13 +88,7 @@ void PowerCoreEngine::updateParameters(const EngineParameterSet& allParams)
     currentFilterCutoff = params.filterCutoff;
     currentFilterResonance = params.filterResonance;
 
-    smoothedHumLevel.setTargetValue(currentHumLevel);
-    // Check if currentActivationTime has changed and smoothing duration needs update
-    if (currentActivationTime > 0.001f) {
-        // Always reset with new activation time - SmoothedValue will handle smoothing appropriately
-        smoothedHumLevel.reset(currentSampleRate, currentActivationTime);
-    }
-
+    humLevelEnvelope.rampTo(currentHumLevel, humLevelRampSeconds);
 
     smoothedFilterCutoff.setTargetValue(currentFilterCutoff);
 
@@ -105,127 +96,137 @@ void PowerCoreEngine::updateParameters(const EngineParameterSet& allParams)
 
     int numActiveHarmonics = static_cast<int>(currentHumComplexity * MAX_HARMONICS);
 
-    fundamentalOsc.setFrequency(currentFundamentalPitch, true);
+    fundamentalOsc.setFrequency(currentFundamentalPitch);
     for (int i = 0; i < MAX_HARMONICS; ++i)
     {
         if (i < numActiveHarmonics) {
-            harmonicOscillators[i].setFrequency(currentFundamentalPitch * (2.0f * (i + 1) + 1.0f), true);
+            harmonicOscillators[static_cast<size_t>(i)].setFrequency(currentFundamentalPitch * (2.0f * (i + 1) + 1.0f));
         }
     }
 
-    toneFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
     toneFilter.setResonance(currentFilterResonance);
+    if (!smoothedFilterCutoff.isSmoothing())
+        toneFilter.setCutoffFrequency(smoothedFilterCutoff.getCurrentValue());
 }
 
 void PowerCoreEngine::processAddingTo(juce::dsp::ProcessContextReplacing<float>& context)
 {
-    if (!isEnabledFlag) return;
+    processInternal(context.getOutputBlock());
+}
 
-    auto& outputBlock = context.getOutputBlock();
-    auto numSamples = outputBlock.getNumSamples();
-    auto numChannels = outputBlock.getNumChannels();
+void PowerCoreEngine::processAddingTo(juce::dsp::ProcessContextReplacing<double>& context)
+{
+    processInternal(context.getOutputBlock());
+}
 
-    for (size_t sample = 0; sample < numSamples; ++sample)
+template <typename SampleType>
+void PowerCoreEngine::processInternal(const juce::dsp::AudioBlock<SampleType>& outputBlock)
+{
+    // A disabled core keeps rendering its fade-out and stops once it has reached silence
+    if (!isSounding())
+        return;
+
+    withChannelLayout(outputBlock.getNumChannels(), [&](auto layout)
     {
-        if (isActivating) {
-            activationEnvelope += activationIncrement;
-            if (activationEnvelope >= 1.0f) {
-                activationEnvelope = 1.0f;
-                isActivating = false;
-            }
-        }
-        else if (isDeactivating) {
-            activationEnvelope -= activationIncrement;
-            if (activationEnvelope <= 0.0f) {
-                activationEnvelope = 0.0f;
-                isDeactivating = false;
-            }
-        }
+        renderBlock<SampleType, decltype(layout)::value>(outputBlock);
+    });
+}
 
-        float overallLevel = smoothedHumLevel.getNextValue() * activationEnvelope;
-        if (overallLevel < 0.0001f) { // Reduced threshold slightly
-            for (size_t channel = 0; channel < numChannels; ++channel) {
-                outputBlock.getChannelPointer(channel)[sample] += 0.0f;
-            }
-            // Ensure LFO and oscillators are processed to keep their phase correct even if output is zero.
-            pulsationLFO.processSample(0.0f);
-            fundamentalOsc.processSample(0.0f);
-            int numActiveHarmonics = static_cast<int>(currentHumComplexity * MAX_HARMONICS);
-            for (int i = 0; i < numActiveHarmonics; ++i) {
-                harmonicOscillators[i].processSample(0.0f);
-            }
-            smoothedFilterCutoff.getNextValue(); // Keep smoothed values ticking over
+template <typename SampleType, size_t NumChannels>
+void PowerCoreEngine::renderBlock(const juce::dsp::AudioBlock<SampleType>& outputBlock)
+{
+    // NumChannels is 1 or 2 for the unrolled mono/stereo paths, 0 for any other layout
+    const size_t numChannels = NumChannels > 0 ? NumChannels : outputBlock.getNumChannels();
+    const size_t numSamples = outputBlock.getNumSamples();
+    const size_t maxChunkSize = humLevelGains.size();
 
+    for (size_t chunkStart = 0; chunkStart < numSamples; chunkStart += maxChunkSize)
+    {
+        const size_t chunkSize = juce::jmin(maxChunkSize, numSamples - chunkStart);
+        const int numChunkSamples = static_cast<int>(chunkSize);
+
+        // A core held at silence produces nothing this chunk; just keep the phases moving
+        if (humLevelEnvelope.isSettled() && activationEnvelope.isSettled()
+            && humLevelEnvelope.getCurrentValue() * activationEnvelope.getCurrentValue() < silenceThreshold)
+        {
+            advanceSilently(numChunkSamples);
             continue;
         }
 
-        float coreSound = fundamentalOsc.processSample(0.0f);
+        // Output gain for the whole chunk: hum level times activation
+        humLevelEnvelope.process(humLevelGains.data(), numChunkSamples);
+        activationEnvelope.process(activationGains.data(), numChunkSamples);
+        juce::FloatVectorOperations::multiply(humLevelGains.data(), activationGains.data(), numChunkSamples);
+        const float* gains = humLevelGains.data();
+
+        const int numActiveHarmonics = static_cast<int>(currentHumComplexity * MAX_HARMONICS);
 
-        int numActiveHarmonics = static_cast<int>(currentHumComplexity * MAX_HARMONICS);
-        float harmonicContent = 0.0f;
-        for (int i = 0; i < numActiveHarmonics; ++i)
+        for (size_t i = 0; i < chunkSize; ++i)
         {
-            harmonicContent += harmonicOscillators[i].processSample(0.0f) / (static_cast<float>(i) + 2.0f);
-        }
-        coreSound += harmonicContent * currentHumComplexity;
-        // Apply energyType effect - e.g. tanh for more aggressive, or smoother clipping
-        if (currentEnergyType > 0.5f) {
-            coreSound = std::tanh(coreSound * (1.0f + currentEnergyType)); // More aggressive with higher energy type
-        }
-        else {
-            coreSound = coreSound * (0.5f + currentEnergyType); // Softer for lower energy type
-        }
+            float coreSound = fundamentalOsc.processSample();
 
+            float harmonicContent = 0.0f;
+            for (int h = 0; h < numActiveHarmonics; ++h)
+            {
+                harmonicContent += harmonicOscillators[static_cast<size_t>(h)].processSample() / (static_cast<float>(h) + 2.0f);
+            }
+            coreSound += harmonicContent * currentHumComplexity;
+            // Apply energyType effect - e.g. tanh for more aggressive, or smoother clipping
+            if (currentEnergyType > 0.5f) {
+                coreSound = FastMath::tanh<saturationPrecision>(coreSound * (1.0f + currentEnergyType)); // More aggressive with higher energy type
+            }
+            else {
+                coreSound = coreSound * (0.5f + currentEnergyType); // Softer for lower energy type
+            }
 
-        float lfoSample = (1.0f - currentPulsationDepth) + currentPulsationDepth * ((pulsationLFO.processSample(0.0f) * 0.5f) + 0.5f);
-        coreSound *= lfoSample;
 
-        toneFilter.setCutoffFrequency(smoothedFilterCutoff.getNextValue());
+            float lfoSample = (1.0f - currentPulsationDepth) + currentPulsationDepth * ((pulsationLFO.processSample() * 0.5f) + 0.5f);
+            coreSound *= lfoSample * gains[i];
 
-        // Process filter per channel if it's stateful and meant to be stereo
-        // For now, assume mono processing for the filter before splitting to channels
-        float filteredSound = coreSound; // If mono processing
-        // If stereo filter processing desired, it would be:
-        // float leftSample = toneFilter.processSample(0, coreSound);
-        // float rightSample = toneFilter.processSample(1, coreSound); // Requires filter to be stereo aware or two mono filters
+            // Only a moving cutoff needs new coefficients; otherwise updateParameters() set them
+            if (smoothedFilterCutoff.isSmoothing())
+                toneFilter.setCutoffFrequency(smoothedFilterCutoff.getNextValue());
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
-        {
-            // If filter is processed mono, apply same filtered sound. 
-            // If stereo, apply respective channel's sample.
-            outputBlock.getChannelPointer(channel)[sample] += toneFilter.processSample(static_cast<int>(channel), coreSound); // processSample now takes channel index
+            // The core is a mono source. Every filter channel would see the same input and
+            // produce the same output, so filter once and add the result to all channels.
+            const auto filteredSound = static_cast<SampleType>(toneFilter.processSample(coreSound));
+
+            const size_t sample = chunkStart + i;
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                outputBlock.getChannelPointer(channel)[sample] += filteredSound;
+            }
         }
     }
 }
 
+void PowerCoreEngine::advanceSilently(int numSamples)
+{
+    // Oscillators and the cutoff smoother keep running so the core resumes in phase
+    fundamentalOsc.advance(numSamples);
+    pulsationLFO.advance(numSamples);
+
+    const int numActiveHarmonics = static_cast<int>(currentHumComplexity * MAX_HARMONICS);
+    for (int i = 0; i < numActiveHarmonics; ++i)
+        harmonicOscillators[static_cast<size_t>(i)].advance(numSamples);
+
+    if (smoothedFilterCutoff.isSmoothing())
+    {
+        smoothedFilterCutoff.skip(numSamples);
+        toneFilter.setCutoffFrequency(smoothedFilterCutoff.getCurrentValue());
+    }
+}
+
 void PowerCoreEngine::setEnabled(bool enabled)
 {
     isEnabledFlag = enabled;
     if (!enabled) {
-        // When disabling, ensure a smooth fade or quick ramp down
-        // Trigger deactivation sequence if not already deactivating
-        if (activationEnvelope > 0.0f && !isDeactivating) {
-            isDeactivating = true;
-            isActivating = false; // Ensure it's not trying to activate
-            // Use a faster deactivation time if desired when explicitly disabled
-            float disableTime = 0.1f; // e.g., 100ms to fade out
-            if (currentSampleRate > 0 && disableTime > 0.001f) {
-                activationIncrement = (1.0f / (disableTime * static_cast<float>(currentSampleRate)));
-            }
-            else {
-                activationIncrement = 1.0f; // Fallback to immediate if sample rate is zero
-            }
-        }
-        // It might be better to just let the current activation/deactivation play out
-        // or force activationEnvelope to 0 after a short ramp.
-        // Forcing target for smoothedHumLevel to 0.
-        smoothedHumLevel.setTargetValue(0.0f);
-
+        // When disabling, fade the core out quickly from wherever it is
+        activationEnvelope.rampTo(0.0f, disableFadeSeconds, BlockEnvelope::Shape::linear);
     }
-    else {
-        // If enabling and it was fully off, maybe trigger activation if trigger is set
-        // This depends on desired logic. For now, enabling just allows processing.
-        // The activationTrigger parameter should handle starting the sound.
+    else if (currentActivationTrigger) {
+        // Power up again from wherever the fade-out left the core
+        activationEnvelope.rampTo(1.0f, currentActivationTime, BlockEnvelope::Shape::sCurve);
     }
 }
 
@@ -234,6 +235,11 @@ bool PowerCoreEngine::getEnabled() const
     return isEnabledFlag;
 }
 
+bool PowerCoreEngine::isSounding() const
+{
+    return isEnabledFlag || !activationEnvelope.isSettled() || activationEnvelope.getCurrentValue() > 0.0f;
+}
+
 double PowerCoreEngine::getCPUUsage() const
 {
     return 0.0;
@@ -241,9 +247,6 @@ double PowerCoreEngine::getCPUUsage() const
 
 size_t PowerCoreEngine::getMemoryUsage() const
 {
-    return sizeof(*this) +
-        sizeof(juce::dsp::Oscillator<float>) * (1 + 1 + MAX_HARMONICS) +
-        sizeof(juce::dsp::StateVariableTPTFilter<float>) +
-        sizeof(juce::dsp::Gain<float>);
+    return sizeof(*this) + (humLevelGains.capacity() + activationGains.capacity()) * sizeof(float);
 }
 
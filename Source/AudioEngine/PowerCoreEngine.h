@@ -1,9 +1,12 @@
 #pragma once
 
 #include "../Source/AudioEngine/SoundEngineBase.h"
+#include "../Source/AudioEngine/FastDSP.h"
+#include "../Source/AudioEngine/BlockEnvelope.h"
 #include "../Source/Parameters/Parameters.h" // For EngineParameterSet
 #include <juce_dsp/juce_dsp.h>
-#include <vector> // For std::vector of oscillators
+#include <array>
+#include <vector>
 
 class PowerCoreEngine : public SoundEngineBase
 {
@@ -14,23 +17,47 @@ public:
     // --- SoundEngineBase overrides ---
     void prepare(const juce::dsp::ProcessSpec& spec) override;
     void reset() override;
+    void resetTo(const EngineParameterSet& allParams) override;
     void processAddingTo(juce::dsp::ProcessContextReplacing<float>& context) override;
+    void processAddingTo(juce::dsp::ProcessContextReplacing<double>& context) override;
     void updateParameters(const EngineParameterSet& allParams) override;
     void setEnabled(bool enabled) override;
+    bool isSounding() const override;
     bool getEnabled() const override;
     double getCPUUsage() const override; // Placeholder
     size_t getMemoryUsage() const override; // Placeholder
+    double getBandwidth() const override { return bandwidth; }
 
 private:
+    template <typename SampleType>
+    void processInternal(const juce::dsp::AudioBlock<SampleType>& outputBlock);
+
+    template <typename SampleType, size_t NumChannels>
+    void renderBlock(const juce::dsp::AudioBlock<SampleType>& outputBlock);
+
+    void advanceSilently(int numSamples);
+
+    static constexpr int MAX_HARMONICS = 5; // Example: up to 5 harmonics
+
     // DSP Components for PowerCoreEngine [cite: 10]
-    std::vector<juce::dsp::Oscillator<float>> harmonicOscillators;
-    juce::dsp::Oscillator<float> fundamentalOsc;
-    juce::dsp::Oscillator<float> pulsationLFO; // For amplitude modulation [cite: 10]
-    juce::dsp::StateVariableTPTFilter<float> toneFilter; // For tonal shaping and filter sweeps [cite: 10]
+    // Audible oscillators and the saturator use accurate kernels; the LFO and the
+    // per-sample cutoff prewarp only need the fast ones.
+    static constexpr auto oscillatorPrecision = FastMath::Precision::accurate;
+    static constexpr auto saturationPrecision = FastMath::Precision::accurate;
+    std::array<FastSineOscillator<oscillatorPrecision>, MAX_HARMONICS> harmonicOscillators;
+    FastSineOscillator<oscillatorPrecision> fundamentalOsc;
+    FastSineOscillator<FastMath::Precision::fast> pulsationLFO; // For amplitude modulation [cite: 10]
+    FastTPTLowpass<FastMath::Precision::fast> toneFilter; // For tonal shaping and filter sweeps [cite: 10]
     juce::dsp::Gain<float> humGain;
 
-    // Smoothed parameters for envelopes/transitions
-    juce::LinearSmoothedValue<float> smoothedHumLevel;
+    // Gain envelopes, rendered a block at a time into the buffers below.
+    // The output gain is hum level times activation.
+    BlockEnvelope humLevelEnvelope;
+    BlockEnvelope activationEnvelope; // Power up/down over activationTime [cite: 10]
+    std::vector<float> humLevelGains;
+    std::vector<float> activationGains;
+
+    // Smoothed parameters for transitions
     juce::LinearSmoothedValue<float> smoothedFilterCutoff;
 
     // Cached parameters from PowerCoreParams
@@ -45,12 +72,13 @@ private:
     float currentFilterCutoff = 5000.0f; // For filter sweep capabilities
     float currentFilterResonance = 1.0f;
 
+    // The tone filter reaches 10 kHz, peaking there at high resonance, and follows
+    // the saturation, so harmonics pass up to its cutoff. The factor is chosen once
+    // per prepare, so this covers the whole cutoff range with some headroom: the core
+    // runs at full rate up to 88.2 kHz and at no less than 44.1-48 kHz above that.
+    static constexpr double bandwidth = 12000.0;
 
-    // Parameters for activation envelope (conceptual)
-    bool isActivating = false;
-    bool isDeactivating = false;
-    float activationEnvelope = 0.0f; // Current state of activation (0 to 1)
-    float activationIncrement = 0.0f; // Calculated based on activationTime
-
-    static constexpr int MAX_HARMONICS = 5; // Example: up to 5 harmonics
+    static constexpr float humLevelRampSeconds = 0.02f;
+    static constexpr float disableFadeSeconds = 0.1f; // Fade out when disabled
+    static constexpr float silenceThreshold = 0.0001f;
 };
\ No newline at end of file
@@ -0,0 +1,531 @@
+// Source/AudioEngine/SamplePlaybackEngine.cpp
+#include "../Source/AudioEngine/SamplePlaybackEngine.h"
+#include <cmath>
+#include <cstring>
+
+//==============================================================================
+class SamplePlaybackEngine::FrameSource
+{
+public:
+    virtual ~FrameSource() = default;
+
+    virtual int64_t getNumFrames() const noexcept = 0;
+    virtual double getSampleRate() const noexcept = 0;
+
+    /** @brief Reads frames [startFrame, startFrame + numFrames) into both channels of 'destination'.
+        Mono sources are copied to both. The range is always inside the file.
+    */
+    virtual void read(juce::AudioBuffer<float>& destination, int destinationStart, int64_t startFrame, int numFrames) = 0;
+};
+
+namespace
+{
+    constexpr int waitMilliseconds = 5; // Also how late a reset() can be picked up
+    constexpr int stopTimeoutMilliseconds = 2000;
+    constexpr int maxOfflineWaits = 1000; // Milliseconds per block
+
+    class WavFrameSource final : public SamplePlaybackEngine::FrameSource
+    {
+    public:
+        explicit WavFrameSource(std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader)
+            : reader(std::move(mappedReader))
+        {
+        }
+
+        int64_t getNumFrames() const noexcept override { return reader->lengthInSamples; }
+        double getSampleRate() const noexcept override { return reader->sampleRate; }
+
+        void read(juce::AudioBuffer<float>& destination, int destinationStart, int64_t startFrame, int numFrames) override
+        {
+            reader->read(&destination, destinationStart, numFrames, startFrame, true, true);
+        }
+
+    private:
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader;
+    };
+
+    class RawFrameSource final : public SamplePlaybackEngine::FrameSource
+    {
+    public:
+        RawFrameSource(std::unique_ptr<juce::MemoryMappedFile> mappedFile, const SamplePlaybackEngine::RawFormat& rawFormat)
+            : file(std::move(mappedFile)),
+              format(rawFormat),
+              bytesPerSample(rawFormat.bitsPerSample / 8),
+              bytesPerFrame(bytesPerSample * rawFormat.numChannels),
+              numFrames(static_cast<int64_t>(file->getSize()) / bytesPerFrame)
+        {
+        }
+
+        int64_t getNumFrames() const noexcept override { return numFrames; }
+        double getSampleRate() const noexcept override { return format.sampleRate; }
+
+        void read(juce::AudioBuffer<float>& destination, int destinationStart, int64_t startFrame, int numFrames) override
+        {
+            const auto* frame = static_cast<const char*>(file->getData()) + startFrame * bytesPerFrame;
+            const int rightOffset = format.numChannels > 1 ? bytesPerSample : 0;
+            auto* left = destination.getWritePointer(0, destinationStart);
+            auto* right = destination.getWritePointer(1, destinationStart);
+
+            for (int i = 0; i < numFrames; ++i, frame += bytesPerFrame)
+            {
+                left[i] = readSample(frame);
+                right[i] = readSample(frame + rightOffset);
+            }
+        }
+
+    private:
+        float readSample(const char* data) const noexcept
+        {
+            if (bytesPerSample == 2)
+                return static_cast<float>(static_cast<int16_t>(juce::ByteOrder::littleEndianShort(data))) * (1.0f / 32768.0f);
+
+            const auto bits = juce::ByteOrder::littleEndianInt(data);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        std::unique_ptr<juce::MemoryMappedFile> file;
+        SamplePlaybackEngine::RawFormat format;
+        int bytesPerSample;
+        int bytesPerFrame;
+        int64_t numFrames;
+    };
+
+    std::unique_ptr<SamplePlaybackEngine::FrameSource> openFrameSource(const juce::File& file, const SamplePlaybackEngine::RawFormat& rawFormat)
+    {
+        if (file.hasFileExtension("wav"))
+        {
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader(juce::WavAudioFormat().createMemoryMappedReader(file));
+            if (reader == nullptr || !reader->mapEntireFile() || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+                return nullptr;
+
+            return std::make_unique<WavFrameSource>(std::move(reader));
+        }
+
+        const bool validFormat = rawFormat.sampleRate > 0.0 && rawFormat.numChannels > 0
+                              && (rawFormat.bitsPerSample == 16 || rawFormat.bitsPerSample == 32);
+        if (!validFormat)
+            return nullptr;
+
+        auto mappedFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+        const auto bytesPerFrame = static_cast<size_t>(rawFormat.numChannels * rawFormat.bitsPerSample / 8);
+        if (mappedFile->getData() == nullptr || mappedFile->getSize() < bytesPerFrame)
+            return nullptr;
+
+        return std::make_unique<RawFrameSource>(std::move(mappedFile), rawFormat);
+    }
+}
+
+//==============================================================================
+SamplePrefetchThread::SamplePrefetchThread()
+    : juce::Thread("Foley prefetch")
+{
+}
+
+SamplePrefetchThread::~SamplePrefetchThread()
+{
+    jassert(engines.isEmpty()); // Engines detach when they are destroyed or move elsewhere
+    stopThread(stopTimeoutMilliseconds);
+}
+
+void SamplePrefetchThread::attach(SamplePlaybackEngine& engine)
+{
+    {
+        const juce::ScopedLock scopedLock(lock);
+        engines.addIfNotAlreadyThere(&engine);
+    }
+    update();
+}
+
+void SamplePrefetchThread::detach(SamplePlaybackEngine& engine)
+{
+    {
+        // Waits for the thread to finish with this engine, if it is busy with it
+        const juce::ScopedLock scopedLock(lock);
+        engines.removeFirstMatchingValue(&engine);
+    }
+    update();
+}
+
+void SamplePrefetchThread::update()
+{
+    bool needed = false;
+    {
+        const juce::ScopedLock scopedLock(lock);
+        for (auto* engine : engines)
+            needed = needed || engine->needsPrefetch();
+    }
+
+    if (!needed)
+        stopThread(stopTimeoutMilliseconds);
+    else if (!isThreadRunning())
+        startThread();
+    else
+        notify();
+}
+
+void SamplePrefetchThread::run()
+{
+    while (!threadShouldExit())
+    {
+        bool wroteFrames = false;
+        {
+            const juce::ScopedLock scopedLock(lock);
+            for (auto* engine : engines)
+                wroteFrames = engine->prefetchStep() || wroteFrames;
+        }
+
+        // Rings are full or nothing streams: poll for space and reset() requests
+        if (!wroteFrames)
+            wait(waitMilliseconds);
+    }
+}
+
+//==============================================================================
+SamplePlaybackEngine::SamplePlaybackEngine()
+{
+    isEnabledFlag = true;
+    ringBuffer.setSize(2, ringSize);
+}
+
+SamplePlaybackEngine::~SamplePlaybackEngine()
+{
+    if (prefetchThread != nullptr)
+        prefetchThread->detach(*this);
+}
+
+void SamplePlaybackEngine::setPrefetchThread(SamplePrefetchThread* thread)
+{
+    if (prefetchThread != nullptr)
+        prefetchThread->detach(*this);
+
+    if (thread == nullptr)
+    {
+        if (privatePrefetchThread == nullptr)
+            privatePrefetchThread = std::make_unique<SamplePrefetchThread>();
+        thread = privatePrefetchThread.get();
+    }
+    else
+    {
+        privatePrefetchThread.reset(); // Stopped: nothing is attached to it any more
+    }
+
+    prefetchThread = thread;
+    prefetchThread->attach(*this);
+}
+
+SamplePrefetchThread& SamplePlaybackEngine::getPrefetchThread()
+{
+    if (prefetchThread == nullptr)
+        setPrefetchThread(nullptr);
+    return *prefetchThread;
+}
+
+bool SamplePlaybackEngine::needsPrefetch() const
+{
+    return prepared && getFile() != juce::File();
+}
+
+void SamplePlaybackEngine::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    auto& thread = getPrefetchThread();
+
+    {
+        // The ring holds frames at the old rate; the lock keeps the thread out while it is emptied
+        const juce::ScopedLock threadLock(thread.lock);
+
+        currentSampleRate = spec.sampleRate;
+        currentBlockSize = static_cast<int>(spec.maximumBlockSize);
+
+        ring.reset();
+        ringBuffer.clear();
+        framesWritten = 0;
+        framesRead = 0;
+        staleFrameEnd.store(0);
+        underruns.store(0);
+
+        reset();
+        prepared = true;
+    }
+
+    thread.update();
+}
+
+void SamplePlaybackEngine::reset()
+{
+    // Called from the audio thread too, so it only raises a flag; the prefetch
+    // thread polls it and does the work
+    restartRequested.store(true, std::memory_order_release);
+}
+
+void SamplePlaybackEngine::updateParameters(const EngineParameterSet& allParams)
+{
+    currentLevel = allParams.foley.level;
+}
+
+//==============================================================================
+std::shared_ptr<SamplePlaybackEngine::FrameSource> SamplePlaybackEngine::openFile(const juce::File& file, const RawFormat& rawFormat)
+{
+    return openFrameSource(file, rawFormat);
+}
+
+void SamplePlaybackEngine::setSource(std::shared_ptr<FrameSource> newSource, const juce::File& file)
+{
+    jassert(newSource != nullptr);
+
+    {
+        const juce::ScopedLock lock(sourceLock);
+        nextSource = std::move(newSource);
+        sourceChanged = true;
+        currentFile = file;
+    }
+
+    getPrefetchThread().update();
+}
+
+bool SamplePlaybackEngine::setFile(const juce::File& file, const RawFormat& rawFormat)
+{
+    auto newSource = openFile(file, rawFormat);
+    if (newSource == nullptr)
+        return false;
+
+    setSource(std::move(newSource), file);
+    return true;
+}
+
+void SamplePlaybackEngine::clearFile()
+{
+    auto& thread = getPrefetchThread();
+
+    {
+        // The thread's own state is changed with the thread kept out of this engine
+        const juce::ScopedLock threadLock(thread.lock);
+
+        {
+            const juce::ScopedLock lock(sourceLock);
+            nextSource.reset();
+            sourceChanged = false;
+            currentFile = juce::File();
+        }
+
+        source.reset();
+        streaming.store(false, std::memory_order_release);
+        readPosition = 0.0;
+        requestFlush();
+    }
+
+    // Stops the thread if no other engine streams
+    thread.update();
+}
+
+juce::File SamplePlaybackEngine::getFile() const
+{
+    const juce::ScopedLock lock(sourceLock);
+    return currentFile;
+}
+
+//==============================================================================
+bool SamplePlaybackEngine::prefetchStep()
+{
+    if (!prepared)
+        return false;
+
+    takeNewSource();
+
+    if (restartRequested.exchange(false, std::memory_order_acquire))
+    {
+        readPosition = 0.0;
+        requestFlush();
+    }
+
+    if (source == nullptr || ring.getFreeSpace() < prefetchBlockSize)
+        return false;
+
+    prefetch(prefetchBlockSize);
+    return true;
+}
+
+void SamplePlaybackEngine::takeNewSource()
+{
+    std::shared_ptr<FrameSource> previousSource;
+
+    {
+        const juce::ScopedLock lock(sourceLock);
+        if (!sourceChanged)
+            return;
+
+        previousSource = std::move(source);
+        source = std::move(nextSource);
+        sourceChanged = false;
+    }
+
+    // The old mapping is released here, outside the lock, unless another engine still streams it
+    streaming.store(source != nullptr, std::memory_order_release);
+    readPosition = 0.0;
+    requestFlush();
+}
+
+void SamplePlaybackEngine::requestFlush() noexcept
+{
+    // Everything written so far is stale. The audio thread skips it when it next
+    // reads, so new frames can follow straight away.
+    staleFrameEnd.store(framesWritten, std::memory_order_release);
+}
+
+void SamplePlaybackEngine::prefetch(int numFrames)
+{
+    // Linear interpolation from the file rate to the device rate
+    const double ratio = source->getSampleRate() / currentSampleRate;
+    const auto firstFrame = static_cast<int64_t>(readPosition);
+    const double offset = readPosition - static_cast<double>(firstFrame);
+    const int framesNeeded = static_cast<int>(offset + ratio * static_cast<double>(numFrames - 1)) + 2;
+
+    if (sourceScratch.getNumSamples() < framesNeeded)
+        sourceScratch.setSize(2, framesNeeded, false, false, true);
+
+    // All page faults happen here
+    readLooped(firstFrame, framesNeeded);
+
+    int start1, size1, start2, size2;
+    ring.prepareToWrite(numFrames, start1, size1, start2, size2);
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const float* input = sourceScratch.getReadPointer(channel);
+        int written = 0;
+
+        for (const auto& [start, size] : { std::make_pair(start1, size1), std::make_pair(start2, size2) })
+        {
+            float* output = ringBuffer.getWritePointer(channel, start);
+            for (int i = 0; i < size; ++i)
+            {
+                const double position = offset + ratio * static_cast<double>(written + i);
+                const int index = static_cast<int>(position);
+                const float fraction = static_cast<float>(position - static_cast<double>(index));
+                output[i] = input[index] + fraction * (input[index + 1] - input[index]);
+            }
+            written += size;
+        }
+    }
+
+    ring.finishedWrite(size1 + size2);
+    framesWritten += size1 + size2;
+
+    readPosition = std::fmod(readPosition + ratio * static_cast<double>(size1 + size2),
+                             static_cast<double>(source->getNumFrames()));
+}
+
+void SamplePlaybackEngine::readLooped(int64_t startFrame, int numFrames)
+{
+    const int64_t fileFrames = source->getNumFrames();
+    int done = 0;
+
+    while (done < numFrames)
+    {
+        const auto position = (startFrame + done) % fileFrames;
+        const int count = static_cast<int>(juce::jmin(static_cast<int64_t>(numFrames - done), fileFrames - position));
+        source->read(sourceScratch, done, position, count);
+        done += count;
+    }
+}
+
+//==============================================================================
+void SamplePlaybackEngine::processAddingTo(juce::dsp::ProcessContextReplacing<float>& context)
+{
+    processInternal(context.getOutputBlock());
+}
+
+void SamplePlaybackEngine::processAddingTo(juce::dsp::ProcessContextReplacing<double>& context)
+{
+    processInternal(context.getOutputBlock());
+}
+
+template <typename SampleType>
+void SamplePlaybackEngine::processInternal(const juce::dsp::AudioBlock<SampleType>& outputBlock)
+{
+    // Frames of an old source or position are skipped, even while muted; the
+    // staleFrameEnd load orders them before the ring's count
+    const auto staleEnd = staleFrameEnd.load(std::memory_order_acquire);
+    if (framesRead < staleEnd)
+    {
+        const auto numStale = static_cast<int>(juce::jmin(staleEnd - framesRead, static_cast<int64_t>(ring.getNumReady())));
+        ring.finishedRead(numStale);
+        framesRead += numStale;
+    }
+
+    // While muted the ring is left alone, so playback resumes where it stopped
+    if (!isEnabledFlag || currentLevel < 0.001f || !streaming.load(std::memory_order_acquire))
+        return;
+
+    const int numSamples = static_cast<int>(outputBlock.getNumSamples());
+
+    // Rendering faster than realtime can outrun the prefetch thread
+    if (nonRealtime.load(std::memory_order_relaxed))
+    {
+        for (int waits = 0; ring.getNumReady() < numSamples && waits < maxOfflineWaits; ++waits)
+        {
+            prefetchThread->wake();
+            juce::Thread::sleep(1);
+        }
+    }
+
+    const int numFrames = juce::jmin(numSamples, ring.getNumReady());
+    if (numFrames < numSamples)
+        underruns.fetch_add(1, std::memory_order_relaxed); // The rest of the block stays silent
+
+    int start1, size1, start2, size2;
+    ring.prepareToRead(numFrames, start1, size1, start2, size2);
+    addFromRing(outputBlock, 0, start1, size1);
+    addFromRing(outputBlock, size1, start2, size2);
+    ring.finishedRead(size1 + size2);
+    framesRead += size1 + size2;
+}
+
+template <typename SampleType>
+void SamplePlaybackEngine::addFromRing(const juce::dsp::AudioBlock<SampleType>& outputBlock,
+                                       int outputOffset, int ringStart, int numFrames) noexcept
+{
+    const size_t numChannels = outputBlock.getNumChannels();
+    const float* left = ringBuffer.getReadPointer(0, ringStart);
+    const float* right = ringBuffer.getReadPointer(1, ringStart);
+
+    if (numChannels == 1)
+    {
+        const float gain = currentLevel * 0.5f;
+        auto* output = outputBlock.getChannelPointer(0) + outputOffset;
+        for (int i = 0; i < numFrames; ++i)
+            output[i] += static_cast<SampleType>((left[i] + right[i]) * gain);
+        return;
+    }
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        const float* input = (channel % 2 == 0) ? left : right;
+        auto* output = outputBlock.getChannelPointer(channel) + outputOffset;
+        for (int i = 0; i < numFrames; ++i)
+            output[i] += static_cast<SampleType>(input[i] * currentLevel);
+    }
+}
+
+//==============================================================================
+void SamplePlaybackEngine::setEnabled(bool enabled)
+{
+    isEnabledFlag = enabled;
+}
+
+bool SamplePlaybackEngine::getEnabled() const
+{
+    return isEnabledFlag;
+}
+
+double SamplePlaybackEngine::getCPUUsage() const
+{
+    return 0.0;
+}
+
+size_t SamplePlaybackEngine::getMemoryUsage() const
+{
+    // The mapping itself is page cache, not counted here
+    return sizeof(*this) + static_cast<size_t>(ringSize) * 2 * sizeof(float);
+}
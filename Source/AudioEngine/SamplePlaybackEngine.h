@@ -0,0 +1,185 @@
+// Source/AudioEngine/SamplePlaybackEngine.h
+#pragma once
+
+#include "../Source/AudioEngine/SoundEngineBase.h"
+#include "../Parameters/Parameters.h" // For EngineParameterSet (needed by updateParameters)
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_dsp/juce_dsp.h>
+#include <atomic>
+#include <memory>
+
+class SamplePlaybackEngine;
+
+//==============================================================================
+/*
+    Prefetches for a set of SamplePlaybackEngines, one after the other.
+
+    A processor shares one between the foley engines of both its slots, so an
+    instance has one prefetch thread however many foley engines it runs. An
+    engine that is not given one makes a private one. The thread runs while
+    an attached engine is prepared and has a file, and is stopped otherwise.
+*/
+class SamplePrefetchThread : private juce::Thread
+{
+public:
+    SamplePrefetchThread();
+    ~SamplePrefetchThread() override;
+
+private:
+    friend class SamplePlaybackEngine;
+
+    void attach(SamplePlaybackEngine& engine);
+    void detach(SamplePlaybackEngine& engine);
+
+    /** @brief Starts or stops the thread to match the attached engines, and wakes it. Not the audio thread. */
+    void update();
+    void wake() noexcept { notify(); }
+
+    void run() override;
+
+    // Guards 'engines'. Held while one of them is prefetched for, so taking it
+    // keeps the thread out of every engine.
+    juce::CriticalSection lock;
+    juce::Array<SamplePlaybackEngine*> engines;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SamplePrefetchThread)
+};
+
+//==============================================================================
+/*
+    Streams a recorded foley loop from disk under the synthesised engines.
+
+    The file (WAV, or headerless raw PCM) is memory-mapped, not loaded, so a
+    library of any size costs address space rather than RAM. Mapped pages are
+    shared by every instance that plays the same file. A SamplePrefetchThread
+    reads ahead from the mapping, resamples to the device rate, and writes
+    stereo frames into a lock-free ring. Page faults, and any disk access they
+    cause, only happen on that thread: processAddingTo() copies from the ring
+    and never touches the file.
+
+    If the ring runs dry, the missing samples are silent and counted in
+    getUnderrunCount(). While the engine is muted the ring is not drained, so
+    playback pauses where it is. The file loops.
+
+    setFile() and setSource() may be called from the message thread while audio runs. The new
+    source is handed to the prefetch thread, which marks the frames queued so
+    far as stale and goes on writing; the audio thread skips the stale frames
+    the next time it reads. Neither side waits for the other, so a muted
+    engine holds up nothing.
+
+    The audio thread never signals the prefetch thread: reset() raises a flag
+    that the thread polls between prefetch blocks.
+*/
+class SamplePlaybackEngine : public SoundEngineBase
+{
+public:
+    // Layout of headerless files; WAV files describe themselves
+    struct RawFormat
+    {
+        double sampleRate = 48000.0;
+        int numChannels = 2;
+        int bitsPerSample = 32; // 32: float, 16: signed integer; little-endian, interleaved
+    };
+
+    static constexpr int ringSize = 1 << 15;     // Frames, about 0.7 s at 48 kHz
+    static constexpr int prefetchBlockSize = 2048;
+
+    SamplePlaybackEngine();
+    ~SamplePlaybackEngine() override;
+
+    // --- SoundEngineBase overrides ---
+    void prepare(const juce::dsp::ProcessSpec& spec) override;
+    void reset() override; // Restarts from the beginning of the file
+    void processAddingTo(juce::dsp::ProcessContextReplacing<float>& context) override;
+    void processAddingTo(juce::dsp::ProcessContextReplacing<double>& context) override;
+    void updateParameters(const EngineParameterSet& allParams) override;
+    void setEnabled(bool enabled) override;
+    bool getEnabled() const override;
+    double getCPUUsage() const override;
+    size_t getMemoryUsage() const override;
+
+    // --- Message thread ---
+    /** @brief Prefetches on 'thread', shared with other engines, from now on; nullptr for a
+        private thread. 'thread' must outlive this engine.
+    */
+    void setPrefetchThread(SamplePrefetchThread* thread);
+
+    // A mapped file. read() keeps no state of its own, so one source can be streamed
+    // by several engines at once.
+    class FrameSource;
+
+    /** @brief Maps 'file'. Files without a .wav extension are read as raw PCM in 'rawFormat'.
+        Returns nullptr if it cannot be mapped.
+    */
+    static std::shared_ptr<FrameSource> openFile(const juce::File& file, const RawFormat& rawFormat = RawFormat());
+
+    /** @brief Streams 'newSource', opened from 'file' by openFile(). Cannot fail, so a caller
+        that validated the file once can hand the same source to several engines.
+    */
+    void setSource(std::shared_ptr<FrameSource> newSource, const juce::File& file);
+
+    /** @brief Maps 'file' and streams it. Returns false, and keeps the current file, if it
+        cannot be mapped.
+    */
+    bool setFile(const juce::File& file, const RawFormat& rawFormat);
+    bool setFile(const juce::File& file) { return setFile(file, RawFormat()); }
+    void clearFile();
+    juce::File getFile() const;
+
+    /** @brief Offline rendering: processAddingTo() waits for the prefetch thread (up to
+        about a second per block) instead of dropping frames. Any thread.
+    */
+    void setNonRealtime(bool isNonRealtime) noexcept { nonRealtime.store(isNonRealtime); }
+
+    /** @brief Blocks that ran short of prefetched frames since prepare(). */
+    int getUnderrunCount() const noexcept { return underruns.load(std::memory_order_relaxed); }
+
+private:
+    friend class SamplePrefetchThread;
+
+    SamplePrefetchThread& getPrefetchThread();
+    bool needsPrefetch() const; // Prepared and has a file; called with the prefetch thread's lock held
+
+    // Prefetch thread, with its lock held
+    bool prefetchStep(); // True if it wrote frames
+    void takeNewSource();
+    void requestFlush() noexcept;
+    void prefetch(int numFrames);
+    void readLooped(int64_t startFrame, int numFrames);
+
+    template <typename SampleType>
+    void processInternal(const juce::dsp::AudioBlock<SampleType>& outputBlock);
+
+    template <typename SampleType>
+    void addFromRing(const juce::dsp::AudioBlock<SampleType>& outputBlock, int outputOffset, int ringStart, int numFrames) noexcept;
+
+    // Message thread <-> prefetch thread only; the audio thread never takes it
+    juce::CriticalSection sourceLock;
+    std::shared_ptr<FrameSource> nextSource;
+    bool sourceChanged = false;
+    juce::File currentFile;
+    bool prepared = false; // Set under the prefetch thread's lock
+
+    SamplePrefetchThread* prefetchThread = nullptr;
+    std::unique_ptr<SamplePrefetchThread> privatePrefetchThread; // Only when none is shared
+
+    // Prefetch thread
+    std::shared_ptr<FrameSource> source;
+    double readPosition = 0.0; // In source frames
+    juce::AudioBuffer<float> sourceScratch; // Source frames for one prefetch block, grown as needed
+
+    // Ring, written by the prefetch thread and read by the audio thread
+    juce::AbstractFifo ring{ ringSize };
+    juce::AudioBuffer<float> ringBuffer;
+    int64_t framesWritten = 0;                   // Prefetch thread: frames written since prepare()
+    int64_t framesRead = 0;                      // Audio thread: frames read or skipped since prepare()
+    std::atomic<int64_t> staleFrameEnd{ 0 };     // Frames written before this count belong to an old source or position
+    std::atomic<bool> restartRequested{ false }; // Set by reset(), polled by the prefetch thread
+    std::atomic<bool> streaming{ false };
+    std::atomic<bool> nonRealtime{ false };
+    std::atomic<int> underruns{ 0 };
+
+    float currentLevel = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SamplePlaybackEngine)
+};
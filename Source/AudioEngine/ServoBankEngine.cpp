@@ -0,0 +1,261 @@
+// Source/AudioEngine/ServoBankEngine.cpp
+#include "../Source/AudioEngine/ServoBankEngine.h"
+#include <cmath>
+
+const juce::Identifier ServoBankEngine::stateType{ "ServoBank" };
+
+namespace
+{
+    const juce::Identifier servoType{ "Servo" };
+    const juce::Identifier levelProperty{ "level" };
+    const juce::Identifier pitchRatioProperty{ "pitchRatio" };
+    const juce::Identifier modDepthProperty{ "modDepth" };
+    const juce::Identifier modRateRatioProperty{ "modRateRatio" };
+
+    // Default spread: servo 'i' sits at a different point of the same rig, so
+    // pitches fan out over about an octave and the LFOs drift apart slowly.
+    ServoBankEngine::ServoSettings defaultSettings(int index) noexcept
+    {
+        ServoBankEngine::ServoSettings settings;
+        settings.pitchRatio = std::pow(2.0f, static_cast<float>(index) / static_cast<float>(ServoBankEngine::maxServos));
+        settings.modRateRatio = 0.8f + 0.03f * static_cast<float>(index);
+        settings.modDepth = (index % 2 == 0) ? 1.0f : 0.7f;
+        return settings;
+    }
+
+    // Back into [-pi, pi) from [-pi, 3 pi). Truncating is flooring here, as the
+    // shifted phase is never negative; unlike a compare or std::floor, the
+    // conversion vectorises without -fno-trapping-math.
+    inline float wrapPhase(float phase) noexcept
+    {
+        const auto turns = static_cast<int32_t>((phase + FastMath::pi) * FastMath::inverseTwoPi);
+        return phase - FastMath::twoPi * static_cast<float>(turns);
+    }
+}
+
+//==============================================================================
+ServoBankEngine::BankSettings::BankSettings()
+{
+    for (int i = 0; i < maxServos; ++i)
+        servos[static_cast<size_t>(i)] = defaultSettings(i);
+}
+
+juce::ValueTree ServoBankEngine::BankSettings::toValueTree() const
+{
+    juce::ValueTree tree(stateType);
+
+    for (const auto& servo : servos)
+    {
+        juce::ValueTree servoTree(servoType);
+        servoTree.setProperty(levelProperty, servo.level, nullptr);
+        servoTree.setProperty(pitchRatioProperty, servo.pitchRatio, nullptr);
+        servoTree.setProperty(modDepthProperty, servo.modDepth, nullptr);
+        servoTree.setProperty(modRateRatioProperty, servo.modRateRatio, nullptr);
+        tree.appendChild(servoTree, nullptr);
+    }
+
+    return tree;
+}
+
+ServoBankEngine::BankSettings ServoBankEngine::BankSettings::fromValueTree(const juce::ValueTree& tree)
+{
+    BankSettings settings;
+    if (!tree.hasType(stateType))
+        return settings;
+
+    // Servos missing from the tree keep their default
+    size_t index = 0;
+    for (const auto& servoTree : tree)
+    {
+        if (!servoTree.hasType(servoType) || index >= settings.servos.size())
+            continue;
+
+        auto& servo = settings.servos[index++];
+        servo.level = servoTree.getProperty(levelProperty, servo.level);
+        servo.pitchRatio = servoTree.getProperty(pitchRatioProperty, servo.pitchRatio);
+        servo.modDepth = servoTree.getProperty(modDepthProperty, servo.modDepth);
+        servo.modRateRatio = servoTree.getProperty(modRateRatioProperty, servo.modRateRatio);
+    }
+
+    return settings;
+}
+
+//==============================================================================
+ServoBankEngine::ServoBankEngine()
+{
+    isEnabledFlag = true;
+    setBankSettings(BankSettings());
+}
+
+void ServoBankEngine::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    currentSampleRate = spec.sampleRate;
+    currentBlockSize = static_cast<int>(spec.maximumBlockSize);
+
+    const float radiansPerHz = FastMath::twoPi / static_cast<float>(currentSampleRate);
+    minIncrement = 20.0f * radiansPerHz;
+    maxIncrement = juce::jmin(20000.0f * radiansPerHz, FastMath::pi * 0.999f);
+
+    reset();
+}
+
+void ServoBankEngine::reset()
+{
+    phases.fill(0.0f);
+
+    // Start the LFOs apart so the servos do not wobble in unison
+    for (size_t i = 0; i < lfoPhases.size(); ++i)
+        lfoPhases[i] = FastMath::twoPi * static_cast<float>(i) / static_cast<float>(maxServos) - FastMath::pi;
+}
+
+void ServoBankEngine::setServo(int index, const ServoSettings& settings) noexcept
+{
+    if (index < 0 || index >= maxServos)
+        return;
+
+    const auto i = static_cast<size_t>(index);
+    settingLevels[i].store(settings.level);
+    settingPitchRatios[i].store(settings.pitchRatio);
+    settingModDepths[i].store(settings.modDepth);
+    settingModRateRatios[i].store(settings.modRateRatio);
+}
+
+void ServoBankEngine::setBankSettings(const BankSettings& settings) noexcept
+{
+    for (int i = 0; i < maxServos; ++i)
+        setServo(i, settings.servos[static_cast<size_t>(i)]);
+}
+
+void ServoBankEngine::updateParameters(const EngineParameterSet& allParams)
+{
+    const int count = juce::jlimit(0, maxServos, allParams.servo.bankSize);
+    numActiveLanes = (count + laneGroup - 1) / laneGroup * laneGroup;
+
+    // Keep the sum at the level of a single servo as servos are added
+    const float levelScale = count > 0 ? allParams.servo.level / std::sqrt(static_cast<float>(count)) : 0.0f;
+    const float radiansPerHz = FastMath::twoPi / static_cast<float>(currentSampleRate);
+
+    for (int lane = 0; lane < numActiveLanes; ++lane)
+    {
+        const auto i = static_cast<size_t>(lane);
+        if (lane >= count)
+        {
+            // Padding lanes run silently to the end of their group
+            levels[i] = 0.0f;
+            increments[i] = lfoIncrements[i] = modDepths[i] = 0.0f;
+            continue;
+        }
+
+        levels[i] = settingLevels[i].load(std::memory_order_relaxed) * levelScale;
+        increments[i] = allParams.servo.pitch * settingPitchRatios[i].load(std::memory_order_relaxed) * radiansPerHz;
+        lfoIncrements[i] = juce::jlimit(0.0f, FastMath::pi * 0.999f,
+                                        allParams.servo.modRate * settingModRateRatios[i].load(std::memory_order_relaxed) * radiansPerHz);
+        modDepths[i] = allParams.servo.modDepth * settingModDepths[i].load(std::memory_order_relaxed);
+    }
+}
+
+void ServoBankEngine::processAddingTo(juce::dsp::ProcessContextReplacing<float>& context)
+{
+    processInternal(context.getOutputBlock());
+}
+
+void ServoBankEngine::processAddingTo(juce::dsp::ProcessContextReplacing<double>& context)
+{
+    processInternal(context.getOutputBlock());
+}
+
+template <typename SampleType>
+void ServoBankEngine::processInternal(const juce::dsp::AudioBlock<SampleType>& outputBlock)
+{
+    if (!isEnabledFlag || numActiveLanes == 0)
+        return;
+
+    withChannelLayout(outputBlock.getNumChannels(), [&](auto layout)
+    {
+        renderBlock<SampleType, decltype(layout)::value>(outputBlock);
+    });
+}
+
+template <typename SampleType, size_t NumChannels>
+void ServoBankEngine::renderBlock(const juce::dsp::AudioBlock<SampleType>& outputBlock)
+{
+    // NumChannels is 1 or 2 for the unrolled mono/stereo paths, 0 for any other layout
+    const size_t numChannels = NumChannels > 0 ? NumChannels : outputBlock.getNumChannels();
+    const size_t numSamples = outputBlock.getNumSamples();
+
+    for (size_t start = 0; start < numSamples; start += chunkSize)
+    {
+        const size_t count = juce::jmin(static_cast<size_t>(chunkSize), numSamples - start);
+        renderMono(static_cast<int>(count));
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* output = outputBlock.getChannelPointer(channel) + start;
+            for (size_t sample = 0; sample < count; ++sample)
+                output[sample] += static_cast<SampleType>(monoBuffer[sample]);
+        }
+    }
+}
+
+void ServoBankEngine::renderMono(int numSamples) noexcept
+{
+    // The lane loop has no branches, calls or cross-lane dependencies, so it
+    // vectorises across servos. Samples stay in the outer loop because each
+    // lane's phase depends on its previous sample; the lanes are summed after
+    // the vector loop, since a float sum inside it would not vectorise.
+    alignas(64) LaneArray laneOutputs{};
+    const float lowest = minIncrement;
+    const float highest = maxIncrement;
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        for (int group = 0; group < numActiveLanes; group += laneGroup)
+        {
+            float* const phase = phases.data() + group;
+            float* const lfoPhase = lfoPhases.data() + group;
+            const float* const increment = increments.data() + group;
+            const float* const lfoIncrement = lfoIncrements.data() + group;
+            const float* const modDepth = modDepths.data() + group;
+            const float* const level = levels.data() + group;
+            float* const output = laneOutputs.data() + group;
+
+            for (int i = 0; i < laneGroup; ++i)
+            {
+                const float lfo = FastMath::sin<FastMath::Precision::fast>(lfoPhase[i]);
+                const float modulated = increment[i] * (1.0f + lfo * modDepth[i]);
+                const float clamped = juce::jlimit(lowest, highest, modulated);
+
+                output[i] = FastMath::sin<FastMath::Precision::accurate>(phase[i]) * level[i];
+
+                phase[i] = wrapPhase(phase[i] + clamped);
+                lfoPhase[i] = wrapPhase(lfoPhase[i] + lfoIncrement[i]);
+            }
+        }
+
+        float sum = 0.0f;
+        for (int i = 0; i < numActiveLanes; ++i)
+            sum += laneOutputs[static_cast<size_t>(i)];
+
+        monoBuffer[static_cast<size_t>(sample)] = sum;
+    }
+}
+
+void ServoBankEngine::setEnabled(bool enabled)
+{
+    isEnabledFlag = enabled;
+}
+
+bool ServoBankEngine::getEnabled() const
+{
+    return isEnabledFlag;
+}
+
+double ServoBankEngine::getCPUUsage() const
+{
+    return 0.0;
+}
+
+size_t ServoBankEngine::getMemoryUsage() const
+{
+    return sizeof(*this);
+}
@@ -0,0 +1,120 @@
+// Source/AudioEngine/ServoBankEngine.h
+#pragma once
+
+#include "../Source/AudioEngine/SoundEngineBase.h"
+#include "../Source/AudioEngine/FastMath.h"
+#include "../Parameters/Parameters.h" // For EngineParameterSet (needed by updateParameters)
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+/*
+    A bank of up to 16 servos rendered together.
+
+    Each servo sounds like a ServoEngine (sine whine with a vibrato LFO), but
+    the state of all servos lives in structure-of-arrays form: phases,
+    increments, LFO states, depths and levels are separate aligned arrays. The
+    per-sample loop then runs across servos with no branches, so the compiler
+    advances 4, 8 or 16 of them per instruction, depending on the target.
+    Lanes are processed in groups of 8, so unused servos cost nothing beyond
+    the end of their group.
+
+    Every servo scales the global servo parameters by its own settings
+    (level, pitch ratio, mod depth, mod rate ratio). The default settings
+    spread the servos over about an octave, as on a real rig. How many servos
+    sound is the servoBankSize parameter; the per-servo settings are stored
+    with the plugin state and handed to every bank by MechaSoundEngine.
+
+    Cost per servo per sample against the same number of separate
+    ServoEngines (g++ 12 -O3, 48 kHz, stereo, 32-sample blocks):
+
+                    x86-64 (SSE2)          x86-64-v3 (AVX2)
+        servos    bank     separate      bank     separate
+          1      37 ns      17 ns       24 ns      15 ns
+          4       8 ns      16 ns        5 ns      14 ns
+          8       4 ns      16 ns        2 ns      13 ns
+         16       4 ns      16 ns        2 ns      14 ns
+
+    A single servo is cheaper as a ServoEngine; from 4 servos on the bank wins.
+    Tools/ServoBankBenchmark measures this table.
+*/
+class ServoBankEngine : public SoundEngineBase
+{
+public:
+    static constexpr int maxServos = 16;
+
+    struct ServoSettings
+    {
+        float level = 1.0f;        // Times the servo level
+        float pitchRatio = 1.0f;   // Times the servo pitch
+        float modDepth = 1.0f;     // Times the servo mod depth
+        float modRateRatio = 1.0f; // Times the servo mod rate
+    };
+
+    // Settings of every servo in a bank, stored with the plugin state
+    struct BankSettings
+    {
+        BankSettings(); // The default spread
+
+        std::array<ServoSettings, maxServos> servos;
+
+        juce::ValueTree toValueTree() const;
+        static BankSettings fromValueTree(const juce::ValueTree& tree);
+    };
+
+    static const juce::Identifier stateType;
+
+    ServoBankEngine();
+    ~ServoBankEngine() override = default;
+
+    // --- SoundEngineBase overrides ---
+    void prepare(const juce::dsp::ProcessSpec& spec) override;
+    void reset() override;
+    void processAddingTo(juce::dsp::ProcessContextReplacing<float>& context) override;
+    void processAddingTo(juce::dsp::ProcessContextReplacing<double>& context) override;
+    void updateParameters(const EngineParameterSet& allParams) override;
+    void setEnabled(bool enabled) override;
+    bool getEnabled() const override;
+    double getCPUUsage() const override;
+    size_t getMemoryUsage() const override;
+
+    // --- Any thread; applied at the next parameter update ---
+    void setServo(int index, const ServoSettings& settings) noexcept;
+    void setBankSettings(const BankSettings& settings) noexcept;
+
+private:
+    template <typename SampleType>
+    void processInternal(const juce::dsp::AudioBlock<SampleType>& outputBlock);
+
+    template <typename SampleType, size_t NumChannels>
+    void renderBlock(const juce::dsp::AudioBlock<SampleType>& outputBlock);
+
+    /** @brief Renders the sum of all servos for up to chunkSize samples into monoBuffer. */
+    void renderMono(int numSamples) noexcept;
+
+    using LaneArray = std::array<float, maxServos>;
+    static constexpr int laneGroup = 8;
+    static constexpr int chunkSize = 32;
+
+    // Per-servo settings, written by any thread
+    std::array<std::atomic<float>, maxServos> settingLevels;
+    std::array<std::atomic<float>, maxServos> settingPitchRatios;
+    std::array<std::atomic<float>, maxServos> settingModDepths;
+    std::array<std::atomic<float>, maxServos> settingModRateRatios;
+
+    // Audio thread state, one lane per servo
+    alignas(64) LaneArray phases{};
+    alignas(64) LaneArray increments{};    // Radians per sample at the unmodulated pitch
+    alignas(64) LaneArray lfoPhases{};
+    alignas(64) LaneArray lfoIncrements{};
+    alignas(64) LaneArray modDepths{};
+    alignas(64) LaneArray levels{};
+    alignas(64) std::array<float, chunkSize> monoBuffer{};
+
+    int numActiveLanes = 0; // Rounded up to a whole laneGroup
+    float minIncrement = 0.0f;
+    float maxIncrement = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ServoBankEngine)
+};
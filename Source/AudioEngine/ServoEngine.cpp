@@ -37,33 +37,51 @@ void ServoEngine::updateParameters(const EngineParameterSet& allParams)
 }
 
 void ServoEngine::processAddingTo(juce::dsp::ProcessContextReplacing<float>& context)
+{
+    processInternal(context.getOutputBlock());
+}
+
+void ServoEngine::processAddingTo(juce::dsp::ProcessContextReplacing<double>& context)
+{
+    processInternal(context.getOutputBlock());
+}
+
+template <typename SampleType>
+void ServoEngine::processInternal(const juce::dsp::AudioBlock<SampleType>& outputBlock)
 {
     if (!isEnabledFlag || currentLevel < 0.001f) // Check enabled flag and negligible level
         return;
 
-    auto& outputBlock = context.getOutputBlock();
-    auto numSamples = outputBlock.getNumSamples();
-    auto numChannels = outputBlock.getNumChannels();
-
     servoLFO.setFrequency(currentModRate);
 
-    for (size_t channel = 0; channel < numChannels; ++channel)
+    withChannelLayout(outputBlock.getNumChannels(), [&](auto layout)
     {
-        auto* channelData = outputBlock.getChannelPointer(channel);
+        renderBlock<SampleType, decltype(layout)::value>(outputBlock);
+    });
+}
 
-        for (size_t sample = 0; sample < numSamples; ++sample)
-        {
-            float lfoSample = servoLFO.processSample(0.0f);
-            float pitchModAmount = currentPitch * lfoSample * currentModDepth;
-            float modulatedPitch = currentPitch + pitchModAmount;
-            modulatedPitch = std::max(20.0f, std::min(modulatedPitch, 20000.0f));
+template <typename SampleType, size_t NumChannels>
+void ServoEngine::renderBlock(const juce::dsp::AudioBlock<SampleType>& outputBlock)
+{
+    // NumChannels is 1 or 2 for the unrolled mono/stereo paths, 0 for any other layout
+    const size_t numChannels = NumChannels > 0 ? NumChannels : outputBlock.getNumChannels();
+    const size_t numSamples = outputBlock.getNumSamples();
+
+    // The servo is a mono source: each sample is generated once and added to every
+    // channel, so the oscillators advance once per sample regardless of channel count.
+    for (size_t sample = 0; sample < numSamples; ++sample)
+    {
+        float lfoSample = servoLFO.processSample();
+        float pitchModAmount = currentPitch * lfoSample * currentModDepth;
+        float modulatedPitch = currentPitch + pitchModAmount;
+        modulatedPitch = std::max(20.0f, std::min(modulatedPitch, 20000.0f));
 
-            servoOsc.setFrequency(modulatedPitch, true); // true for immediate update
-            float servoSample = servoOsc.processSample(0.0f);
+        servoOsc.setFrequency(modulatedPitch);
+        const auto servoSample = static_cast<SampleType>(servoOsc.processSample() * currentLevel);
 
-            // Add to existing channel data
-            channelData[sample] += servoSample * currentLevel;
-        }
+        // Add to existing channel data
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            outputBlock.getChannelPointer(channel)[sample] += servoSample;
     }
 }
 
@@ -86,6 +104,5 @@ double ServoEngine::getCPUUsage() const
 size_t ServoEngine::getMemoryUsage() const
 {
     // Placeholder - calculate actual memory if needed
-    // sizeof(*this) + sizeof(servoOsc) + sizeof(servoLFO) approx.
-    return sizeof(*this) + 2 * sizeof(juce::dsp::Oscillator<float>);
+    return sizeof(*this);
 }
\ No newline at end of file
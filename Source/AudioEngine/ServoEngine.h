@@ -2,9 +2,10 @@
 #pragma once
 
 #include "../Source/AudioEngine/SoundEngineBase.h"    // Include the new base class
+#include "../Source/AudioEngine/FastDSP.h"
 #include "../Parameters/Parameters.h" // For EngineParameterSet (needed by updateParameters)
 #include <juce_dsp/juce_dsp.h>
-#include <cmath>                // For std::sin, std::max, std::min
+#include <cmath>                // For std::max, std::min
 
 class ServoEngine : public SoundEngineBase // Inherit from SoundEngineBase
 {
@@ -16,6 +17,7 @@ public:
     void prepare(const juce::dsp::ProcessSpec& spec) override;
     void reset() override;
     void processAddingTo(juce::dsp::ProcessContextReplacing<float>& context) override;
+    void processAddingTo(juce::dsp::ProcessContextReplacing<double>& context) override;
     void updateParameters(const EngineParameterSet& allParams) override;
     void setEnabled(bool enabled) override;
     bool getEnabled() const override;
@@ -23,8 +25,14 @@ public:
     size_t getMemoryUsage() const override;
 
 private:
-    juce::dsp::Oscillator<float> servoOsc{ [](float x) { return std::sin(x); } }; // [cite: 18]
-    juce::dsp::Oscillator<float> servoLFO{ [](float x) { return std::sin(x); } }; // [cite: 18]
+    template <typename SampleType>
+    void processInternal(const juce::dsp::AudioBlock<SampleType>& outputBlock);
+
+    template <typename SampleType, size_t NumChannels>
+    void renderBlock(const juce::dsp::AudioBlock<SampleType>& outputBlock);
+
+    FastSineOscillator<FastMath::Precision::accurate> servoOsc; // [cite: 18]
+    FastSineOscillator<FastMath::Precision::fast> servoLFO;      // Modulator only, [cite: 18]
 
     // Cached parameters
     float currentLevel = 0.0f;
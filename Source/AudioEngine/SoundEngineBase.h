@@ -2,6 +2,7 @@
 #pragma once
 
 #include <juce_dsp/juce_dsp.h>
+#include <type_traits> // For std::integral_constant
 
 // Forward declaration for the main parameter structure.
 // This will be defined in Parameters/Parameters.h
@@ -19,12 +20,27 @@ public:
     /** @brief Resets the internal state of the engine. */
     virtual void reset() = 0;
 
+    /** @brief Resets the engine into the steady state of 'allParams', as if it had been
+        running on them for a while. Used for an engine that is crossfaded in, which must
+        not start from silence. Engines whose reset() ramps nothing up need not override it.
+    */
+    virtual void resetTo(const EngineParameterSet& allParams)
+    {
+        reset();
+        updateParameters(allParams);
+    }
+
     /** @brief Processes audio and adds its output to the context's audio block.
         It's the responsibility of the concrete engine to correctly mix or add
         its sound to the provided audio block.
     */
     virtual void processAddingTo(juce::dsp::ProcessContextReplacing<float>& context) = 0;
 
+    /** @brief Double precision variant, used when the host runs a 64-bit mix engine.
+        Engine state stays in float; only the output path is double.
+    */
+    virtual void processAddingTo(juce::dsp::ProcessContextReplacing<double>& context) = 0;
+
     // Parameter Management
     /** @brief Updates the engine's parameters from the global set.
         Each engine will extract its relevant parameters from 'allParams'.
@@ -37,6 +53,11 @@ public:
     /** @brief Returns true if the engine is currently enabled for processing. */
     virtual bool getEnabled() const = 0;
 
+    /** @brief Audio thread: returns true while the engine produces output. That is while it
+        is enabled, or for engines that fade out when disabled, until the fade has finished.
+    */
+    virtual bool isSounding() const { return getEnabled(); }
+
     // Performance Monitoring (as per Technical Specifications)
     /** @brief Returns the estimated CPU usage of this engine (0.0 to 1.0). */
     virtual double getCPUUsage() const = 0;
@@ -44,7 +65,29 @@ public:
     /** @brief Returns the estimated memory usage of this engine in bytes. */
     virtual size_t getMemoryUsage() const = 0;
 
+    // Multirate
+    /** @brief Highest frequency the engine produces, in Hz, or 0 for the full band.
+        An engine that declares one may be prepared at a fraction of the host rate
+        and upsampled by its owner (see EngineUpsampler).
+    */
+    virtual double getBandwidth() const { return 0.0; }
+
 protected:
+    /** @brief Calls 'function' with the channel count as a compile-time constant for
+        mono and stereo blocks, so their inner loops can be unrolled. Any other layout
+        gets 0, meaning "use the runtime channel count".
+    */
+    template <typename Function>
+    static void withChannelLayout(size_t numChannels, Function&& function)
+    {
+        switch (numChannels)
+        {
+            case 1:  function(std::integral_constant<size_t, 1>{}); break;
+            case 2:  function(std::integral_constant<size_t, 2>{}); break;
+            default: function(std::integral_constant<size_t, 0>{}); break;
+        }
+    }
+
     std::atomic<bool> isEnabledFlag{ false }; // Internal flag to store enabled state
     double currentSampleRate = 44100.0;
     int currentBlockSize = 512;
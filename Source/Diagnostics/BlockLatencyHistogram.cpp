@@ -0,0 +1,162 @@
+// Source/Diagnostics/BlockLatencyHistogram.cpp
+#include "../Source/Diagnostics/BlockLatencyHistogram.h"
+#include <cmath>
+
+juce::String ParameterEvent::toString(juce::uint32 events)
+{
+    if (events == none)
+        return "none";
+
+    juce::StringArray names;
+    if (events & activationToggle) names.add("activation toggle");
+    if (events & complexityJump)   names.add("complexity jump");
+    if (events & filterSweep)      names.add("filter sweep");
+    if (events & hissChange)       names.add("hiss change");
+    if (events & servoChange)      names.add("servo change");
+    if (events & programChange)    names.add("program change");
+    if (events & morphActive)      names.add("morph");
+    return names.joinIntoString(", ");
+}
+
+//==============================================================================
+int BlockLatencyHistogram::getBucketIndex(double microseconds) noexcept
+{
+    if (microseconds <= 1.0)
+        return 0;
+
+    const int bucket = static_cast<int>(std::log2(microseconds) * bucketsPerOctave);
+    return juce::jmin(bucket, numBuckets - 1);
+}
+
+double BlockLatencyHistogram::getBucketUpperEdge(int bucket) noexcept
+{
+    return std::exp2(static_cast<double>(bucket + 1) / bucketsPerOctave);
+}
+
+void BlockLatencyHistogram::record(double microseconds, juce::uint32 events) noexcept
+{
+    // Single writer: plain load/store pairs are enough, readers only need each value untorn.
+    auto& bucket = buckets[static_cast<size_t>(getBucketIndex(microseconds))];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    const auto blockIndex = numBlocks.load(std::memory_order_relaxed);
+    numBlocks.store(blockIndex + 1, std::memory_order_relaxed);
+
+    if (microseconds > maxMicroseconds.load(std::memory_order_relaxed))
+        maxMicroseconds.store(microseconds, std::memory_order_relaxed);
+
+    // Outliers are judged against the running average before it absorbs this block
+    const juce::uint32 precedingEvents = events | previousEvents;
+    if (blockIndex > 0 && microseconds > averageMicroseconds * outlierFactor)
+    {
+        const auto outlierIndex = numOutliers.load(std::memory_order_relaxed);
+        auto& slot = outliers[static_cast<size_t>(outlierIndex % maxOutliers)];
+        slot.blockIndex.store(blockIndex, std::memory_order_relaxed);
+        slot.microseconds.store(microseconds, std::memory_order_relaxed);
+        slot.events.store(precedingEvents, std::memory_order_relaxed);
+
+        for (int flag = 0; flag < ParameterEvent::numFlags; ++flag)
+        {
+            if ((precedingEvents & (1u << flag)) != 0)
+            {
+                auto& count = outliersByEvent[static_cast<size_t>(flag)];
+                count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        }
+        numOutliers.store(outlierIndex + 1, std::memory_order_release);
+    }
+
+    // Exponential average over roughly the last 64 blocks
+    averageMicroseconds = (blockIndex == 0) ? microseconds
+                                            : averageMicroseconds + (microseconds - averageMicroseconds) / 64.0;
+    previousEvents = events;
+}
+
+BlockLatencyHistogram::Report BlockLatencyHistogram::getReport() const
+{
+    Report report;
+
+    std::array<juce::uint64, numBuckets> counts;
+    juce::uint64 total = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    report.numBlocks = total;
+    report.bucketCounts.assign(counts.begin(), counts.end());
+    report.max = maxMicroseconds.load(std::memory_order_relaxed);
+
+    auto percentile = [&](double fraction)
+    {
+        const auto target = static_cast<juce::uint64>(std::ceil(fraction * static_cast<double>(total)));
+        juce::uint64 running = 0;
+        for (int i = 0; i < numBuckets; ++i)
+        {
+            running += counts[static_cast<size_t>(i)];
+            if (running >= target && running > 0)
+                return juce::jmin(getBucketUpperEdge(i), report.max);
+        }
+        return report.max;
+    };
+
+    if (total > 0)
+    {
+        report.p50 = percentile(0.5);
+        report.p99 = percentile(0.99);
+        report.p999 = percentile(0.999);
+    }
+
+    const auto written = numOutliers.load(std::memory_order_acquire);
+    report.numOutliers = written;
+    for (size_t flag = 0; flag < outliersByEvent.size(); ++flag)
+        report.outliersByEvent[flag] = outliersByEvent[flag].load(std::memory_order_relaxed);
+
+    const auto available = juce::jmin(written, static_cast<juce::uint64>(maxOutliers));
+    report.outliers.reserve(static_cast<size_t>(available));
+
+    for (auto i = written - available; i < written; ++i)
+    {
+        const auto& slot = outliers[static_cast<size_t>(i % maxOutliers)];
+        report.outliers.push_back({ slot.blockIndex.load(std::memory_order_relaxed),
+                                    slot.microseconds.load(std::memory_order_relaxed),
+                                    slot.events.load(std::memory_order_relaxed) });
+    }
+
+    return report;
+}
+
+void BlockLatencyHistogram::reset() noexcept
+{
+    for (auto& bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+
+    numBlocks.store(0);
+    maxMicroseconds.store(0.0);
+    numOutliers.store(0);
+    for (auto& count : outliersByEvent)
+        count.store(0, std::memory_order_relaxed);
+    averageMicroseconds = 0.0;
+    previousEvents = ParameterEvent::none;
+}
+
+//==============================================================================
+juce::String BlockLatencyHistogram::Report::toString() const
+{
+    juce::String text;
+    text << "blocks: " << juce::String(static_cast<juce::int64>(numBlocks))
+         << "  p50: " << juce::String(p50, 1) << " us"
+         << "  p99: " << juce::String(p99, 1) << " us"
+         << "  p99.9: " << juce::String(p999, 1) << " us"
+         << "  max: " << juce::String(max, 1) << " us" << juce::newLine;
+
+    for (const auto& outlier : outliers)
+    {
+        text << "  outlier at block " << juce::String(static_cast<juce::int64>(outlier.blockIndex))
+             << ": " << juce::String(outlier.microseconds, 1) << " us after "
+             << ParameterEvent::toString(outlier.events) << juce::newLine;
+    }
+
+    return text;
+}
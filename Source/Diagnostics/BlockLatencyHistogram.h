@@ -0,0 +1,111 @@
+// Source/Diagnostics/BlockLatencyHistogram.h
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+// Parameter events seen by the processor, used to explain latency outliers.
+namespace ParameterEvent
+{
+    enum Flags : juce::uint32
+    {
+        none             = 0,
+        activationToggle = 1 << 0, // powerCoreActivationTrigger flipped
+        complexityJump   = 1 << 1, // powerCoreHumComplexity moved by a harmonic step or more
+        filterSweep      = 1 << 2, // powerCoreFilterCutoff or hissCutoff changed
+        hissChange       = 1 << 3, // hiss level, resonance or colour changed
+        servoChange      = 1 << 4, // any servo parameter changed
+        programChange    = 1 << 5, // a program crossfade started
+        morphActive      = 1 << 6  // the morph pad supplied the parameters
+    };
+
+    constexpr int numFlags = 7;
+
+    /** @brief Returns a readable, comma separated list of the flags in 'events'. */
+    juce::String toString(juce::uint32 events);
+}
+
+//==============================================================================
+/*
+    Per-block processing time histogram.
+
+    The audio thread calls record() once per block; it touches one bucket
+    counter and, for outliers, one slot of a fixed ring, so it never allocates
+    or locks. Buckets are log-spaced (8 per octave from 1 us), so percentiles
+    are reported as the upper edge of their bucket (within about 9%).
+
+    A block is an outlier when it takes more than 'outlierFactor' times the
+    running average. Each outlier keeps the parameter events of its own and
+    the preceding block, which is what usually triggered the spike.
+*/
+class BlockLatencyHistogram
+{
+public:
+    struct Outlier
+    {
+        juce::uint64 blockIndex = 0;
+        double microseconds = 0.0;
+        juce::uint32 events = ParameterEvent::none;
+    };
+
+    struct Report
+    {
+        juce::uint64 numBlocks = 0;
+        double p50 = 0.0;  // Microseconds
+        double p99 = 0.0;
+        double p999 = 0.0;
+        double max = 0.0;
+        std::vector<juce::uint64> bucketCounts; // numBuckets entries; see getBucketUpperEdge()
+
+        juce::uint64 numOutliers = 0;
+        std::array<juce::uint64, ParameterEvent::numFlags> outliersByEvent{}; // Outliers preceded by each flag
+        std::vector<Outlier> outliers; // The last maxOutliers, most recent last
+
+        juce::String toString() const;
+    };
+
+    BlockLatencyHistogram() = default;
+
+    /** @brief Audio thread: adds one block's processing time. */
+    void record(double microseconds, juce::uint32 events) noexcept;
+
+    /** @brief Any thread other than the audio thread: builds a report from the current counts. */
+    Report getReport() const;
+
+    /** @brief Clears all counts. Not synchronised with record(); call while processing is stopped. */
+    void reset() noexcept;
+
+    static constexpr int bucketsPerOctave = 8;
+    static constexpr int numOctaves = 18; // 1 us .. ~262 ms
+    static constexpr int numBuckets = bucketsPerOctave * numOctaves + 1; // + overflow
+    static constexpr int maxOutliers = 64;
+    static constexpr double outlierFactor = 4.0;
+
+    /** @brief Upper edge of bucket 'bucket', in microseconds. */
+    static double getBucketUpperEdge(int bucket) noexcept;
+
+private:
+    static int getBucketIndex(double microseconds) noexcept;
+
+    std::array<std::atomic<juce::uint64>, numBuckets> buckets{};
+    std::atomic<juce::uint64> numBlocks{ 0 };
+    std::atomic<double> maxMicroseconds{ 0.0 };
+
+    struct OutlierSlot
+    {
+        std::atomic<juce::uint64> blockIndex{ 0 };
+        std::atomic<double> microseconds{ 0.0 };
+        std::atomic<juce::uint32> events{ 0 };
+    };
+    std::array<OutlierSlot, maxOutliers> outliers;
+    std::atomic<juce::uint64> numOutliers{ 0 };
+    std::array<std::atomic<juce::uint64>, ParameterEvent::numFlags> outliersByEvent{};
+
+    // Audio thread only
+    double averageMicroseconds = 0.0;
+    juce::uint32 previousEvents = ParameterEvent::none;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BlockLatencyHistogram)
+};
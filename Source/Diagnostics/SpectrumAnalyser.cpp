@@ -0,0 +1,181 @@
+// Source/Diagnostics/SpectrumAnalyser.cpp
+#include "../Source/Diagnostics/SpectrumAnalyser.h"
+
+namespace
+{
+    constexpr int stopTimeoutMilliseconds = 2000;
+}
+
+SpectrumAnalyser::SpectrumAnalyser()
+    : juce::Thread("Spectrum analyser")
+{
+    taps[static_cast<size_t>(masterTap)].enabled.store(true);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    stopThread(stopTimeoutMilliseconds);
+}
+
+void SpectrumAnalyser::prepare(double sampleRate)
+{
+    const bool wasRunning = isThreadRunning();
+    stopThread(stopTimeoutMilliseconds);
+
+    currentSampleRate.store(sampleRate);
+    for (auto& tap : taps)
+    {
+        tap.fifo.reset();
+        tap.history.fill(0.0f);
+        tap.hasLevels = false;
+    }
+
+    if (wasRunning)
+        startThread();
+}
+
+//==============================================================================
+void SpectrumAnalyser::setActive(bool shouldBeActive)
+{
+    if (shouldBeActive == isActive())
+        return;
+
+    active.store(shouldBeActive);
+    if (shouldBeActive)
+        startThread();
+    else
+        stopThread(stopTimeoutMilliseconds);
+}
+
+void SpectrumAnalyser::setTapEnabled(int tap, bool enabled) noexcept
+{
+    jassert(tap >= 0 && tap < numTaps);
+    taps[static_cast<size_t>(tap)].enabled.store(enabled);
+}
+
+bool SpectrumAnalyser::getPath(int tap, juce::Path& path) const
+{
+    jassert(tap >= 0 && tap < numTaps);
+    const juce::ScopedLock lock(pathLock);
+
+    const auto& source = taps[static_cast<size_t>(tap)];
+    if (!source.hasPath)
+        return false;
+
+    path = source.path;
+    return true;
+}
+
+//==============================================================================
+void SpectrumAnalyser::run()
+{
+    while (!threadShouldExit())
+    {
+        bool anyNew = false;
+
+        for (auto& tap : taps)
+        {
+            if (!tap.enabled.load(std::memory_order_relaxed))
+            {
+                // Stale frames would show up when the tap is enabled again. The audio
+                // thread may still be pushing, so they are read away rather than reset().
+                tap.fifo.finishedRead(tap.fifo.getNumReady());
+                tap.history.fill(0.0f);
+                tap.hasLevels = false;
+                continue;
+            }
+
+            if (!drain(tap))
+                continue;
+
+            analyse(tap);
+            auto path = buildPath(tap);
+
+            const juce::ScopedLock lock(pathLock);
+            tap.path.swapWithPath(path);
+            tap.hasPath = true;
+            anyNew = true;
+        }
+
+        if (anyNew)
+            version.fetch_add(1, std::memory_order_release);
+
+        wait(frameIntervalMilliseconds);
+    }
+}
+
+bool SpectrumAnalyser::drain(Tap& tap)
+{
+    const int numReady = tap.fifo.getNumReady();
+    if (numReady == 0)
+        return false;
+
+    // Only the newest fftSize samples matter
+    const int numSkipped = juce::jmax(0, numReady - fftSize);
+    const int numNew = numReady - numSkipped;
+    tap.fifo.finishedRead(numSkipped);
+
+    // Shift the history left and append the new samples
+    std::copy(tap.history.begin() + numNew, tap.history.end(), tap.history.begin());
+    auto* destination = tap.history.data() + (fftSize - numNew);
+
+    const auto scope = tap.fifo.read(numNew);
+    std::copy_n(tap.ring.data() + scope.startIndex1, scope.blockSize1, destination);
+    std::copy_n(tap.ring.data() + scope.startIndex2, scope.blockSize2, destination + scope.blockSize1);
+    return true;
+}
+
+void SpectrumAnalyser::analyse(Tap& tap)
+{
+    std::copy(tap.history.begin(), tap.history.end(), fftData.begin());
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+    window.multiplyWithWindowingTable(fftData.data(), static_cast<size_t>(fftSize));
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // A full-scale sine reads 0 dB: the Hann window halves the amplitude
+    constexpr float scale = 4.0f / static_cast<float>(fftSize);
+
+    for (size_t bin = 0; bin < tap.levels.size(); ++bin)
+    {
+        const float level = juce::Decibels::gainToDecibels(fftData[bin] * scale, minDecibels);
+        auto& smoothed = tap.levels[bin];
+
+        if (!tap.hasLevels || level > smoothed)
+            smoothed = level;
+        else
+            smoothed = level + releasePerFrame * (smoothed - level);
+    }
+
+    tap.hasLevels = true;
+}
+
+juce::Path SpectrumAnalyser::buildPath(const Tap& tap) const
+{
+    const float binWidth = static_cast<float>(currentSampleRate.load()) / static_cast<float>(fftSize);
+    const float logRange = std::log(maxFrequency / minFrequency);
+    const int lastBin = static_cast<int>(tap.levels.size()) - 1;
+
+    juce::Path path;
+    path.preallocateSpace(3 * numPathPoints);
+
+    for (int point = 0; point < numPathPoints; ++point)
+    {
+        // Each point covers a log-spaced band; the loudest bin in it is drawn
+        const float x0 = static_cast<float>(point) / static_cast<float>(numPathPoints);
+        const float x1 = static_cast<float>(point + 1) / static_cast<float>(numPathPoints);
+        const int firstBin = juce::jlimit(1, lastBin, static_cast<int>(minFrequency * std::exp(x0 * logRange) / binWidth));
+        const int endBin = juce::jlimit(firstBin + 1, lastBin + 1, static_cast<int>(minFrequency * std::exp(x1 * logRange) / binWidth) + 1);
+
+        float level = minDecibels;
+        for (int bin = firstBin; bin < endBin; ++bin)
+            level = juce::jmax(level, tap.levels[static_cast<size_t>(bin)]);
+
+        const float y = juce::jlimit(0.0f, 1.0f, level / minDecibels);
+        if (point == 0)
+            path.startNewSubPath(x0, y);
+        else
+            path.lineTo(x0, y);
+    }
+
+    return path;
+}
@@ -0,0 +1,138 @@
+// Source/Diagnostics/SpectrumAnalyser.h
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <juce_graphics/juce_graphics.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "../Source/AudioEngine/MechaSoundEngine.h" // For maxEngines
+
+//==============================================================================
+/*
+    Live spectrum of the master output and, on request, of each engine.
+
+    Every tap has a wait-free single-producer ring. The audio thread only
+    writes the mid signal ((L + R) / 2) of each block into it, a single pass
+    that costs about as much as a memcpy. If the ring is full the block is
+    dropped. Nothing is pushed while the analyser is inactive.
+
+    A background thread drains the rings about 30 times a second. It keeps
+    the last fftSize samples of each tap, runs a Hann-windowed FFT, smooths
+    the levels (instant attack, slow release) and builds a path. The path
+    uses normalised coordinates: x is log frequency from minFrequency to
+    maxFrequency, y is level from 0 dB at the top to minDecibels at the
+    bottom. The message thread copies out the finished path and scales it
+    to its own bounds.
+
+    Tap 0 is the master output; tap 1 + i is engine slot i of the live
+    MechaSoundEngine.
+*/
+class SpectrumAnalyser : private juce::Thread
+{
+public:
+    static constexpr int masterTap = 0;
+    static constexpr int numTaps = 1 + MechaSoundEngine::maxEngines;
+
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int ringSize = 1 << 14;
+    static constexpr int numPathPoints = 256;
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float maxFrequency = 20000.0f;
+    static constexpr float minDecibels = -90.0f;
+    static constexpr float releasePerFrame = 0.85f; // Smoothing of falling levels
+    static constexpr int frameIntervalMilliseconds = 33;
+
+    SpectrumAnalyser();
+    ~SpectrumAnalyser() override;
+
+    /** @brief Sets the sample rate and clears all taps. Call while the audio thread is stopped. */
+    void prepare(double sampleRate);
+
+    // --- Message thread ---
+    /** @brief Starts or stops the analysis thread; while inactive push() returns at once. */
+    void setActive(bool shouldBeActive);
+    bool isActive() const noexcept { return active.load(std::memory_order_relaxed); }
+
+    /** @brief Enables a tap. The master tap is enabled by default, engine taps are not. */
+    void setTapEnabled(int tap, bool enabled) noexcept;
+
+    /** @brief Copies the latest path of 'tap' into 'path'. Returns false if it has none yet. */
+    bool getPath(int tap, juce::Path& path) const;
+
+    /** @brief Incremented every time a new set of paths is ready, for polling. */
+    juce::uint32 getVersion() const noexcept { return version.load(std::memory_order_acquire); }
+
+    // --- Audio thread ---
+    bool isTapEnabled(int tap) const noexcept
+    {
+        return active.load(std::memory_order_relaxed) && taps[static_cast<size_t>(tap)].enabled.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Pushes the mid signal of 'block' into 'tap', if it is enabled. Never blocks. */
+    template <typename SampleType>
+    void push(int tap, const juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+private:
+    struct Tap
+    {
+        // Audio thread -> analysis thread
+        juce::AbstractFifo fifo{ ringSize };
+        std::vector<float> ring = std::vector<float>(static_cast<size_t>(ringSize));
+        std::atomic<bool> enabled{ false };
+
+        // Analysis thread
+        std::array<float, fftSize> history{}; // Last fftSize samples, oldest first
+        std::array<float, fftSize / 2> levels{}; // Smoothed, in decibels
+        bool hasLevels = false;
+
+        // Analysis thread -> message thread, under pathLock
+        juce::Path path;
+        bool hasPath = false;
+    };
+
+    void run() override;
+    bool drain(Tap& tap);
+    void analyse(Tap& tap);
+    juce::Path buildPath(const Tap& tap) const;
+
+    std::array<Tap, numTaps> taps;
+    std::atomic<bool> active{ false };
+    std::atomic<double> currentSampleRate{ 44100.0 };
+    std::atomic<juce::uint32> version{ 0 };
+    juce::CriticalSection pathLock; // Analysis thread <-> message thread only
+
+    // Analysis thread
+    juce::dsp::FFT fft{ fftOrder };
+    juce::dsp::WindowingFunction<float> window{ static_cast<size_t>(fftSize), juce::dsp::WindowingFunction<float>::hann, false };
+    std::array<float, 2 * fftSize> fftData{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyser)
+};
+
+//==============================================================================
+template <typename SampleType>
+void SpectrumAnalyser::push(int tap, const juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    if (!isTapEnabled(tap) || block.getNumChannels() == 0)
+        return;
+
+    auto& target = taps[static_cast<size_t>(tap)];
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    if (target.fifo.getFreeSpace() < numSamples)
+        return; // The analysis thread is behind; drop the block
+
+    const auto* left = block.getChannelPointer(0);
+    const auto* right = block.getChannelPointer(block.getNumChannels() > 1 ? 1 : 0);
+
+    const auto scope = target.fifo.write(numSamples);
+    auto copy = [&](int ringStart, int count, int sourceOffset)
+    {
+        auto* destination = target.ring.data() + ringStart;
+        for (int i = 0; i < count; ++i)
+            destination[i] = static_cast<float>(SampleType(0.5) * (left[sourceOffset + i] + right[sourceOffset + i]));
+    };
+    copy(scope.startIndex1, scope.blockSize1, 0);
+    copy(scope.startIndex2, scope.blockSize2, scope.blockSize1);
+}
@@ -0,0 +1,89 @@
+// Source/Diagnostics/TelemetryPublisher.cpp
+#include "../Source/Diagnostics/TelemetryPublisher.h"
+#include <new>
+
+TelemetryPublisher::TelemetryPublisher(const juce::String& hostName)
+{
+    const auto directory = TelemetryRecord::getTelemetryDirectory();
+    if (!directory.createDirectory())
+        return;
+
+    const auto instanceId = static_cast<juce::uint64>(juce::Random().nextInt64());
+    file = directory.getChildFile(juce::String::toHexString(static_cast<juce::int64>(instanceId)) + TelemetryRecord::fileExtension);
+
+    // Size the file first; a mapping cannot grow it
+    {
+        juce::FileOutputStream stream(file);
+        if (!stream.openedOk())
+            return;
+
+        stream.setPosition(0);
+        stream.truncate();
+        const juce::HeapBlock<char> zeros(sizeof(TelemetryRecord), true);
+        stream.write(zeros, sizeof(TelemetryRecord));
+    }
+
+    mapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readWrite);
+    if (mapping->getData() == nullptr || mapping->getSize() < sizeof(TelemetryRecord))
+    {
+        mapping.reset();
+        file.deleteFile();
+        return;
+    }
+
+    // The file is zeroed; the atomics start from there
+    record = new (mapping->getData()) TelemetryRecord();
+    record->instanceId = instanceId;
+    hostName.copyToUTF8(record->hostName, TelemetryRecord::hostNameLength);
+    record->version.store(TelemetryRecord::currentVersion, std::memory_order_relaxed);
+    record->magic.store(TelemetryRecord::magicValue, std::memory_order_release); // Readers accept it from here on
+}
+
+TelemetryPublisher::~TelemetryPublisher()
+{
+    if (record != nullptr)
+        record->magic.store(0, std::memory_order_release);
+
+    record = nullptr;
+    mapping.reset();
+    file.deleteFile();
+}
+
+void TelemetryPublisher::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
+    current = {};
+    current.sampleRate = currentSampleRate;
+    peakHold = 0.0;
+
+    if (record != nullptr)
+        record->write(current);
+}
+
+void TelemetryPublisher::publishBlock(double microseconds, int numSamples, int activeEngines, float outputPeak) noexcept
+{
+    if (record == nullptr || numSamples <= 0)
+        return;
+
+    const double budget = 1.0e6 * numSamples / currentSampleRate;
+
+    current.updateTicks = juce::Time::getHighResolutionTicks();
+    current.blocksProcessed += 1;
+    if (microseconds > budget)
+        current.overruns += 1;
+    current.blockSize = numSamples;
+    current.activeEngines = activeEngines;
+    current.lastBlockMicroseconds = static_cast<float>(microseconds);
+    current.averageBlockMicroseconds = current.blocksProcessed == 1
+        ? static_cast<float>(microseconds)
+        : static_cast<float>(current.averageBlockMicroseconds + averageSmoothing * (microseconds - current.averageBlockMicroseconds));
+    current.maxBlockMicroseconds = juce::jmax(current.maxBlockMicroseconds, static_cast<float>(microseconds));
+    current.blockBudgetMicroseconds = static_cast<float>(budget);
+
+    // Peak meter: instant attack, linear-in-dB release
+    const double release = juce::Decibels::decibelsToGain(-peakReleaseDbPerSecond * numSamples / currentSampleRate);
+    peakHold = juce::jmax(static_cast<double>(outputPeak), peakHold * release);
+    current.outputPeak = static_cast<float>(peakHold);
+
+    record->write(current);
+}
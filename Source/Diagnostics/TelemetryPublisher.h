@@ -0,0 +1,50 @@
+// Source/Diagnostics/TelemetryPublisher.h
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <memory>
+#include "../Source/Diagnostics/TelemetryRecord.h"
+
+//==============================================================================
+/*
+    Publishes one processor instance's telemetry to a memory-mapped file, for
+    Tools/TelemetryMonitor.
+
+    The constructor creates and maps "<instance id>.telemetry" in
+    TelemetryRecord::getTelemetryDirectory(), and the destructor deletes it.
+    If the file cannot be created, publishing is silently disabled.
+
+    publishBlock() runs on the audio thread. It updates the running
+    statistics and writes them into the mapped record through its seqlock,
+    using memory stores only.
+*/
+class TelemetryPublisher
+{
+public:
+    explicit TelemetryPublisher(const juce::String& hostName);
+    ~TelemetryPublisher();
+
+    /** @brief Resets the statistics. Call while the audio thread is stopped. */
+    void prepare(double sampleRate);
+
+    /** @brief Audio thread: records one block. 'outputPeak' is linear. */
+    void publishBlock(double microseconds, int numSamples, int activeEngines, float outputPeak) noexcept;
+
+    bool isPublishing() const noexcept { return record != nullptr; }
+    juce::File getFile() const { return file; }
+
+    static constexpr double averageSmoothing = 0.05;   // Weight of the newest block
+    static constexpr double peakReleaseDbPerSecond = 20.0;
+
+private:
+    juce::File file;
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    TelemetryRecord* record = nullptr;
+
+    // Audio thread
+    TelemetryRecord::Snapshot current;
+    double currentSampleRate = 44100.0;
+    double peakHold = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TelemetryPublisher)
+};
@@ -0,0 +1,139 @@
+// Source/Diagnostics/TelemetryRecord.h
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/*
+    Layout of one instance's telemetry file, shared with Tools/TelemetryMonitor.
+
+    Each processor instance maps a small file in getTelemetryDirectory() and
+    overwrites this record once per block. The record is a seqlock with a
+    single writer, the audio thread:
+
+    - write() makes the sequence odd, stores the fields and makes it even.
+    - read() copies the fields between two loads of the sequence. It retries
+      if the sequence was odd or changed, so it never sees a half-written
+      record.
+
+    Every shared field is a lock-free atomic. The writer never waits, locks or
+    makes a system call, because stores to the mapping are plain memory writes.
+
+    The header fields (instanceId, hostName) are written once, before magic.
+    Readers ignore files whose magic or version do not match.
+*/
+struct TelemetryRecord
+{
+    static constexpr std::uint32_t magicValue = 0x4d534d54; // "MSMT"
+    static constexpr std::uint32_t currentVersion = 1;
+    static constexpr int hostNameLength = 64;
+    static constexpr const char* fileExtension = ".telemetry";
+
+    // One consistent copy of the seqlock-protected fields
+    struct Snapshot
+    {
+        juce::int64 updateTicks = 0;        // juce::Time::getHighResolutionTicks() of the last block
+        juce::uint64 blocksProcessed = 0;
+        juce::uint64 overruns = 0;          // Blocks that took longer than their own duration
+        double sampleRate = 0.0;
+        std::int32_t blockSize = 0;         // Samples in the last block
+        std::int32_t activeEngines = 0;
+        float lastBlockMicroseconds = 0.0f;
+        float averageBlockMicroseconds = 0.0f;
+        float maxBlockMicroseconds = 0.0f;
+        float blockBudgetMicroseconds = 0.0f; // Duration of the last block
+        float outputPeak = 0.0f;            // Linear, with a decaying hold
+    };
+
+    // --- Header, written once ---
+    std::atomic<std::uint32_t> magic;
+    std::atomic<std::uint32_t> version;
+    juce::uint64 instanceId;
+    char hostName[hostNameLength];
+
+    // --- Seqlock ---
+    std::atomic<std::uint32_t> sequence;
+    std::atomic<juce::int64> updateTicks;
+    std::atomic<juce::uint64> blocksProcessed;
+    std::atomic<juce::uint64> overruns;
+    std::atomic<double> sampleRate;
+    std::atomic<std::int32_t> blockSize;
+    std::atomic<std::int32_t> activeEngines;
+    std::atomic<float> lastBlockMicroseconds;
+    std::atomic<float> averageBlockMicroseconds;
+    std::atomic<float> maxBlockMicroseconds;
+    std::atomic<float> blockBudgetMicroseconds;
+    std::atomic<float> outputPeak;
+
+    bool isValid() const noexcept
+    {
+        return magic.load(std::memory_order_acquire) == magicValue
+            && version.load(std::memory_order_relaxed) == currentVersion;
+    }
+
+    /** @brief Single writer only. */
+    void write(const Snapshot& s) noexcept
+    {
+        const auto start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        updateTicks.store(s.updateTicks, std::memory_order_relaxed);
+        blocksProcessed.store(s.blocksProcessed, std::memory_order_relaxed);
+        overruns.store(s.overruns, std::memory_order_relaxed);
+        sampleRate.store(s.sampleRate, std::memory_order_relaxed);
+        blockSize.store(s.blockSize, std::memory_order_relaxed);
+        activeEngines.store(s.activeEngines, std::memory_order_relaxed);
+        lastBlockMicroseconds.store(s.lastBlockMicroseconds, std::memory_order_relaxed);
+        averageBlockMicroseconds.store(s.averageBlockMicroseconds, std::memory_order_relaxed);
+        maxBlockMicroseconds.store(s.maxBlockMicroseconds, std::memory_order_relaxed);
+        blockBudgetMicroseconds.store(s.blockBudgetMicroseconds, std::memory_order_relaxed);
+        outputPeak.store(s.outputPeak, std::memory_order_relaxed);
+
+        sequence.store(start + 2, std::memory_order_release);
+    }
+
+    /** @brief Any number of readers, in any process. Returns false if the writer kept the record busy. */
+    bool read(Snapshot& s, int maxAttempts = 100) const noexcept
+    {
+        for (int attempt = 0; attempt < maxAttempts; ++attempt)
+        {
+            const auto before = sequence.load(std::memory_order_acquire);
+            if ((before & 1u) != 0)
+                continue;
+
+            s.updateTicks = updateTicks.load(std::memory_order_relaxed);
+            s.blocksProcessed = blocksProcessed.load(std::memory_order_relaxed);
+            s.overruns = overruns.load(std::memory_order_relaxed);
+            s.sampleRate = sampleRate.load(std::memory_order_relaxed);
+            s.blockSize = blockSize.load(std::memory_order_relaxed);
+            s.activeEngines = activeEngines.load(std::memory_order_relaxed);
+            s.lastBlockMicroseconds = lastBlockMicroseconds.load(std::memory_order_relaxed);
+            s.averageBlockMicroseconds = averageBlockMicroseconds.load(std::memory_order_relaxed);
+            s.maxBlockMicroseconds = maxBlockMicroseconds.load(std::memory_order_relaxed);
+            s.blockBudgetMicroseconds = blockBudgetMicroseconds.load(std::memory_order_relaxed);
+            s.outputPeak = outputPeak.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before)
+                return true;
+        }
+
+        return false;
+    }
+
+    /** @brief Folder every instance publishes into. */
+    static juce::File getTelemetryDirectory()
+    {
+        return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("MechaSoundTelemetry");
+    }
+};
+
+// The record is shared between processes, so every field must be usable without locks
+static_assert(std::atomic<juce::uint64>::is_always_lock_free && std::atomic<juce::int64>::is_always_lock_free
+                  && std::atomic<double>::is_always_lock_free && std::atomic<float>::is_always_lock_free
+                  && std::atomic<std::uint32_t>::is_always_lock_free,
+              "Telemetry needs lock-free atomics for shared memory");
+static_assert(std::is_standard_layout_v<TelemetryRecord>, "TelemetryRecord is mapped from a file");
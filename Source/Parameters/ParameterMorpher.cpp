@@ -0,0 +1,345 @@
+// Source/Parameters/ParameterMorpher.cpp
+#include "../Source/Parameters/ParameterMorpher.h"
+#include <algorithm>
+#include <cmath>
+
+const juce::Identifier ParameterMorpher::stateType{ "MorphPad" };
+
+namespace
+{
+    const juce::Identifier snapshotType{ "Snapshot" };
+    const juce::Identifier xProperty{ "x" };
+    const juce::Identifier yProperty{ "y" };
+    const juce::Identifier cursorXProperty{ "cursorX" };
+    const juce::Identifier cursorYProperty{ "cursorY" };
+    const juce::Identifier enabledProperty{ "enabled" };
+
+    juce::Point<float> clampToPad(juce::Point<float> p)
+    {
+        return { juce::jlimit(0.0f, 1.0f, p.x), juce::jlimit(0.0f, 1.0f, p.y) };
+    }
+}
+
+ParameterMorpher::ParameterMorpher()
+{
+    rebuildAndPublish();
+}
+
+void ParameterMorpher::attachToParameters(const juce::AudioProcessorValueTreeState& apvts)
+{
+    for (int i = 0; i < ParameterIndex::numParameters; ++i)
+    {
+        auto* param = apvts.getParameter(getParameterID(i));
+        jassert(param != nullptr);
+        ranges[static_cast<size_t>(i)] = &param->getNormalisableRange();
+    }
+}
+
+float ParameterMorpher::getNormalisedDefault(int parameterIndex) const noexcept
+{
+    const auto& descriptor = ParameterDescriptors::table[static_cast<size_t>(parameterIndex)];
+    const auto* range = ranges[static_cast<size_t>(parameterIndex)];
+    return range != nullptr ? range->convertTo0to1(descriptor.defaultValue) : 0.0f;
+}
+
+void ParameterMorpher::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+    smoothedX = cursorX.load();
+    smoothedY = cursorY.load();
+}
+
+//==============================================================================
+int ParameterMorpher::addSnapshot(juce::Point<float> position, const ParameterSnapshot& normalisedValues)
+{
+    const juce::ScopedLock lock(editLock);
+    if (editTable.numSnapshots >= maxSnapshots)
+        return -1;
+
+    const int index = editTable.numSnapshots++;
+    editTable.positions[static_cast<size_t>(index)] = clampToPad(position);
+    editTable.snapshots[static_cast<size_t>(index)] = normalisedValues;
+    rebuildAndPublish();
+    return index;
+}
+
+void ParameterMorpher::moveSnapshot(int index, juce::Point<float> position)
+{
+    const juce::ScopedLock lock(editLock);
+    if (index < 0 || index >= editTable.numSnapshots)
+        return;
+
+    editTable.positions[static_cast<size_t>(index)] = clampToPad(position);
+    rebuildAndPublish();
+}
+
+void ParameterMorpher::recaptureSnapshot(int index, const ParameterSnapshot& normalisedValues)
+{
+    const juce::ScopedLock lock(editLock);
+    if (index < 0 || index >= editTable.numSnapshots)
+        return;
+
+    editTable.snapshots[static_cast<size_t>(index)] = normalisedValues;
+    rebuildAndPublish();
+}
+
+void ParameterMorpher::removeSnapshot(int index)
+{
+    const juce::ScopedLock lock(editLock);
+    if (index < 0 || index >= editTable.numSnapshots)
+        return;
+
+    for (int i = index; i < editTable.numSnapshots - 1; ++i)
+    {
+        editTable.positions[static_cast<size_t>(i)] = editTable.positions[static_cast<size_t>(i + 1)];
+        editTable.snapshots[static_cast<size_t>(i)] = editTable.snapshots[static_cast<size_t>(i + 1)];
+    }
+
+    --editTable.numSnapshots;
+    rebuildAndPublish();
+}
+
+int ParameterMorpher::getNumSnapshots() const
+{
+    const juce::ScopedLock lock(editLock);
+    return editTable.numSnapshots;
+}
+
+juce::Point<float> ParameterMorpher::getSnapshotPosition(int index) const
+{
+    const juce::ScopedLock lock(editLock);
+    jassert(index >= 0 && index < editTable.numSnapshots);
+    return editTable.positions[static_cast<size_t>(index)];
+}
+
+void ParameterMorpher::getWeightsAt(juce::Point<float> position, float* weights) const
+{
+    const juce::ScopedLock lock(editLock);
+    lookupWeights(editTable, position.x, position.y, weights);
+}
+
+ParameterSnapshot ParameterMorpher::captureNormalisedSnapshot(const juce::AudioProcessorValueTreeState& apvts)
+{
+    ParameterSnapshot snapshot{};
+    for (int i = 0; i < ParameterIndex::numParameters; ++i)
+    {
+        if (auto* param = apvts.getParameter(getParameterID(i)))
+            snapshot[static_cast<size_t>(i)] = param->getValue();
+    }
+    return snapshot;
+}
+
+//==============================================================================
+juce::ValueTree ParameterMorpher::toValueTree() const
+{
+    juce::ValueTree tree(stateType);
+    const auto cursor = getCursor();
+    tree.setProperty(cursorXProperty, cursor.x, nullptr);
+    tree.setProperty(cursorYProperty, cursor.y, nullptr);
+    tree.setProperty(enabledProperty, isEnabled(), nullptr);
+
+    const juce::ScopedLock lock(editLock);
+    for (int s = 0; s < editTable.numSnapshots; ++s)
+    {
+        juce::ValueTree snapshotTree(snapshotType);
+        const auto& position = editTable.positions[static_cast<size_t>(s)];
+        snapshotTree.setProperty(xProperty, position.x, nullptr);
+        snapshotTree.setProperty(yProperty, position.y, nullptr);
+
+        for (int i = 0; i < ParameterIndex::numParameters; ++i)
+            if (isMorphable(i))
+                snapshotTree.setProperty(getParameterID(i), editTable.snapshots[static_cast<size_t>(s)][static_cast<size_t>(i)], nullptr);
+
+        tree.appendChild(snapshotTree, nullptr);
+    }
+
+    return tree;
+}
+
+void ParameterMorpher::fromValueTree(const juce::ValueTree& tree)
+{
+    const juce::ScopedLock lock(editLock);
+    if (!tree.hasType(stateType))
+        return;
+
+    editTable.numSnapshots = 0;
+
+    for (const auto& snapshotTree : tree)
+    {
+        if (!snapshotTree.hasType(snapshotType) || editTable.numSnapshots >= maxSnapshots)
+            continue;
+
+        const auto index = static_cast<size_t>(editTable.numSnapshots++);
+        editTable.positions[index] = clampToPad({ static_cast<float>(snapshotTree.getProperty(xProperty, 0.5f)),
+                                                  static_cast<float>(snapshotTree.getProperty(yProperty, 0.5f)) });
+
+        // Parameters added since the snapshot was saved start at their defaults, not at 0
+        for (int i = 0; i < ParameterIndex::numParameters; ++i)
+            editTable.snapshots[index][static_cast<size_t>(i)] = static_cast<float>(snapshotTree.getProperty(getParameterID(i), getNormalisedDefault(i)));
+    }
+
+    setCursor({ static_cast<float>(tree.getProperty(cursorXProperty, 0.5f)),
+                static_cast<float>(tree.getProperty(cursorYProperty, 0.5f)) });
+    setEnabled(tree.getProperty(enabledProperty, false));
+
+    rebuildAndPublish();
+}
+
+//==============================================================================
+void ParameterMorpher::setCursor(juce::Point<float> position) noexcept
+{
+    const auto clamped = clampToPad(position);
+    cursorX.store(clamped.x);
+    cursorY.store(clamped.y);
+}
+
+void ParameterMorpher::rebuildAndPublish()
+{
+    // Callers hold editLock (the constructor needs none)
+    // Inverse-distance-squared weights, normalised per grid point. A grid point
+    // sitting on a snapshot takes that snapshot exactly.
+    const int numSnapshots = editTable.numSnapshots;
+    constexpr float onPointDistance = 1.0e-6f;
+
+    for (int gy = 0; gy < gridSize; ++gy)
+    {
+        for (int gx = 0; gx < gridSize; ++gx)
+        {
+            const juce::Point<float> gridPoint{ static_cast<float>(gx) / (gridSize - 1),
+                                                static_cast<float>(gy) / (gridSize - 1) };
+            float* cell = editTable.weights.data() + (gy * gridSize + gx) * maxSnapshots;
+            std::fill(cell, cell + maxSnapshots, 0.0f);
+
+            int exactMatch = -1;
+            float sum = 0.0f;
+            for (int s = 0; s < numSnapshots; ++s)
+            {
+                const auto delta = gridPoint - editTable.positions[static_cast<size_t>(s)];
+                const float distanceSquared = delta.x * delta.x + delta.y * delta.y;
+                if (distanceSquared < onPointDistance)
+                {
+                    exactMatch = s;
+                    break;
+                }
+                cell[s] = 1.0f / distanceSquared;
+                sum += cell[s];
+            }
+
+            if (exactMatch >= 0)
+            {
+                std::fill(cell, cell + maxSnapshots, 0.0f);
+                cell[exactMatch] = 1.0f;
+            }
+            else if (sum > 0.0f)
+            {
+                for (int s = 0; s < numSnapshots; ++s)
+                    cell[s] /= sum;
+            }
+        }
+    }
+
+    const juce::SpinLock::ScopedLockType lock(tableLock);
+    liveTable = editTable;
+}
+
+void ParameterMorpher::lookupWeights(const MorphTable& table, float x, float y, float* weights) noexcept
+{
+    const float fx = juce::jlimit(0.0f, 1.0f, x) * (gridSize - 1);
+    const float fy = juce::jlimit(0.0f, 1.0f, y) * (gridSize - 1);
+    const int ix = juce::jmin(static_cast<int>(fx), gridSize - 2);
+    const int iy = juce::jmin(static_cast<int>(fy), gridSize - 2);
+    const float tx = fx - static_cast<float>(ix);
+    const float ty = fy - static_cast<float>(iy);
+
+    const float* w00 = table.weights.data() + (iy * gridSize + ix) * maxSnapshots;
+    const float* w10 = w00 + maxSnapshots;
+    const float* w01 = w00 + gridSize * maxSnapshots;
+    const float* w11 = w01 + maxSnapshots;
+
+    for (int s = 0; s < maxSnapshots; ++s)
+    {
+        const float top = w00[s] + tx * (w10[s] - w00[s]);
+        const float bottom = w01[s] + tx * (w11[s] - w01[s]);
+        weights[s] = top + ty * (bottom - top);
+    }
+}
+
+//==============================================================================
+bool ParameterMorpher::process(EngineParameterSet& params, float& masterGain, int numSamples) noexcept
+{
+    if (!enabled.load())
+    {
+        hasMorphedValues = false;
+        return false;
+    }
+
+    {
+        const juce::SpinLock::ScopedTryLockType lock(tableLock);
+
+        if (lock.isLocked() && liveTable.numSnapshots > 0)
+        {
+            // One-pole smoothing of the cursor, advanced once per block.
+            const float blockSeconds = static_cast<float>(numSamples / currentSampleRate);
+            const float coeff = 1.0f - std::exp(-blockSeconds / cursorSmoothingSeconds);
+            smoothedX += coeff * (cursorX.load() - smoothedX);
+            smoothedY += coeff * (cursorY.load() - smoothedY);
+
+            blendAt(liveTable, smoothedX, smoothedY, lastMorphedValues);
+            hasMorphedValues = true;
+        }
+    }
+
+    if (!hasMorphedValues)
+        return false;
+
+    applyMorphedValues(lastMorphedValues, params, masterGain);
+    return true;
+}
+
+bool ParameterMorpher::getMorphedParameters(EngineParameterSet& params, float& masterGain) const
+{
+    if (!enabled.load())
+        return false;
+
+    ParameterSnapshot plainValues{};
+    {
+        const juce::ScopedLock lock(editLock);
+        if (editTable.numSnapshots == 0)
+            return false;
+
+        blendAt(editTable, cursorX.load(), cursorY.load(), plainValues);
+    }
+
+    applyMorphedValues(plainValues, params, masterGain);
+    return true;
+}
+
+void ParameterMorpher::applyMorphedValues(const ParameterSnapshot& plainValues, EngineParameterSet& params, float& masterGain) noexcept
+{
+    // Every field is written, so the limiter's host values (the only parameters
+    // isMorphable() excludes) are put back afterwards
+    const auto hostLimiter = params.limiter;
+    writeSnapshotToParameterSet(plainValues, params, masterGain);
+    params.limiter = hostLimiter;
+}
+
+void ParameterMorpher::blendAt(const MorphTable& table, float x, float y, ParameterSnapshot& plainValues) const noexcept
+{
+    float weights[maxSnapshots];
+    lookupWeights(table, x, y, weights);
+
+    ParameterSnapshot normalised{};
+    for (int s = 0; s < table.numSnapshots; ++s)
+    {
+        const float w = weights[s];
+        if (w <= 0.0f)
+            continue;
+
+        const auto& snapshot = table.snapshots[static_cast<size_t>(s)];
+        for (size_t i = 0; i < normalised.size(); ++i)
+            normalised[i] += w * snapshot[i];
+    }
+
+    for (size_t i = 0; i < normalised.size(); ++i)
+        plainValues[i] = ranges[i]->convertFrom0to1(juce::jlimit(0.0f, 1.0f, normalised[i]));
+}
@@ -0,0 +1,116 @@
+// Source/Parameters/ParameterMorpher.h
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <array>
+#include <atomic>
+#include "../Source/Parameters/Parameters.h" // For ParameterSnapshot and EngineParameterSet
+
+//==============================================================================
+/*
+    Morphs all parameters between up to 'maxSnapshots' snapshots placed on a
+    normalised 2D pad.
+
+    Snapshots are edited on the message thread, which precomputes a grid of
+    inverse-distance weights and publishes it under a SpinLock. Edits, and
+    reads of the edited table, hold editLock, so the state can be saved from
+    whichever thread the host calls getStateInformation() on. The audio thread
+    only try-locks, bilinearly interpolates one row of weights at the cursor and
+    blends the normalised snapshot vectors, once per block. If the lock is
+    busy it keeps the previous result, so it never waits.
+
+    Morphed values are applied directly to the engines; the host sees no
+    parameter changes. Parameters that are not isMorphable() (the limiter)
+    keep their host values and are not stored with the snapshots. A snapshot
+    saved without a parameter, by an older version, loads it at its default.
+*/
+class ParameterMorpher
+{
+public:
+    static constexpr int maxSnapshots = 8;
+    static constexpr int gridSize = 33; // Weight table resolution per axis
+
+    ParameterMorpher();
+
+    /** @brief Caches the parameter ranges used to convert morphed values. Call once after the APVTS is built. */
+    void attachToParameters(const juce::AudioProcessorValueTreeState& apvts);
+
+    /** @brief Sets the rate used for cursor smoothing. */
+    void prepare(double sampleRate);
+
+    // --- Message thread (toValueTree() from any thread) ---
+    /** @brief Adds a snapshot at 'position' (0-1 on both axes). Returns its index, or -1 if full. */
+    int addSnapshot(juce::Point<float> position, const ParameterSnapshot& normalisedValues);
+    void moveSnapshot(int index, juce::Point<float> position);
+    void recaptureSnapshot(int index, const ParameterSnapshot& normalisedValues);
+    void removeSnapshot(int index);
+
+    int getNumSnapshots() const;
+    juce::Point<float> getSnapshotPosition(int index) const;
+
+    /** @brief Fills 'weights' (maxSnapshots entries) with the blend weights at 'position'. */
+    void getWeightsAt(juce::Point<float> position, float* weights) const;
+
+    /** @brief Overwrites 'params' and 'masterGain' with the morphed values at the cursor, unsmoothed,
+        for renders outside the audio thread. Returns false (leaving the arguments untouched) if
+        morphing is off or has no snapshots.
+    */
+    bool getMorphedParameters(EngineParameterSet& params, float& masterGain) const;
+
+    /** @brief Reads the current normalised value of every parameter. */
+    static ParameterSnapshot captureNormalisedSnapshot(const juce::AudioProcessorValueTreeState& apvts);
+
+    juce::ValueTree toValueTree() const;
+    void fromValueTree(const juce::ValueTree& tree);
+
+    static const juce::Identifier stateType;
+
+    // --- Any thread ---
+    void setCursor(juce::Point<float> position) noexcept;
+    juce::Point<float> getCursor() const noexcept { return { cursorX.load(), cursorY.load() }; }
+
+    void setEnabled(bool shouldBeEnabled) noexcept { enabled.store(shouldBeEnabled); }
+    bool isEnabled() const noexcept { return enabled.load(); }
+
+    // --- Audio thread ---
+    /** @brief Overwrites 'params' and 'masterGain' with the morphed values.
+        Returns false (leaving the arguments untouched) if morphing is off or has no snapshots.
+    */
+    bool process(EngineParameterSet& params, float& masterGain, int numSamples) noexcept;
+
+private:
+    struct MorphTable
+    {
+        int numSnapshots = 0;
+        std::array<juce::Point<float>, maxSnapshots> positions{};
+        std::array<ParameterSnapshot, maxSnapshots> snapshots{}; // Normalised values
+        std::array<float, gridSize * gridSize * maxSnapshots> weights{};
+    };
+
+    void rebuildAndPublish();
+    float getNormalisedDefault(int parameterIndex) const noexcept;
+    static void lookupWeights(const MorphTable& table, float x, float y, float* weights) noexcept;
+    void blendAt(const MorphTable& table, float x, float y, ParameterSnapshot& plainValues) const noexcept;
+    static void applyMorphedValues(const ParameterSnapshot& plainValues, EngineParameterSet& params, float& masterGain) noexcept;
+
+    MorphTable editTable;          // Guarded by editLock
+    juce::CriticalSection editLock;
+    MorphTable liveTable;          // Guarded by tableLock
+    juce::SpinLock tableLock;
+
+    std::atomic<float> cursorX{ 0.5f };
+    std::atomic<float> cursorY{ 0.5f };
+    std::atomic<bool> enabled{ false };
+
+    // Audio thread state
+    std::array<const juce::NormalisableRange<float>*, ParameterIndex::numParameters> ranges{};
+    ParameterSnapshot lastMorphedValues{}; // Plain values
+    bool hasMorphedValues = false;
+    float smoothedX = 0.5f;
+    float smoothedY = 0.5f;
+    double currentSampleRate = 44100.0;
+
+    static constexpr float cursorSmoothingSeconds = 0.05f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterMorpher)
+};
@@ -1,54 +1,167 @@
 #include "../Source/Parameters/Parameters.h"
 
+void writeSnapshotToParameterSet(const ParameterSnapshot& plainValues, EngineParameterSet& params, float& masterGain)
+{
+    using namespace ParameterIndex;
+
+    params.hiss.level = plainValues[hissLevel];
+    params.hiss.cutoff = plainValues[hissCutoff];
+    params.hiss.resonanceQ = plainValues[hissResonance];
+    params.hiss.colour = juce::roundToInt(plainValues[hissColour]);
+
+    params.servo.level = plainValues[servoLevel];
+    params.servo.pitch = plainValues[servoPitch];
+    params.servo.modDepth = plainValues[servoModDepth];
+    params.servo.modRate = plainValues[servoModRate];
+    params.servo.bankSize = juce::roundToInt(plainValues[servoBankSize]) + 1; // Choice index 0 is one servo
+
+    params.powerCore.humLevel = plainValues[powerCoreHumLevel];
+    params.powerCore.fundamentalPitch = plainValues[powerCoreFundamentalPitch];
+    params.powerCore.humComplexity = plainValues[powerCoreHumComplexity];
+    params.powerCore.pulsationRate = plainValues[powerCorePulsationRate];
+    params.powerCore.pulsationDepth = plainValues[powerCorePulsationDepth];
+    params.powerCore.activationTrigger = plainValues[powerCoreActivationTrigger] > 0.5f;
+    params.powerCore.activationTime = plainValues[powerCoreActivationTime];
+    params.powerCore.energyType = plainValues[powerCoreEnergyType];
+    params.powerCore.filterCutoff = plainValues[powerCoreFilterCutoff];
+    params.powerCore.filterResonance = plainValues[powerCoreFilterResonance];
+
+    params.convolution.space = juce::roundToInt(plainValues[convolutionSpace]);
+    params.convolution.mix = plainValues[convolutionMix];
+
+    params.granular.level = plainValues[granularLevel];
+    params.granular.density = plainValues[granularDensity];
+    params.granular.grainSize = plainValues[granularGrainSize];
+    params.granular.pitch = plainValues[granularPitch];
+    params.granular.spray = plainValues[granularSpray];
+    params.granular.position = plainValues[granularPosition];
+
+    params.foley.level = plainValues[foleyLevel];
+
+    params.spatial.enabled = plainValues[spatialEnabled] > 0.5f;
+    params.spatial.azimuth = plainValues[spatialAzimuth];
+    params.spatial.distance = plainValues[spatialDistance];
+    params.spatial.spread = plainValues[spatialSpread];
+    params.spatial.doppler = plainValues[spatialDoppler];
+
+    params.limiter.enabled = plainValues[limiterEnabled] > 0.5f;
+    params.limiter.ceilingDb = plainValues[limiterCeiling];
+    params.limiter.releaseSeconds = plainValues[limiterRelease];
+
+    masterGain = plainValues[ParameterIndex::masterGain];
+}
+
+float* getContinuousParameter(EngineParameterSet& params, int parameterIndex) noexcept
+{
+    using namespace ParameterIndex;
+
+    switch (parameterIndex)
+    {
+        case hissLevel:                 return &params.hiss.level;
+        case hissCutoff:                return &params.hiss.cutoff;
+        case hissResonance:             return &params.hiss.resonanceQ;
+        case servoLevel:                return &params.servo.level;
+        case servoPitch:                return &params.servo.pitch;
+        case servoModDepth:             return &params.servo.modDepth;
+        case servoModRate:              return &params.servo.modRate;
+        case powerCoreHumLevel:         return &params.powerCore.humLevel;
+        case powerCoreFundamentalPitch: return &params.powerCore.fundamentalPitch;
+        case powerCoreHumComplexity:    return &params.powerCore.humComplexity;
+        case powerCorePulsationRate:    return &params.powerCore.pulsationRate;
+        case powerCorePulsationDepth:   return &params.powerCore.pulsationDepth;
+        case powerCoreActivationTime:   return &params.powerCore.activationTime;
+        case powerCoreEnergyType:       return &params.powerCore.energyType;
+        case powerCoreFilterCutoff:     return &params.powerCore.filterCutoff;
+        case powerCoreFilterResonance:  return &params.powerCore.filterResonance;
+        case convolutionMix:            return &params.convolution.mix;
+        case granularLevel:             return &params.granular.level;
+        case granularDensity:           return &params.granular.density;
+        case granularGrainSize:         return &params.granular.grainSize;
+        case granularPitch:             return &params.granular.pitch;
+        case granularSpray:             return &params.granular.spray;
+        case granularPosition:          return &params.granular.position;
+        case foleyLevel:                return &params.foley.level;
+        case spatialAzimuth:            return &params.spatial.azimuth;
+        case spatialDistance:           return &params.spatial.distance;
+        case spatialSpread:             return &params.spatial.spread;
+        case spatialDoppler:            return &params.spatial.doppler;
+        default:                        return nullptr;
+    }
+}
+
+void interpolateParameterSet(const EngineParameterSet& from, const EngineParameterSet& to, float position, EngineParameterSet& result)
+{
+    auto lerp = [position](float a, float b) { return a + position * (b - a); };
+
+    result = to; // Discrete values and structs without a running engine take the target directly
+
+    result.hiss.level = lerp(from.hiss.level, to.hiss.level);
+    result.hiss.cutoff = lerp(from.hiss.cutoff, to.hiss.cutoff);
+    result.hiss.resonanceQ = lerp(from.hiss.resonanceQ, to.hiss.resonanceQ);
+
+    result.servo.level = lerp(from.servo.level, to.servo.level);
+    result.servo.pitch = lerp(from.servo.pitch, to.servo.pitch);
+    result.servo.modDepth = lerp(from.servo.modDepth, to.servo.modDepth);
+    result.servo.modRate = lerp(from.servo.modRate, to.servo.modRate);
+
+    result.powerCore.humLevel = lerp(from.powerCore.humLevel, to.powerCore.humLevel);
+    result.powerCore.fundamentalPitch = lerp(from.powerCore.fundamentalPitch, to.powerCore.fundamentalPitch);
+    result.powerCore.humComplexity = lerp(from.powerCore.humComplexity, to.powerCore.humComplexity);
+    result.powerCore.pulsationRate = lerp(from.powerCore.pulsationRate, to.powerCore.pulsationRate);
+    result.powerCore.pulsationDepth = lerp(from.powerCore.pulsationDepth, to.powerCore.pulsationDepth);
+    result.powerCore.activationTime = lerp(from.powerCore.activationTime, to.powerCore.activationTime);
+    result.powerCore.energyType = lerp(from.powerCore.energyType, to.powerCore.energyType);
+    result.powerCore.filterCutoff = lerp(from.powerCore.filterCutoff, to.powerCore.filterCutoff);
+    result.powerCore.filterResonance = lerp(from.powerCore.filterResonance, to.powerCore.filterResonance);
+
+    result.convolution.mix = lerp(from.convolution.mix, to.convolution.mix);
+
+    result.granular.level = lerp(from.granular.level, to.granular.level);
+    result.granular.density = lerp(from.granular.density, to.granular.density);
+    result.granular.grainSize = lerp(from.granular.grainSize, to.granular.grainSize);
+    result.granular.pitch = lerp(from.granular.pitch, to.granular.pitch);
+    result.granular.spray = lerp(from.granular.spray, to.granular.spray);
+    result.granular.position = lerp(from.granular.position, to.granular.position);
+
+    result.foley.level = lerp(from.foley.level, to.foley.level);
+
+    result.spatial.azimuth = lerp(from.spatial.azimuth, to.spatial.azimuth);
+    result.spatial.distance = lerp(from.spatial.distance, to.spatial.distance);
+    result.spatial.spread = lerp(from.spatial.spread, to.spatial.spread);
+    result.spatial.doppler = lerp(from.spatial.doppler, to.spatial.doppler);
+
+    result.limiter.ceilingDb = lerp(from.limiter.ceilingDb, to.limiter.ceilingDb);
+    result.limiter.releaseSeconds = lerp(from.limiter.releaseSeconds, to.limiter.releaseSeconds);
+}
+
 juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout()
 {
+    using Kind = ParameterDescriptor::Kind;
+
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
+    params.reserve(ParameterDescriptors::table.size());
+
+    for (const auto& descriptor : ParameterDescriptors::table)
+    {
+        switch (descriptor.kind)
+        {
+            case Kind::continuous:
+                params.push_back(std::make_unique<juce::AudioParameterFloat>(
+                    descriptor.id, descriptor.name, descriptor.range.toNormalisableRange(), descriptor.defaultValue));
+                break;
+
+            case Kind::choice:
+                params.push_back(std::make_unique<juce::AudioParameterChoice>(
+                    descriptor.id, descriptor.name, juce::StringArray::fromTokens(descriptor.choices, "|", ""),
+                    juce::roundToInt(descriptor.defaultValue)));
+                break;
 
-    // --- Hydraulic Hiss Parameters ---
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::hissLevel, "Hiss Level", ParameterRanges::gainRange(), 0.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::hissCutoff, "Hiss Cutoff", ParameterRanges::frequencyRange(100.0f, 18000.0f), 5000.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::hissResonance, "Hiss Resonance", ParameterRanges::qRange(), 1.0f));
-
-    // --- Servo Whine Parameters ---
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::servoLevel, "Servo Level", ParameterRanges::gainRange(), 0.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::servoPitch, "Servo Pitch", ParameterRanges::frequencyRange(50.0f, 5000.0f), 440.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::servoModDepth, "Servo Mod Depth", ParameterRanges::percentRange(), 0.1f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::servoModRate, "Servo Mod Rate", ParameterRanges::rateRange(0.1f, 30.0f), 1.0f));
-
-    // --- PowerCore Engine Parameters ---
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::powerCoreHumLevel, "Power Core Hum Level", ParameterRanges::gainRange(), 0.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::powerCoreFundamentalPitch, "Power Core Pitch", ParameterRanges::frequencyRange(20.0f, 200.0f), 60.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::powerCoreHumComplexity, "Power Core Complexity", ParameterRanges::percentRange(), 0.5f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::powerCorePulsationRate, "Power Core Pulsation Rate", ParameterRanges::rateRange(0.1f, 5.0f), 1.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::powerCorePulsationDepth, "Power Core Pulsation Depth", ParameterRanges::percentRange(), 0.3f));
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        ParameterIDs::powerCoreActivationTrigger, "Power Core Activation", false));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::powerCoreActivationTime, "Power Core Activation Time", ParameterRanges::timeRange(0.5f, 10.0f), 2.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::powerCoreEnergyType, "Power Core Energy Type", ParameterRanges::percentRange(), 0.5f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::powerCoreFilterCutoff, "Power Core Filter Cutoff", ParameterRanges::frequencyRange(100.0f, 10000.0f), 5000.0f));
-    // Corrected call to qRange for PowerCoreFilterResonance - using specific range for this parameter
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::powerCoreFilterResonance, "Power Core Filter Reso", ParameterRanges::qRange(0.1f, 10.0f, 0.01f, 0.7f), 1.0f));
-
-
-    // --- Master Parameters ---
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        ParameterIDs::masterGain, "Master Gain", ParameterRanges::gainRange(), 0.707f));
+            case Kind::toggle:
+                params.push_back(std::make_unique<juce::AudioParameterBool>(
+                    descriptor.id, descriptor.name, descriptor.defaultValue > 0.5f));
+                break;
+        }
+    }
 
     return { params.begin(), params.end() };
 }
@@ -5,43 +5,84 @@
 #include <juce_core/juce_core.h> // For juce::String
 #include <vector>               // For std::vector in createParameterLayout
 #include <memory>               // For std::unique_ptr in createParameterLayout
+#include <array>                // For ParameterSnapshot
 
-// Parameter IDs (existing)
+// Parameter IDs. Plain literals, so nothing is constructed at static-init time.
 namespace ParameterIDs
 {
-    const juce::String hissLevel("hissLevel");
-    const juce::String hissCutoff("hissCutoff");
-    const juce::String hissResonance("hissResonance");
-    const juce::String servoLevel("servoLevel");
-    const juce::String servoPitch("servoPitch");
-    const juce::String servoModDepth("servoModDepth");
-    const juce::String servoModRate("servoModRate");
-    const juce::String masterGain("masterGain");
+    inline constexpr const char* hissLevel = "hissLevel";
+    inline constexpr const char* hissCutoff = "hissCutoff";
+    inline constexpr const char* hissResonance = "hissResonance";
+    inline constexpr const char* hissColour = "hissColour";
+    inline constexpr const char* servoLevel = "servoLevel";
+    inline constexpr const char* servoPitch = "servoPitch";
+    inline constexpr const char* servoModDepth = "servoModDepth";
+    inline constexpr const char* servoModRate = "servoModRate";
+    inline constexpr const char* servoBankSize = "servoBankSize";
+    inline constexpr const char* masterGain = "masterGain";
 
     // PowerCore Parameter IDs
-    const juce::String powerCoreHumLevel("powerCoreHumLevel");
-    const juce::String powerCoreFundamentalPitch("powerCoreFundamentalPitch");
-    const juce::String powerCoreHumComplexity("powerCoreHumComplexity");
-    const juce::String powerCorePulsationRate("powerCorePulsationRate");
-    const juce::String powerCorePulsationDepth("powerCorePulsationDepth");
-    const juce::String powerCoreActivationTrigger("powerCoreActivationTrigger");
-    const juce::String powerCoreActivationTime("powerCoreActivationTime");
-    const juce::String powerCoreEnergyType("powerCoreEnergyType");
-    const juce::String powerCoreFilterCutoff("powerCoreFilterCutoff");
-    const juce::String powerCoreFilterResonance("powerCoreFilterResonance");
+    inline constexpr const char* powerCoreHumLevel = "powerCoreHumLevel";
+    inline constexpr const char* powerCoreFundamentalPitch = "powerCoreFundamentalPitch";
+    inline constexpr const char* powerCoreHumComplexity = "powerCoreHumComplexity";
+    inline constexpr const char* powerCorePulsationRate = "powerCorePulsationRate";
+    inline constexpr const char* powerCorePulsationDepth = "powerCorePulsationDepth";
+    inline constexpr const char* powerCoreActivationTrigger = "powerCoreActivationTrigger";
+    inline constexpr const char* powerCoreActivationTime = "powerCoreActivationTime";
+    inline constexpr const char* powerCoreEnergyType = "powerCoreEnergyType";
+    inline constexpr const char* powerCoreFilterCutoff = "powerCoreFilterCutoff";
+    inline constexpr const char* powerCoreFilterResonance = "powerCoreFilterResonance";
+
+    // Convolution Parameter IDs
+    inline constexpr const char* convolutionSpace = "convolutionSpace";
+    inline constexpr const char* convolutionMix = "convolutionMix";
+
+    // Granular Parameter IDs
+    inline constexpr const char* granularLevel = "granularLevel";
+    inline constexpr const char* granularDensity = "granularDensity";
+    inline constexpr const char* granularGrainSize = "granularGrainSize";
+    inline constexpr const char* granularPitch = "granularPitch";
+    inline constexpr const char* granularSpray = "granularSpray";
+    inline constexpr const char* granularPosition = "granularPosition";
+
+    // Foley Parameter IDs
+    inline constexpr const char* foleyLevel = "foleyLevel";
+
+    // Motion (per-engine spatializer) Parameter IDs
+    inline constexpr const char* spatialEnabled = "spatialEnabled";
+    inline constexpr const char* spatialAzimuth = "spatialAzimuth";
+    inline constexpr const char* spatialDistance = "spatialDistance";
+    inline constexpr const char* spatialSpread = "spatialSpread";
+    inline constexpr const char* spatialDoppler = "spatialDoppler";
+
+    // Master limiter Parameter IDs
+    inline constexpr const char* limiterEnabled = "limiterEnabled";
+    inline constexpr const char* limiterCeiling = "limiterCeiling";
+    inline constexpr const char* limiterRelease = "limiterRelease";
     // Add new ParameterIDs here for future engines if they are controlled by APVTS
 }
 
-// Parameter Ranges
+// Parameter Ranges (plain values, usable at compile time)
+struct ParameterRange
+{
+    float minimum = 0.0f;
+    float maximum = 1.0f;
+    float interval = 0.0f;
+    float skew = 1.0f;
+
+    juce::NormalisableRange<float> toNormalisableRange() const { return { minimum, maximum, interval, skew }; }
+};
+
 namespace ParameterRanges
 {
-    inline juce::NormalisableRange<float> gainRange() { return { 0.0f, 1.0f, 0.001f, 0.3f }; }
-    inline juce::NormalisableRange<float> percentRange() { return { 0.0f, 1.0f, 0.01f }; }
-    inline juce::NormalisableRange<float> frequencyRange(float min = 20.0f, float max = 20000.0f, float interval = 1.0f, float skew = 0.25f) { return { min, max, interval, skew }; }
-    // Modified qRange to accept min, max, interval, and skew, with defaults matching original.
-    inline juce::NormalisableRange<float> qRange(float min = 0.1f, float max = 18.0f, float interval = 0.01f, float skew = 0.25f) { return { min, max, interval, skew }; }
-    inline juce::NormalisableRange<float> rateRange(float min = 0.01f, float max = 20.0f, float interval = 0.01f, float skew = 0.3f) { return { min, max, interval, skew }; }
-    inline juce::NormalisableRange<float> timeRange(float min = 0.001f, float max = 10.0f, float interval = 0.001f, float skew = 0.4f) { return { min, max, interval, skew }; }
+    constexpr ParameterRange gainRange() { return { 0.0f, 1.0f, 0.001f, 0.3f }; }
+    constexpr ParameterRange percentRange() { return { 0.0f, 1.0f, 0.01f, 1.0f }; }
+    constexpr ParameterRange linearRange(float min, float max, float interval) { return { min, max, interval, 1.0f }; }
+    constexpr ParameterRange frequencyRange(float min = 20.0f, float max = 20000.0f, float interval = 1.0f, float skew = 0.25f) { return { min, max, interval, skew }; }
+    constexpr ParameterRange qRange(float min = 0.1f, float max = 18.0f, float interval = 0.01f, float skew = 0.25f) { return { min, max, interval, skew }; }
+    constexpr ParameterRange rateRange(float min = 0.01f, float max = 20.0f, float interval = 0.01f, float skew = 0.3f) { return { min, max, interval, skew }; }
+    constexpr ParameterRange timeRange(float min = 0.001f, float max = 10.0f, float interval = 0.001f, float skew = 0.4f) { return { min, max, interval, skew }; }
+    constexpr ParameterRange distanceRange(float min = 1.0f, float max = 100.0f, float interval = 0.01f, float skew = 0.3f) { return { min, max, interval, skew }; }
 }
 
 // Parameter structs for individual sound sources/engines
@@ -50,6 +91,7 @@ struct HissParams
     float level = 0.0f;
     float cutoff = 5000.0f;
     float resonanceQ = 1.0f;
+    int colour = 0; // NoiseColour: 0 white, 1 pink, 2 brown, 3 blue
 };
 
 struct ServoParams
@@ -58,6 +100,7 @@ struct ServoParams
     float pitch = 440.0f;
     float modDepth = 0.1f;
     float modRate = 1.0f;
+    int bankSize = 8; // Servos sounding in each ServoBankEngine, 1-16
 };
 
 struct ThrusterParams
@@ -88,6 +131,43 @@ struct PowerCoreParams
     float filterResonance = 1.0f;   // Default value, can be adjusted
 };
 
+struct ConvolutionParams
+{
+    int space = 0;     // ImpulseResponseLibrary::Space: 0 off, 1 metal hull, 2 cockpit, 3 hangar
+    float mix = 0.3f;  // Wet/dry
+};
+
+struct GranularParams
+{
+    float level = 0.0f;
+    float density = 30.0f;    // Grains per second
+    float grainSize = 0.05f;  // Seconds
+    float pitch = 0.0f;       // Semitones
+    float spray = 0.2f;       // Random spread of position and pitch, 0-1
+    float position = 0.5f;    // Read position in the source, 0-1
+};
+
+struct FoleyParams
+{
+    float level = 0.0f; // Streamed recording; the file itself is part of the plugin state
+};
+
+struct SpatialParams
+{
+    bool enabled = false;    // Off: engines are rendered in stereo as before
+    float azimuth = 0.0f;    // Degrees, -90 left to 90 right
+    float distance = 1.0f;   // Metres
+    float spread = 0.3f;     // Fans the engines out around the azimuth, 0-1
+    float doppler = 1.0f;    // Share of the propagation delay applied, 0-1
+};
+
+struct LimiterParams
+{
+    bool enabled = false;
+    float ceilingDb = -1.0f;      // True-peak ceiling, dBTP
+    float releaseSeconds = 0.1f;
+};
+
 struct MechanicalJointParams
 {
     int movementType = 0;
@@ -112,8 +192,225 @@ struct EngineParameterSet
     ThrusterParams thruster;
     PowerCoreParams powerCore;
     MechanicalJointParams joint;
+    ConvolutionParams convolution;
+    GranularParams granular;
+    FoleyParams foley;
+    SpatialParams spatial;
+    LimiterParams limiter; // Applied by the processor after masterGain, not by the engines
+};
+
+
+// Flat index of every APVTS parameter, in layout order.
+// Used wherever parameters are handled as a vector (morphing, interpolation).
+namespace ParameterIndex
+{
+    enum Index : int
+    {
+        hissLevel = 0,
+        hissCutoff,
+        hissResonance,
+        hissColour,
+        servoLevel,
+        servoPitch,
+        servoModDepth,
+        servoModRate,
+        servoBankSize,
+        powerCoreHumLevel,
+        powerCoreFundamentalPitch,
+        powerCoreHumComplexity,
+        powerCorePulsationRate,
+        powerCorePulsationDepth,
+        powerCoreActivationTrigger,
+        powerCoreActivationTime,
+        powerCoreEnergyType,
+        powerCoreFilterCutoff,
+        powerCoreFilterResonance,
+        convolutionSpace,
+        convolutionMix,
+        granularLevel,
+        granularDensity,
+        granularGrainSize,
+        granularPitch,
+        granularSpray,
+        granularPosition,
+        foleyLevel,
+        spatialEnabled,
+        spatialAzimuth,
+        spatialDistance,
+        spatialSpread,
+        spatialDoppler,
+        limiterEnabled,
+        limiterCeiling,
+        limiterRelease,
+        masterGain,
+        numParameters
+    };
+}
+
+// Compile-time description of one APVTS parameter.
+struct ParameterDescriptor
+{
+    enum class Kind
+    {
+        continuous,
+        choice,  // Plain value is the item index
+        toggle   // Plain value is 0 or 1
+    };
+
+    // Editor sections, in display order
+    enum class Section
+    {
+        hiss,
+        servo,
+        powerCore,
+        texture,
+        motion,
+        output
+    };
+
+    int index;             // ParameterIndex entry, checked against the table position below
+    const char* id;
+    const char* name;      // Shown by the host
+    const char* label;     // Shorter editor label
+    Section section;
+    Kind kind;
+    ParameterRange range;  // Continuous parameters only
+    float defaultValue;    // Plain value
+    const char* choices;   // Choice parameters only: items separated by '|'
 };
 
+// The parameter table, in ParameterIndex order. It is the single source for the
+// APVTS layout, the processor's cached value pointers and the editor controls;
+// a new parameter needs a ParameterIndex entry, a row here and its field in
+// EngineParameterSet (writeSnapshotToParameterSet and friends).
+namespace ParameterDescriptors
+{
+    using Kind = ParameterDescriptor::Kind;
+    using Section = ParameterDescriptor::Section;
+
+    constexpr ParameterDescriptor continuous(int index, const char* id, const char* name, const char* label,
+                                             Section section, ParameterRange range, float defaultValue)
+    {
+        return { index, id, name, label, section, Kind::continuous, range, defaultValue, nullptr };
+    }
+
+    constexpr ParameterDescriptor choice(int index, const char* id, const char* name, const char* label,
+                                         Section section, const char* choices, int defaultIndex)
+    {
+        return { index, id, name, label, section, Kind::choice, {}, static_cast<float>(defaultIndex), choices };
+    }
+
+    constexpr ParameterDescriptor toggle(int index, const char* id, const char* name, const char* label,
+                                         Section section, bool defaultValue)
+    {
+        return { index, id, name, label, section, Kind::toggle, {}, defaultValue ? 1.0f : 0.0f, nullptr };
+    }
+
+    namespace Index = ParameterIndex;
+    namespace Ranges = ParameterRanges;
+    namespace ID = ParameterIDs;
+
+    inline constexpr std::array<ParameterDescriptor, ParameterIndex::numParameters> table{ {
+        // --- Hydraulic Hiss ---
+        continuous(Index::hissLevel, ID::hissLevel, "Hiss Level", "Hiss Level", Section::hiss, Ranges::gainRange(), 0.0f),
+        continuous(Index::hissCutoff, ID::hissCutoff, "Hiss Cutoff", "Hiss Cutoff", Section::hiss, Ranges::frequencyRange(100.0f, 18000.0f), 5000.0f),
+        continuous(Index::hissResonance, ID::hissResonance, "Hiss Resonance", "Hiss Reso", Section::hiss, Ranges::qRange(), 1.0f),
+        choice(Index::hissColour, ID::hissColour, "Hiss Colour", "Hiss Colour", Section::hiss, "White|Pink|Brown|Blue", 0),
+
+        // --- Servo Whine ---
+        continuous(Index::servoLevel, ID::servoLevel, "Servo Level", "Servo Level", Section::servo, Ranges::gainRange(), 0.0f),
+        continuous(Index::servoPitch, ID::servoPitch, "Servo Pitch", "Servo Pitch", Section::servo, Ranges::frequencyRange(50.0f, 5000.0f), 440.0f),
+        continuous(Index::servoModDepth, ID::servoModDepth, "Servo Mod Depth", "Servo Mod Depth", Section::servo, Ranges::percentRange(), 0.1f),
+        continuous(Index::servoModRate, ID::servoModRate, "Servo Mod Rate", "Servo Mod Rate", Section::servo, Ranges::rateRange(0.1f, 30.0f), 1.0f),
+        choice(Index::servoBankSize, ID::servoBankSize, "Servo Bank Size", "Bank Servos", Section::servo, "1|2|3|4|5|6|7|8|9|10|11|12|13|14|15|16", 7),
+
+        // --- Power Core ---
+        continuous(Index::powerCoreHumLevel, ID::powerCoreHumLevel, "Power Core Hum Level", "PC Hum Level", Section::powerCore, Ranges::gainRange(), 0.0f),
+        continuous(Index::powerCoreFundamentalPitch, ID::powerCoreFundamentalPitch, "Power Core Pitch", "PC Pitch", Section::powerCore, Ranges::frequencyRange(20.0f, 200.0f), 60.0f),
+        continuous(Index::powerCoreHumComplexity, ID::powerCoreHumComplexity, "Power Core Complexity", "PC Complexity", Section::powerCore, Ranges::percentRange(), 0.5f),
+        continuous(Index::powerCorePulsationRate, ID::powerCorePulsationRate, "Power Core Pulsation Rate", "PC Pulse Rate", Section::powerCore, Ranges::rateRange(0.1f, 5.0f), 1.0f),
+        continuous(Index::powerCorePulsationDepth, ID::powerCorePulsationDepth, "Power Core Pulsation Depth", "PC Pulse Depth", Section::powerCore, Ranges::percentRange(), 0.3f),
+        toggle(Index::powerCoreActivationTrigger, ID::powerCoreActivationTrigger, "Power Core Activation", "PC Activation", Section::powerCore, false),
+        continuous(Index::powerCoreActivationTime, ID::powerCoreActivationTime, "Power Core Activation Time", "PC Act Time", Section::powerCore, Ranges::timeRange(0.5f, 10.0f), 2.0f),
+        continuous(Index::powerCoreEnergyType, ID::powerCoreEnergyType, "Power Core Energy Type", "PC Energy Type", Section::powerCore, Ranges::percentRange(), 0.5f),
+        continuous(Index::powerCoreFilterCutoff, ID::powerCoreFilterCutoff, "Power Core Filter Cutoff", "PC Filter Cutoff", Section::powerCore, Ranges::frequencyRange(100.0f, 10000.0f), 5000.0f),
+        continuous(Index::powerCoreFilterResonance, ID::powerCoreFilterResonance, "Power Core Filter Reso", "PC Filter Reso", Section::powerCore, Ranges::qRange(0.1f, 10.0f, 0.01f, 0.7f), 1.0f),
+
+        // --- Convolution (resonant space) ---
+        choice(Index::convolutionSpace, ID::convolutionSpace, "Space", "Space", Section::output, "Off|Metal Hull|Cockpit|Hangar", 0),
+        continuous(Index::convolutionMix, ID::convolutionMix, "Space Mix", "Space Mix", Section::output, Ranges::percentRange(), 0.3f),
+
+        // --- Granular Texture ---
+        continuous(Index::granularLevel, ID::granularLevel, "Grain Level", "Grain Level", Section::texture, Ranges::gainRange(), 0.0f),
+        continuous(Index::granularDensity, ID::granularDensity, "Grain Density", "Grain Density", Section::texture, Ranges::rateRange(1.0f, 200.0f, 0.1f, 0.4f), 30.0f),
+        continuous(Index::granularGrainSize, ID::granularGrainSize, "Grain Size", "Grain Size", Section::texture, Ranges::timeRange(0.005f, 0.25f, 0.001f, 0.5f), 0.05f),
+        continuous(Index::granularPitch, ID::granularPitch, "Grain Pitch", "Grain Pitch", Section::texture, Ranges::linearRange(-24.0f, 24.0f, 0.01f), 0.0f),
+        continuous(Index::granularSpray, ID::granularSpray, "Grain Spray", "Grain Spray", Section::texture, Ranges::percentRange(), 0.2f),
+        continuous(Index::granularPosition, ID::granularPosition, "Grain Position", "Grain Position", Section::texture, Ranges::percentRange(), 0.5f),
+
+        // --- Foley Playback ---
+        continuous(Index::foleyLevel, ID::foleyLevel, "Foley Level", "Foley Level", Section::texture, Ranges::gainRange(), 0.0f),
+
+        // --- Motion ---
+        toggle(Index::spatialEnabled, ID::spatialEnabled, "Motion", "Motion", Section::motion, false),
+        continuous(Index::spatialAzimuth, ID::spatialAzimuth, "Motion Azimuth", "Azimuth", Section::motion, Ranges::linearRange(-90.0f, 90.0f, 0.1f), 0.0f),
+        continuous(Index::spatialDistance, ID::spatialDistance, "Motion Distance", "Distance", Section::motion, Ranges::distanceRange(), 1.0f),
+        continuous(Index::spatialSpread, ID::spatialSpread, "Motion Spread", "Spread", Section::motion, Ranges::percentRange(), 0.3f),
+        continuous(Index::spatialDoppler, ID::spatialDoppler, "Motion Doppler", "Doppler", Section::motion, Ranges::percentRange(), 1.0f),
+
+        // --- Master Limiter ---
+        toggle(Index::limiterEnabled, ID::limiterEnabled, "Limiter", "Limiter", Section::output, false),
+        continuous(Index::limiterCeiling, ID::limiterCeiling, "Limiter Ceiling", "Ceiling", Section::output, Ranges::linearRange(-12.0f, 0.0f, 0.1f), -1.0f),
+        continuous(Index::limiterRelease, ID::limiterRelease, "Limiter Release", "Release", Section::output, Ranges::timeRange(0.01f, 1.0f, 0.001f, 0.5f), 0.1f),
+
+        // --- Master ---
+        continuous(Index::masterGain, ID::masterGain, "Master Gain", "Master Gain", Section::output, Ranges::gainRange(), 0.707f)
+    } };
+
+    constexpr bool isInIndexOrder()
+    {
+        for (size_t i = 0; i < table.size(); ++i)
+            if (table[i].index != static_cast<int>(i) || table[i].id == nullptr)
+                return false;
+        return true;
+    }
+
+    static_assert(isInIndexOrder(), "Every ParameterIndex entry needs its row, in enum order");
+}
+
+// One value per ParameterIndex entry. Whether the values are plain or
+// normalised (0-1) is up to the owner.
+using ParameterSnapshot = std::array<float, ParameterIndex::numParameters>;
+
+// Returns the APVTS parameter ID for a ParameterIndex entry.
+inline const char* getParameterID(int parameterIndex) noexcept
+{
+    jassert(parameterIndex >= 0 && parameterIndex < ParameterIndex::numParameters);
+    return ParameterDescriptors::table[static_cast<size_t>(parameterIndex)].id;
+}
+
+// False for the parameters the morph pad leaves at their host values: the master
+// limiter protects the output whatever the pad does, so it is neither stored in
+// morph snapshots nor morphed.
+inline constexpr bool isMorphable(int parameterIndex) noexcept
+{
+    return parameterIndex != ParameterIndex::limiterEnabled
+        && parameterIndex != ParameterIndex::limiterCeiling
+        && parameterIndex != ParameterIndex::limiterRelease;
+}
+
+// Copies plain (unnormalised) snapshot values into the engine parameter set.
+void writeSnapshotToParameterSet(const ParameterSnapshot& plainValues, EngineParameterSet& params, float& masterGain);
+
+// Field of a continuous parameter in the engine parameter set, or nullptr for
+// discrete ones (choices, triggers), for masterGain, which is not part of the set,
+// and for the limiter settings, which the master limiter reads from the APVTS.
+float* getContinuousParameter(EngineParameterSet& params, int parameterIndex) noexcept;
+
+// Linear interpolation between two parameter sets (position 0 = 'from', 1 = 'to').
+// Discrete values (triggers, choices) switch to 'to' immediately.
+void interpolateParameterSet(const EngineParameterSet& from, const EngineParameterSet& to, float position, EngineParameterSet& result);
+
 
 // Declaration for the layout creation function
 juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
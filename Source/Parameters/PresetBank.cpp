@@ -0,0 +1,166 @@
+// Source/Parameters/PresetBank.cpp
+#include "../Source/Parameters/PresetBank.h"
+
+PresetBank::PresetBank()
+{
+    addFactoryPresets();
+}
+
+const PresetSnapshot& PresetBank::getPreset(int index) const noexcept
+{
+    jassert(isValidIndex(index));
+    return presets[static_cast<size_t>(index)];
+}
+
+void PresetBank::setPresetName(int index, const juce::String& newName)
+{
+    if (isValidIndex(index))
+        presets[static_cast<size_t>(index)].name = newName;
+}
+
+void PresetBank::applyToState(const PresetSnapshot& preset, juce::AudioProcessorValueTreeState& apvts)
+{
+    auto setParam = [&apvts](const juce::String& paramID, float value)
+    {
+        if (auto* param = apvts.getParameter(paramID))
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+    };
+
+    const auto& p = preset.params;
+
+    setParam(ParameterIDs::hissLevel, p.hiss.level);
+    setParam(ParameterIDs::hissCutoff, p.hiss.cutoff);
+    setParam(ParameterIDs::hissResonance, p.hiss.resonanceQ);
+    setParam(ParameterIDs::hissColour, static_cast<float>(p.hiss.colour));
+
+    setParam(ParameterIDs::servoLevel, p.servo.level);
+    setParam(ParameterIDs::servoPitch, p.servo.pitch);
+    setParam(ParameterIDs::servoModDepth, p.servo.modDepth);
+    setParam(ParameterIDs::servoModRate, p.servo.modRate);
+
+    setParam(ParameterIDs::powerCoreHumLevel, p.powerCore.humLevel);
+    setParam(ParameterIDs::powerCoreFundamentalPitch, p.powerCore.fundamentalPitch);
+    setParam(ParameterIDs::powerCoreHumComplexity, p.powerCore.humComplexity);
+    setParam(ParameterIDs::powerCorePulsationRate, p.powerCore.pulsationRate);
+    setParam(ParameterIDs::powerCorePulsationDepth, p.powerCore.pulsationDepth);
+    setParam(ParameterIDs::powerCoreActivationTrigger, p.powerCore.activationTrigger ? 1.0f : 0.0f);
+    setParam(ParameterIDs::powerCoreActivationTime, p.powerCore.activationTime);
+    setParam(ParameterIDs::powerCoreEnergyType, p.powerCore.energyType);
+    setParam(ParameterIDs::powerCoreFilterCutoff, p.powerCore.filterCutoff);
+    setParam(ParameterIDs::powerCoreFilterResonance, p.powerCore.filterResonance);
+
+    setParam(ParameterIDs::convolutionSpace, static_cast<float>(p.convolution.space));
+    setParam(ParameterIDs::convolutionMix, p.convolution.mix);
+
+    setParam(ParameterIDs::granularLevel, p.granular.level);
+    setParam(ParameterIDs::granularDensity, p.granular.density);
+    setParam(ParameterIDs::granularGrainSize, p.granular.grainSize);
+    setParam(ParameterIDs::granularPitch, p.granular.pitch);
+    setParam(ParameterIDs::granularSpray, p.granular.spray);
+    setParam(ParameterIDs::granularPosition, p.granular.position);
+
+    setParam(ParameterIDs::foleyLevel, p.foley.level);
+
+    setParam(ParameterIDs::spatialEnabled, p.spatial.enabled ? 1.0f : 0.0f);
+    setParam(ParameterIDs::spatialAzimuth, p.spatial.azimuth);
+    setParam(ParameterIDs::spatialDistance, p.spatial.distance);
+    setParam(ParameterIDs::spatialSpread, p.spatial.spread);
+    setParam(ParameterIDs::spatialDoppler, p.spatial.doppler);
+
+    // The limiter, like masterGain, belongs to the output stage and survives program changes
+}
+
+void PresetBank::addFactoryPresets()
+{
+    // Default program mirrors the parameter layout defaults.
+    {
+        PresetSnapshot preset;
+        preset.name = "Init";
+        presets.push_back(preset);
+    }
+
+    // Standby: faint hydraulic hiss, core idling at low level.
+    {
+        PresetSnapshot preset;
+        preset.name = "Standby";
+        preset.params.hiss = { 0.05f, 2500.0f, 0.7f, 2 }; // Brown: low hydraulic rumble
+        preset.params.powerCore.humLevel = 0.2f;
+        preset.params.powerCore.fundamentalPitch = 45.0f;
+        preset.params.powerCore.humComplexity = 0.2f;
+        preset.params.powerCore.pulsationRate = 0.3f;
+        preset.params.powerCore.pulsationDepth = 0.5f;
+        preset.params.powerCore.activationTrigger = true;
+        preset.params.powerCore.activationTime = 3.0f;
+        preset.params.powerCore.energyType = 0.2f;
+        preset.params.powerCore.filterCutoff = 800.0f;
+        preset.params.powerCore.filterResonance = 0.8f;
+        preset.params.convolution = { 3, 0.25f }; // Parked in the hangar
+        presets.push_back(preset);
+    }
+
+    // Power Core Online: full hum with harmonics, steady pulsation.
+    {
+        PresetSnapshot preset;
+        preset.name = "Power Core Online";
+        preset.params.hiss = { 0.08f, 6000.0f, 1.0f };
+        preset.params.powerCore.humLevel = 0.6f;
+        preset.params.powerCore.fundamentalPitch = 60.0f;
+        preset.params.powerCore.humComplexity = 0.7f;
+        preset.params.powerCore.pulsationRate = 1.5f;
+        preset.params.powerCore.pulsationDepth = 0.3f;
+        preset.params.powerCore.activationTrigger = true;
+        preset.params.powerCore.activationTime = 1.0f;
+        preset.params.powerCore.energyType = 0.5f;
+        preset.params.powerCore.filterCutoff = 3000.0f;
+        preset.params.powerCore.filterResonance = 1.2f;
+        presets.push_back(preset);
+    }
+
+    // Servo Articulation: prominent servo whine over a quiet core.
+    {
+        PresetSnapshot preset;
+        preset.name = "Servo Articulation";
+        preset.params.hiss = { 0.1f, 8000.0f, 2.0f };
+        preset.params.servo = { 0.4f, 880.0f, 0.15f, 4.0f };
+        preset.params.powerCore.humLevel = 0.15f;
+        preset.params.powerCore.activationTrigger = true;
+        preset.params.powerCore.filterCutoff = 1500.0f;
+        preset.params.convolution = { 1, 0.35f }; // Ringing through the hull
+        preset.params.granular = { 0.15f, 25.0f, 0.04f, 0.0f, 0.3f, 0.4f }; // Gear grind under the whine
+        presets.push_back(preset);
+    }
+
+    // Combat Ready: aggressive core, fast pulsation, bright servo and hiss.
+    {
+        PresetSnapshot preset;
+        preset.name = "Combat Ready";
+        preset.params.hiss = { 0.15f, 12000.0f, 3.0f };
+        preset.params.servo = { 0.3f, 1200.0f, 0.3f, 8.0f };
+        preset.params.powerCore.humLevel = 0.8f;
+        preset.params.powerCore.fundamentalPitch = 90.0f;
+        preset.params.powerCore.humComplexity = 1.0f;
+        preset.params.powerCore.pulsationRate = 4.0f;
+        preset.params.powerCore.pulsationDepth = 0.6f;
+        preset.params.powerCore.activationTrigger = true;
+        preset.params.powerCore.activationTime = 0.5f;
+        preset.params.powerCore.energyType = 0.9f;
+        preset.params.powerCore.filterCutoff = 7000.0f;
+        preset.params.powerCore.filterResonance = 2.5f;
+        preset.params.convolution = { 2, 0.2f }; // Heard from the cockpit
+        preset.params.granular = { 0.25f, 90.0f, 0.02f, 5.0f, 0.5f, 0.7f }; // Hydraulic chatter
+        presets.push_back(preset);
+    }
+
+    // Shutdown: core deactivating, hiss venting.
+    {
+        PresetSnapshot preset;
+        preset.name = "Shutdown";
+        preset.params.hiss = { 0.25f, 4000.0f, 0.5f, 1 }; // Pink: venting steam
+        preset.params.powerCore.humLevel = 0.5f;
+        preset.params.powerCore.fundamentalPitch = 40.0f;
+        preset.params.powerCore.activationTrigger = false;
+        preset.params.powerCore.activationTime = 4.0f;
+        preset.params.powerCore.filterCutoff = 600.0f;
+        presets.push_back(preset);
+    }
+}
@@ -0,0 +1,55 @@
+// Source/Parameters/PresetBank.h
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <vector>
+#include "../Source/Parameters/Parameters.h" // For EngineParameterSet
+
+//==============================================================================
+/*
+    A single program in the bank: a display name plus a fully prepared
+    EngineParameterSet. Snapshots are plain structs so the audio thread can
+    copy them by value without allocating.
+*/
+struct PresetSnapshot
+{
+    juce::String name;
+    EngineParameterSet params;
+};
+
+//==============================================================================
+/*
+    In-memory bank of programs.
+
+    The bank is filled on the message thread (factory presets in the
+    constructor) and is never resized afterwards, so the audio thread may read
+    any snapshot by index without locking.
+*/
+class PresetBank
+{
+public:
+    PresetBank();
+
+    int getNumPresets() const noexcept { return static_cast<int>(presets.size()); }
+
+    /** @brief Returns the snapshot for 'index'. The index must be valid. */
+    const PresetSnapshot& getPreset(int index) const noexcept;
+
+    /** @brief Returns true if 'index' refers to an existing preset. */
+    bool isValidIndex(int index) const noexcept { return index >= 0 && index < getNumPresets(); }
+
+    /** @brief Renames a preset. Message thread only. */
+    void setPresetName(int index, const juce::String& newName);
+
+    /** @brief Writes a snapshot into the APVTS so the host and editor follow the program change.
+        Must be called from the message thread.
+    */
+    static void applyToState(const PresetSnapshot& preset, juce::AudioProcessorValueTreeState& apvts);
+
+private:
+    void addFactoryPresets();
+
+    std::vector<PresetSnapshot> presets;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
@@ -4,6 +4,51 @@
 // Parameters.h is included via PluginProcessor.h
 // MechaSoundEngine.h is included via PluginProcessor.h
 
+namespace
+{
+    const juce::Identifier noiseSeedProperty{ "noiseSeed" };
+    const juce::Identifier engineLayoutProperty{ "engines" };
+    const juce::Identifier foleyFileProperty{ "foleyFile" };
+    const juce::Identifier grainSourceFileProperty{ "grainSourceFile" };
+
+    juce::String toLayoutString(const std::vector<MechaSoundEngine::EngineType>& layout)
+    {
+        juce::StringArray names;
+        for (const auto type : layout)
+            names.add(MechaSoundEngine::getEngineTypeName(type));
+        return names.joinIntoString(",");
+    }
+
+    // Classifies what changed between two consecutive parameter sets, for the latency histogram.
+    juce::uint32 detectParameterEvents(const EngineParameterSet& previous, const EngineParameterSet& current)
+    {
+        constexpr int powerCoreHarmonicSteps = 5; // PowerCoreEngine::MAX_HARMONICS
+        juce::uint32 events = ParameterEvent::none;
+
+        if (previous.powerCore.activationTrigger != current.powerCore.activationTrigger)
+            events |= ParameterEvent::activationToggle;
+
+        if (static_cast<int>(previous.powerCore.humComplexity * powerCoreHarmonicSteps)
+            != static_cast<int>(current.powerCore.humComplexity * powerCoreHarmonicSteps))
+            events |= ParameterEvent::complexityJump;
+
+        if (previous.powerCore.filterCutoff != current.powerCore.filterCutoff
+            || previous.hiss.cutoff != current.hiss.cutoff)
+            events |= ParameterEvent::filterSweep;
+
+        if (previous.hiss.level != current.hiss.level || previous.hiss.resonanceQ != current.hiss.resonanceQ
+            || previous.hiss.colour != current.hiss.colour)
+            events |= ParameterEvent::hissChange;
+
+        if (previous.servo.level != current.servo.level || previous.servo.pitch != current.servo.pitch
+            || previous.servo.modDepth != current.servo.modDepth || previous.servo.modRate != current.servo.modRate
+            || previous.servo.bankSize != current.servo.bankSize)
+            events |= ParameterEvent::servoChange;
+
+        return events;
+    }
+}
+
 //==============================================================================
 MechaSoundGeneratorAudioProcessor::MechaSoundGeneratorAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -20,38 +65,22 @@ MechaSoundGeneratorAudioProcessor::MechaSoundGeneratorAudioProcessor()
 #endif
 apvts(*this, nullptr, "MechaSoundParams", createParameterLayout())
 {
-    // Cache the raw parameter pointers from APVTS
-    hissLevelParam = apvts.getRawParameterValue(ParameterIDs::hissLevel);
-    hissCutoffParam = apvts.getRawParameterValue(ParameterIDs::hissCutoff);
-    hissResonanceParam = apvts.getRawParameterValue(ParameterIDs::hissResonance);
-
-    servoLevelParam = apvts.getRawParameterValue(ParameterIDs::servoLevel);
-    servoPitchParam = apvts.getRawParameterValue(ParameterIDs::servoPitch);
-    servoModDepthParam = apvts.getRawParameterValue(ParameterIDs::servoModDepth);
-    servoModRateParam = apvts.getRawParameterValue(ParameterIDs::servoModRate);
-
-    // Initialize PowerCore parameter pointers
-    powerCoreHumLevelParam = apvts.getRawParameterValue(ParameterIDs::powerCoreHumLevel);
-    powerCoreFundamentalPitchParam = apvts.getRawParameterValue(ParameterIDs::powerCoreFundamentalPitch);
-    powerCoreHumComplexityParam = apvts.getRawParameterValue(ParameterIDs::powerCoreHumComplexity);
-    powerCorePulsationRateParam = apvts.getRawParameterValue(ParameterIDs::powerCorePulsationRate);
-    powerCorePulsationDepthParam = apvts.getRawParameterValue(ParameterIDs::powerCorePulsationDepth);
-    // Corrected: AudioParameterBool uses a float internally (0.0 or 1.0). getRawParameterValue returns std::atomic<float>*.
-    // No cast to std::atomic<bool>* is needed or correct here.
-    powerCoreActivationTriggerParam = apvts.getRawParameterValue(ParameterIDs::powerCoreActivationTrigger);
-    powerCoreActivationTimeParam = apvts.getRawParameterValue(ParameterIDs::powerCoreActivationTime);
-    powerCoreEnergyTypeParam = apvts.getRawParameterValue(ParameterIDs::powerCoreEnergyType);
-    powerCoreFilterCutoffParam = apvts.getRawParameterValue(ParameterIDs::powerCoreFilterCutoff);
-    powerCoreFilterResonanceParam = apvts.getRawParameterValue(ParameterIDs::powerCoreFilterResonance);
-
-    masterGainParam = apvts.getRawParameterValue(ParameterIDs::masterGain);
-
-    jassert(hissLevelParam != nullptr && hissCutoffParam != nullptr && hissResonanceParam != nullptr);
-    jassert(servoLevelParam != nullptr && servoPitchParam != nullptr && servoModDepthParam != nullptr && servoModRateParam != nullptr);
-    jassert(powerCoreHumLevelParam != nullptr && powerCoreFundamentalPitchParam != nullptr && powerCoreHumComplexityParam != nullptr &&
-        powerCorePulsationRateParam != nullptr && powerCorePulsationDepthParam != nullptr && powerCoreActivationTriggerParam != nullptr &&
-        powerCoreActivationTimeParam != nullptr && powerCoreEnergyTypeParam != nullptr && powerCoreFilterCutoffParam != nullptr && powerCoreFilterResonanceParam != nullptr);
-    jassert(masterGainParam != nullptr);
+    // Cache the raw parameter pointers from APVTS, in ParameterIndex order
+    for (const auto& descriptor : ParameterDescriptors::table)
+    {
+        parameterValues[static_cast<size_t>(descriptor.index)] = apvts.getRawParameterValue(descriptor.id);
+        jassert(parameterValues[static_cast<size_t>(descriptor.index)] != nullptr);
+    }
+
+    for (auto& engine : engineSlots)
+    {
+        engine.setImpulseResponseLibrary(&impulseResponses);
+        engine.setSamplePrefetchThread(&samplePrefetch);
+        engine.getModulationMatrix().attachToParameters(apvts);
+    }
+
+    morpher.attachToParameters(apvts);
+    setNoiseSeed(-1);
 }
 
 MechaSoundGeneratorAudioProcessor::~MechaSoundGeneratorAudioProcessor() noexcept
@@ -93,33 +122,43 @@ bool MechaSoundGeneratorAudioProcessor::isMidiEffect() const
 
 double MechaSoundGeneratorAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // The convolution spaces ring on after the input stops
+    return ImpulseResponseLibrary::maxLengthSeconds;
 }
 
 int MechaSoundGeneratorAudioProcessor::getNumPrograms()
 {
-    return 1;
+    return presetBank.getNumPresets();
 }
 
 int MechaSoundGeneratorAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram;
 }
 
 void MechaSoundGeneratorAudioProcessor::setCurrentProgram(int index)
 {
-    juce::ignoreUnused(index);
+    if (!presetBank.isValidIndex(index))
+        return;
+
+    currentProgram = index;
+
+    // Publish the program to the audio thread before touching the APVTS. processBlock
+    // gathers parameters before it checks for a pending program, so any new value it
+    // reads implies the pending index is already visible and the outgoing engine keeps
+    // its previous parameters.
+    pendingProgramIndex.store(index);
+    PresetBank::applyToState(presetBank.getPreset(index), apvts);
 }
 
 const juce::String MechaSoundGeneratorAudioProcessor::getProgramName(int index)
 {
-    juce::ignoreUnused(index);
-    return {};
+    return presetBank.isValidIndex(index) ? presetBank.getPreset(index).name : juce::String();
 }
 
 void MechaSoundGeneratorAudioProcessor::changeProgramName(int index, const juce::String& newName)
 {
-    juce::ignoreUnused(index, newName);
+    presetBank.setPresetName(index, newName);
 }
 
 //==============================================================================
@@ -130,13 +169,52 @@ void MechaSoundGeneratorAudioProcessor::prepareToPlay(double sampleRate, int sam
     spec.maximumBlockSize = (juce::uint32)samplesPerBlock;
     spec.numChannels = (juce::uint32)getTotalNumOutputChannels();
 
-    mechaSoundEngine.prepare(spec);
+    // An export reads the current kernels, which prepare() may rebuild
+    exporter.cancel();
+    impulseResponses.prepare(sampleRate);
+
+    for (auto& engine : engineSlots)
+    {
+        engine.setNonRealtime(isNonRealtime());
+        engine.prepare(spec);
+    }
+
+    morpher.prepare(sampleRate);
+
+    // Hosts switch precision before calling prepareToPlay, so only the buffer in use is allocated.
+    // Blocks larger than announced are crossfaded in chunks, so the size is never trusted blindly.
+    const int crossfadeChunkSize = juce::jmax(samplesPerBlock, static_cast<int>(MechaSoundEngine::subBlockSize));
+    if (isUsingDoublePrecision())
+    {
+        crossfadeBufferDouble.setSize(static_cast<int>(spec.numChannels), crossfadeChunkSize);
+        crossfadeBuffer.setSize(0, 0);
+    }
+    else
+    {
+        crossfadeBuffer.setSize(static_cast<int>(spec.numChannels), crossfadeChunkSize);
+        crossfadeBufferDouble.setSize(0, 0);
+    }
+    crossfadeLengthSamples = juce::jmax(1, juce::roundToInt(sampleRate * programCrossfadeSeconds));
+    crossfadeSamplesRemaining = 0;
+    freeRunningPosition = 0.0;
+    latencyHistogram.reset();
+    spectrumAnalyser.prepare(sampleRate);
+    telemetry.prepare(sampleRate);
+
+    // Constant whether the limiter is on or not, so switching it never moves the audio
+    limiter.prepare(spec);
+    setLatencySamples(limiter.getLatencySamples());
+
     releaseResources();
 }
 
 void MechaSoundGeneratorAudioProcessor::releaseResources()
 {
-    mechaSoundEngine.reset();
+    for (auto& engine : engineSlots)
+        engine.reset();
+
+    limiter.reset();
+    crossfadeSamplesRemaining = 0;
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -161,8 +239,35 @@ bool MechaSoundGeneratorAudioProcessor::isBusesLayoutSupported(const BusesLayout
 #endif
 
 void MechaSoundGeneratorAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockInternal(buffer, midiMessages);
+}
+
+void MechaSoundGeneratorAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockInternal(buffer, midiMessages);
+}
+
+bool MechaSoundGeneratorAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType>& MechaSoundGeneratorAudioProcessor::getCrossfadeBuffer() noexcept
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return crossfadeBufferDouble;
+    else
+        return crossfadeBuffer;
+}
+
+template <typename SampleType>
+void MechaSoundGeneratorAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    const auto blockStartTicks = juce::Time::getHighResolutionTicks();
+
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -174,36 +279,208 @@ void MechaSoundGeneratorAudioProcessor::processBlock(juce::AudioBuffer<float>& b
 
 
     EngineParameterSet currentParams;
+    float currentMasterGain = 1.0f;
+    gatherParameters(currentParams, currentMasterGain);
+
+    // While the morph pad is enabled it replaces the host values for the whole set.
+    juce::uint32 blockEvents = morpher.process(currentParams, currentMasterGain, buffer.getNumSamples())
+                                   ? ParameterEvent::morphActive : ParameterEvent::none;
+    // Compared with the previous block's host values, not with what the live engine ran:
+    // during a program crossfade that is the incoming snapshot
+    blockEvents |= detectParameterEvents(lastBlockParams, currentParams);
+    lastBlockParams = currentParams;
+
+    // Program changes are picked up only once the previous crossfade has finished.
+    // Parameters were gathered above, before this check (see setCurrentProgram).
+    if (crossfadeSamplesRemaining == 0)
+    {
+        const int newProgram = pendingProgramIndex.exchange(-1);
+        if (presetBank.isValidIndex(newProgram))
+        {
+            beginProgramCrossfade(newProgram);
+            blockEvents |= ParameterEvent::programChange;
+        }
+    }
 
-    currentParams.hiss.level = hissLevelParam->load();
-    currentParams.hiss.cutoff = hissCutoffParam->load();
-    currentParams.hiss.resonanceQ = hissResonanceParam->load();
+    // Hosts may switch to offline bouncing without preparing again; a plain atomic store
+    for (auto& engine : engineSlots)
+        engine.setNonRealtime(isNonRealtime());
 
-    currentParams.servo.level = servoLevelParam->load();
-    currentParams.servo.pitch = servoPitchParam->load();
-    currentParams.servo.modDepth = servoModDepthParam->load();
-    currentParams.servo.modRate = servoModRateParam->load();
+    // Both slots follow the timeline; the one that is not processed only dispatches its events
+    const auto transport = readTransport(buffer.getNumSamples());
+    for (auto& engine : engineSlots)
+        engine.setTransport(transport);
 
-    currentParams.powerCore.humLevel = powerCoreHumLevelParam->load();
-    currentParams.powerCore.fundamentalPitch = powerCoreFundamentalPitchParam->load();
-    currentParams.powerCore.humComplexity = powerCoreHumComplexityParam->load();
-    currentParams.powerCore.pulsationRate = powerCorePulsationRateParam->load();
-    currentParams.powerCore.pulsationDepth = powerCorePulsationDepthParam->load();
-    // For AudioParameterBool, load() returns float (0.0f or 1.0f). Convert to bool.
-    currentParams.powerCore.activationTrigger = powerCoreActivationTriggerParam->load() > 0.5f;
-    currentParams.powerCore.activationTime = powerCoreActivationTimeParam->load();
-    currentParams.powerCore.energyType = powerCoreEnergyTypeParam->load();
-    currentParams.powerCore.filterCutoff = powerCoreFilterCutoffParam->load();       // This line should now be fine
-    currentParams.powerCore.filterResonance = powerCoreFilterResonanceParam->load(); // This line should now be fine
+    auto& liveEngine = engineSlots[static_cast<size_t>(liveEngineSlot)];
+    liveEngine.setSpectrumAnalyser(&spectrumAnalyser);
+    engineSlots[static_cast<size_t>(1 - liveEngineSlot)].setSpectrumAnalyser(nullptr);
 
-    mechaSoundEngine.process(buffer, currentParams);
+    juce::dsp::AudioBlock<SampleType> outputBlock(buffer);
+    const size_t numSamples = outputBlock.getNumSamples();
+    size_t position = 0;
 
-    const float currentMasterGain = masterGainParam->load();
-    buffer.applyGain(currentMasterGain);
+    if (crossfadeSamplesRemaining > 0)
+    {
+        auto& fadingEngine = engineSlots[static_cast<size_t>(1 - liveEngineSlot)];
+
+        // The crossfade buffer keeps the size it got in prepareToPlay; longer host
+        // blocks are faded in chunks of that size instead of reallocating.
+        juce::dsp::AudioBlock<SampleType> fadeBlock(getCrossfadeBuffer<SampleType>());
+        const size_t numFadeChannels = juce::jmin(outputBlock.getNumChannels(), fadeBlock.getNumChannels());
+        const auto length = static_cast<SampleType>(crossfadeLengthSamples);
+
+        while (crossfadeSamplesRemaining > 0 && position < numSamples && fadeBlock.getNumSamples() > 0)
+        {
+            const size_t chunk = juce::jmin(fadeBlock.getNumSamples(), numSamples - position,
+                                            static_cast<size_t>(crossfadeSamplesRemaining));
+            auto liveChunk = outputBlock.getSubBlock(position, chunk);
+            auto fadeChunk = fadeBlock.getSubBlock(0, chunk);
+            fadeChunk.clear();
+
+            fadingEngine.process(fadeChunk, fadingEngineParams);
+            liveEngine.process(liveChunk, crossfadeTargetParams);
+
+            // Linear crossfade: the live engine ramps in while the outgoing one ramps out
+            const int fadePosition = crossfadeLengthSamples - crossfadeSamplesRemaining;
+            for (size_t channel = 0; channel < numFadeChannels; ++channel)
+            {
+                auto* live = liveChunk.getChannelPointer(channel);
+                const auto* fading = fadeChunk.getChannelPointer(channel);
+
+                for (size_t sample = 0; sample < chunk; ++sample)
+                {
+                    const auto gain = static_cast<SampleType>(fadePosition + static_cast<int>(sample)) / length;
+                    live[sample] = live[sample] * gain + fading[sample] * (SampleType(1) - gain);
+                }
+            }
+
+            position += chunk;
+            crossfadeSamplesRemaining -= static_cast<int>(chunk);
+        }
+
+        // Anything after the fade in this block stays on the incoming snapshot
+        if (position < numSamples)
+        {
+            liveEngine.process(outputBlock.getSubBlock(position, numSamples - position), crossfadeTargetParams);
+            fadingEngine.advanceTimeline(numSamples - position);
+        }
+
+        lastLiveParams = crossfadeTargetParams;
+    }
+    else
+    {
+        liveEngine.process(outputBlock, currentParams);
+        engineSlots[static_cast<size_t>(1 - liveEngineSlot)].advanceTimeline(numSamples);
+        lastLiveParams = currentParams;
+    }
+
+    buffer.applyGain(static_cast<SampleType>(currentMasterGain));
+
+    // Both crossfade paths end here, so one limiter covers them
+    limiter.setParameters(currentParams.limiter);
+    limiter.process(outputBlock);
+
+    spectrumAnalyser.push(SpectrumAnalyser::masterTap, outputBlock);
+
+    const auto elapsedTicks = juce::Time::getHighResolutionTicks() - blockStartTicks;
+    const double blockMicroseconds = juce::Time::highResolutionTicksToSeconds(elapsedTicks) * 1.0e6;
+    latencyHistogram.record(blockMicroseconds, blockEvents);
+
+    if (telemetry.isPublishing())
+    {
+        SampleType outputPeak = 0;
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            outputPeak = juce::jmax(outputPeak, buffer.getMagnitude(channel, 0, buffer.getNumSamples()));
+
+        telemetry.publishBlock(blockMicroseconds, buffer.getNumSamples(), liveEngine.getNumActiveEngines(), static_cast<float>(outputPeak));
+    }
 
     juce::ignoreUnused(midiMessages);
 }
 
+void MechaSoundGeneratorAudioProcessor::gatherParameters(EngineParameterSet& params, float& masterGain) const noexcept
+{
+    // One contiguous pass over the cached pointers; the values are independent,
+    // so relaxed loads are enough
+    ParameterSnapshot plainValues;
+    for (size_t i = 0; i < plainValues.size(); ++i)
+        plainValues[i] = parameterValues[i]->load(std::memory_order_relaxed);
+
+    writeSnapshotToParameterSet(plainValues, params, masterGain);
+}
+
+TransportState MechaSoundGeneratorAudioProcessor::readTransport(int numSamples)
+{
+    TransportState transport;
+
+    if (auto* playHead = getPlayHead())
+    {
+        if (const auto position = playHead->getPosition())
+        {
+            if (const auto ppq = position->getPpqPosition())
+            {
+                transport.isPlaying = position->getIsPlaying();
+                transport.ppqPosition = *ppq;
+                if (const auto bpm = position->getBpm())
+                    transport.bpm = *bpm;
+
+                lastTransportPosition.store(transport.ppqPosition);
+                lastTransportBpm.store(transport.bpm);
+                return transport;
+            }
+        }
+    }
+
+    // No host timeline (e.g. the standalone app): run a free clock at the default tempo
+    transport.isPlaying = true;
+    transport.ppqPosition = freeRunningPosition;
+    if (getSampleRate() > 0.0)
+        freeRunningPosition += numSamples * transport.bpm / (60.0 * getSampleRate());
+
+    lastTransportPosition.store(transport.ppqPosition);
+    lastTransportBpm.store(transport.bpm);
+    return transport;
+}
+
+bool MechaSoundGeneratorAudioProcessor::scheduleTimelineEvent(const TimelineEvent& event)
+{
+    // Both slots keep the same timeline so a program change does not lose events
+    bool scheduled = true;
+    for (auto& engine : engineSlots)
+        scheduled = engine.scheduleEvent(event) && scheduled;
+
+    // Kept for exports, which can queue no more than one FIFO's worth up front
+    if (scheduled)
+    {
+        scheduledEvents.push_back(event);
+        if (static_cast<int>(scheduledEvents.size()) > EventTimeline::fifoSize)
+            scheduledEvents.erase(scheduledEvents.begin());
+    }
+    return scheduled;
+}
+
+void MechaSoundGeneratorAudioProcessor::clearTimeline()
+{
+    scheduledEvents.clear();
+    for (auto& engine : engineSlots)
+        engine.clearEvents();
+}
+
+void MechaSoundGeneratorAudioProcessor::beginProgramCrossfade(int programIndex)
+{
+    // The current live engine keeps running on its last parameters and fades out,
+    // while the idle slot fades in on the prepared snapshot. It is reset straight into
+    // that snapshot's steady state: a plain reset would power the core up from silence
+    // over activationTime, far longer than the crossfade.
+    fadingEngineParams = lastLiveParams;
+    crossfadeTargetParams = presetBank.getPreset(programIndex).params;
+
+    liveEngineSlot = 1 - liveEngineSlot;
+    engineSlots[static_cast<size_t>(liveEngineSlot)].resetTo(crossfadeTargetParams);
+
+    crossfadeSamplesRemaining = crossfadeLengthSamples;
+}
+
 //==============================================================================
 bool MechaSoundGeneratorAudioProcessor::hasEditor() const
 {
@@ -219,6 +496,14 @@ juce::AudioProcessorEditor* MechaSoundGeneratorAudioProcessor::createEditor()
 void MechaSoundGeneratorAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
+    // Hosts may save from any thread; the morpher copies its snapshots under the lock its edits take
+    state.removeChild(state.getChildWithName(ParameterMorpher::stateType), nullptr);
+    state.appendChild(morpher.toValueTree(), nullptr);
+    state.removeChild(state.getChildWithName(ModulationMatrix::stateType), nullptr);
+    state.appendChild(modulationSettings.toValueTree(), nullptr);
+    state.removeChild(state.getChildWithName(ServoBankEngine::stateType), nullptr);
+    state.appendChild(getServoBankSettings().toValueTree(), nullptr);
+
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     if (xml.get() != nullptr)
         copyXmlToBinary(*xml, destData);
@@ -229,7 +514,155 @@ void MechaSoundGeneratorAudioProcessor::setStateInformation(const void* data, in
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
     if (xmlState.get() != nullptr)
         if (xmlState->hasTagName(apvts.state.getType()))
+        {
             apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+            morpher.fromValueTree(apvts.state.getChildWithName(ParameterMorpher::stateType));
+            setModulationSettings(ModulationMatrix::Settings::fromValueTree(apvts.state.getChildWithName(ModulationMatrix::stateType)));
+            setServoBankSettings(ServoBankEngine::BankSettings::fromValueTree(apvts.state.getChildWithName(ServoBankEngine::stateType)));
+
+            // States saved before engines could be inserted keep the current layout
+            if (apvts.state.hasProperty(engineLayoutProperty))
+            {
+                std::vector<MechaSoundEngine::EngineType> layout;
+                for (const auto& name : juce::StringArray::fromTokens(apvts.state.getProperty(engineLayoutProperty).toString(), ",", {}))
+                {
+                    MechaSoundEngine::EngineType type;
+                    if (MechaSoundEngine::getEngineTypeFromName(name, type))
+                        layout.push_back(type);
+                }
+                setEngineLayout(layout);
+            }
+            setNoiseSeed(static_cast<juce::int64>(apvts.state.getProperty(noiseSeedProperty, -1)));
+
+            // A recording that has moved since the state was saved is skipped
+            const juce::String foleyPath = apvts.state.getProperty(foleyFileProperty).toString();
+            if (foleyPath.isNotEmpty() && juce::File(foleyPath).existsAsFile())
+                loadFoleyFile(juce::File(foleyPath));
+
+            const juce::String grainSourcePath = apvts.state.getProperty(grainSourceFileProperty).toString();
+            if (grainSourcePath.isNotEmpty() && juce::File(grainSourcePath).existsAsFile())
+                loadGrainSourceFile(juce::File(grainSourcePath));
+        }
+}
+
+bool MechaSoundGeneratorAudioProcessor::addEngine(MechaSoundEngine::EngineType type)
+{
+    auto layout = getEngineLayout();
+    if (static_cast<int>(layout.size()) >= MechaSoundEngine::maxEngines)
+        return false;
+
+    layout.push_back(type);
+    setEngineLayout(layout);
+    return true;
+}
+
+bool MechaSoundGeneratorAudioProcessor::removeEngine(int index)
+{
+    if (index < 0 || index >= static_cast<int>(getEngineLayout().size()))
+        return false;
+
+    // Both slots hold the same layout, so removing by index keeps them in step
+    for (auto& engine : engineSlots)
+        engine.removeEngine(index);
+
+    apvts.state.setProperty(engineLayoutProperty, toLayoutString(getEngineLayout()), nullptr);
+    return true;
+}
+
+void MechaSoundGeneratorAudioProcessor::setEngineLayout(const std::vector<MechaSoundEngine::EngineType>& layout)
+{
+    apvts.state.setProperty(engineLayoutProperty, toLayoutString(layout), nullptr);
+
+    for (auto& engine : engineSlots)
+        engine.setEngineLayout(layout);
+}
+
+void MechaSoundGeneratorAudioProcessor::setModulationSettings(const ModulationMatrix::Settings& settings)
+{
+    modulationSettings = settings;
+
+    for (auto& engine : engineSlots)
+        engine.getModulationMatrix().setSettings(settings);
+}
+
+void MechaSoundGeneratorAudioProcessor::setServoBankSettings(const ServoBankEngine::BankSettings& settings)
+{
+    for (auto& engine : engineSlots)
+        engine.setServoBankSettings(settings);
+}
+
+void MechaSoundGeneratorAudioProcessor::setNoiseSeed(juce::int64 seed)
+{
+    seed = (seed < 0) ? -1 : (seed & 0xffffffff);
+    apvts.state.setProperty(noiseSeedProperty, seed, nullptr);
+
+    for (auto& engine : engineSlots)
+        engine.setNoiseSeed(seed);
+}
+
+bool MechaSoundGeneratorAudioProcessor::startExport(const juce::File& file, double lengthSeconds)
+{
+    if (getSampleRate() <= 0.0)
+        return false;
+
+    OfflineRenderer::Job job;
+    job.outputFile = file;
+    job.lengthSeconds = lengthSeconds;
+    job.sampleRate = getSampleRate();
+    job.numChannels = juce::jmax(1, getTotalNumOutputChannels());
+    // What the live engine hears: the morph pad replaces the host values while it is on
+    gatherParameters(job.params, job.masterGain);
+    morpher.getMorphedParameters(job.params, job.masterGain);
+    job.transport.ppqPosition = getLastTransportPosition();
+    job.transport.bpm = lastTransportBpm.load();
+
+    // The file starts at the playhead: earlier events have already played, except a sweep still running
+    for (const auto& event : scheduledEvents)
+        if (event.beat >= job.transport.ppqPosition
+            || (event.type == TimelineEvent::Type::servoSweep && event.beat + event.lengthInBeats > job.transport.ppqPosition))
+            job.timelineEvents.push_back(event);
+
+    job.engineLayout = getEngineLayout();
+    job.modulation = modulationSettings;
+    job.servoBank = getServoBankSettings();
+    job.noiseSeed = getNoiseSeed();
+    job.foleyFile = getFoleyFile();
+    job.grainSourceFile = getGrainSourceFile();
+
+    return exporter.start(job);
+}
+
+bool MechaSoundGeneratorAudioProcessor::loadFoleyFile(const juce::File& file)
+{
+    // Mapped once, so both slots stream the same file or, on failure, keep the old one
+    auto source = SamplePlaybackEngine::openFile(file);
+    if (source == nullptr)
+        return false;
+
+    for (auto& engine : engineSlots)
+        engine.setSampleSource(source, file);
+
+    apvts.state.setProperty(foleyFileProperty, file.getFullPathName(), nullptr);
+    return true;
+}
+
+bool MechaSoundGeneratorAudioProcessor::loadGrainSourceFile(const juce::File& file)
+{
+    juce::AudioBuffer<float> buffer;
+    double sampleRate = 0.0;
+    if (!MechaSoundEngine::readGrainSourceFile(file, buffer, sampleRate))
+        return false;
+
+    for (auto& engine : engineSlots)
+        engine.setGrainSource(buffer, sampleRate, file);
+
+    apvts.state.setProperty(grainSourceFileProperty, file.getFullPathName(), nullptr);
+    return true;
+}
+
+juce::int64 MechaSoundGeneratorAudioProcessor::getNoiseSeed() const
+{
+    return static_cast<juce::int64>(apvts.state.getProperty(noiseSeedProperty, -1));
 }
 
 //==============================================================================
@@ -9,12 +9,23 @@
 #include <memory>
 #include <vector>
 #include <atomic>
+#include <array>
+#include <type_traits>
 #include <cmath>
 // <random> is now primarily in NoiseGenerator.h
 
 // --- Project Includes ---
 #include "../Source/Parameters/Parameters.h"     // For parameter definitions and layout function
+#include "../Source/Parameters/PresetBank.h"     // For the in-memory program bank
+#include "../Source/Parameters/ParameterMorpher.h" // For the morph pad
 #include "../Source/AudioEngine/MechaSoundEngine.h" // For the main sound engine
+#include "../Source/AudioEngine/SamplePlaybackEngine.h" // For the shared foley prefetch thread
+#include "../Source/AudioEngine/ImpulseResponseLibrary.h" // For the convolution spaces
+#include "../Source/AudioEngine/OfflineRenderer.h" // For exporting to a file
+#include "../Source/AudioEngine/LookaheadLimiter.h" // For the master limiter
+#include "../Source/Diagnostics/BlockLatencyHistogram.h" // For per-block timing
+#include "../Source/Diagnostics/SpectrumAnalyser.h" // For the morph pad spectrum
+#include "../Source/Diagnostics/TelemetryPublisher.h" // For external monitoring
 
 // --- Forward Declaration ---
 class MechaSoundGeneratorAudioProcessorEditor; // Keep this if your editor is named this
@@ -36,6 +47,8 @@ public:
 #endif
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -62,32 +75,136 @@ public:
     // Public member for APVTS, accessible by the editor
     juce::AudioProcessorValueTreeState apvts;
 
+    // Morph pad state, edited by the UIGraph component
+    ParameterMorpher& getMorpher() noexcept { return morpher; }
+
+    // Per-block processing time, tagged with the parameter events that preceded spikes.
+    // Read it from a non-audio thread via getReport(); Tools/LatencyHarness drives and prints it.
+    BlockLatencyHistogram& getLatencyHistogram() noexcept { return latencyHistogram; }
+
+    // Spectrum of the master output and the live engines, drawn behind the morph pad
+    SpectrumAnalyser& getSpectrumAnalyser() noexcept { return spectrumAnalyser; }
+
+    // Optional deterministic noise seed, stored with the plugin state.
+    // -1 (the default) keeps the hiss non-deterministic. Takes effect at the next prepareToPlay.
+    void setNoiseSeed(juce::int64 seed);
+    juce::int64 getNoiseSeed() const;
+
+    // Foley recording streamed by the sample playback engines (WAV or raw 48 kHz stereo float).
+    // The path is stored with the plugin state. Returns false, and leaves both slots as they were,
+    // if the file cannot be mapped. Message thread.
+    bool loadFoleyFile(const juce::File& file);
+    juce::File getFoleyFile() const { return engineSlots[0].getSampleFile(); }
+
+    // Recording the granular engines take their grains from, instead of the built-in
+    // gear grind. The path is stored with the plugin state. Returns false, and leaves both
+    // slots as they were, if the file cannot be read. Message thread.
+    bool loadGrainSourceFile(const juce::File& file);
+    juce::File getGrainSourceFile() const { return engineSlots[0].getGrainSourceFile(); }
+
+    // Mecha events placed on the host timeline and dispatched sample-accurately.
+    // Call from one non-audio thread (usually the message thread).
+    bool scheduleTimelineEvent(const TimelineEvent& event);
+    void clearTimeline();
+
+    // Transport position (PPQ) at the start of the latest block, for placing events relative to now
+    double getLastTransportPosition() const noexcept { return lastTransportPosition.load(); }
+
+    // Engines running in both slots, inserted and removed without interrupting audio.
+    // Stored with the plugin state. Message thread.
+    bool addEngine(MechaSoundEngine::EngineType type);
+    bool removeEngine(int index);
+    std::vector<MechaSoundEngine::EngineType> getEngineLayout() const { return engineSlots[0].getEngineLayout(); }
+
+    // Per-servo settings of the servo bank engines; how many of them sound is the
+    // servoBankSize parameter. Stored with the plugin state. Message thread.
+    void setServoBankSettings(const ServoBankEngine::BankSettings& settings);
+    const ServoBankEngine::BankSettings& getServoBankSettings() const noexcept { return engineSlots[0].getServoBankSettings(); }
+
+    // Modulation routes and source rates, stored with the plugin state. Message thread.
+    void setModulationSettings(const ModulationMatrix::Settings& settings);
+    const ModulationMatrix::Settings& getModulationSettings() const noexcept { return modulationSettings; }
+
+    // Renders the current sound to a WAV file on a background thread, faster than realtime,
+    // without touching the live engines. The render takes the morphed parameters, if the
+    // morph pad is on, and replays the timeline from the current transport position. Uses the host sample rate, so it needs a prepared
+    // processor. Returns false if that is not the case, an export is running or the file
+    // cannot be created. Message thread.
+    bool startExport(const juce::File& file, double lengthSeconds);
+    void cancelExport() { exporter.cancel(); }
+    const OfflineRenderer& getExporter() const noexcept { return exporter; }
+
 private:
     //==============================================================================
     // createParameterLayout is now a free function declared in Parameters.h
 
-    // Cached atomic parameter pointers for thread-safe access from audio thread
-    std::atomic<float>* hissLevelParam = nullptr;
-    std::atomic<float>* hissCutoffParam = nullptr;
-    std::atomic<float>* hissResonanceParam = nullptr;
-    std::atomic<float>* servoLevelParam = nullptr;
-    std::atomic<float>* servoPitchParam = nullptr;
-    std::atomic<float>* servoModDepthParam = nullptr;
-    std::atomic<float>* servoModRateParam = nullptr;
-    std::atomic<float>* powerCoreHumLevelParam = nullptr;
-    std::atomic<float>* powerCoreFundamentalPitchParam = nullptr;
-    std::atomic<float>* powerCoreHumComplexityParam = nullptr;
-    std::atomic<float>* powerCorePulsationRateParam = nullptr;
-    std::atomic<float>* powerCorePulsationDepthParam = nullptr;
-    std::atomic<float>* powerCoreActivationTriggerParam;
-    std::atomic<float>* powerCoreActivationTimeParam = nullptr;
-    std::atomic<float>* powerCoreEnergyTypeParam = nullptr;
-    std::atomic<float>* powerCoreFilterCutoffParam = nullptr;
-    std::atomic<float>* powerCoreFilterResonanceParam = nullptr;
-    std::atomic<float>* masterGainParam = nullptr;
-
-    // DSP Engine
-    MechaSoundEngine mechaSoundEngine;
+    // Cached atomic parameter pointers for thread-safe access from audio thread,
+    // indexed by ParameterIndex
+    std::array<std::atomic<float>*, ParameterIndex::numParameters> parameterValues{};
+
+    // Convolution kernels, built in the background and shared by both engine slots
+    // (and, per sample rate, with every other instance in the process)
+    ImpulseResponseLibrary impulseResponses;
+
+    // File export; shares the kernels above, so it is declared after them
+    OfflineRenderer exporter{ impulseResponses, apvts };
+
+    // One foley prefetch thread for the sample playback engines of both slots. The
+    // engines detach from it when they are destroyed, so it is declared before them.
+    SamplePrefetchThread samplePrefetch;
+
+    // DSP Engines
+    // Two engine slots: the live one and, during a program change, the outgoing one
+    // that is crossfaded out. Only the live slot is processed outside a crossfade.
+    std::array<MechaSoundEngine, 2> engineSlots;
+    int liveEngineSlot = 0;
+
+    // Parameter morphing (applied instead of APVTS values while enabled)
+    ParameterMorpher morpher;
+
+    // Modulation routes, mirrored into both engine slots
+    ModulationMatrix::Settings modulationSettings; // Message thread only
+
+    // Diagnostics
+    BlockLatencyHistogram latencyHistogram;
+    SpectrumAnalyser spectrumAnalyser;
+
+    // Master stage after masterGain. Its lookahead is reported as latency at all times.
+    LookaheadLimiter limiter;
+    TelemetryPublisher telemetry{ juce::PluginHostType().getHostDescription() }; // Read by Tools/TelemetryMonitor
+
+    // Program handling
+    PresetBank presetBank;
+    int currentProgram = 0; // Message thread only
+    std::atomic<int> pendingProgramIndex{ -1 }; // Written by setCurrentProgram, consumed by processBlock
+
+    EngineParameterSet lastLiveParams;        // Parameters applied to the live engine in the previous block
+    EngineParameterSet lastBlockParams;       // Host (or morphed) parameters of the previous block, for event detection
+    EngineParameterSet fadingEngineParams;    // Frozen parameters for the outgoing engine
+    EngineParameterSet crossfadeTargetParams; // Prepared snapshot for the incoming engine
+    juce::AudioBuffer<float> crossfadeBuffer;        // Preallocated in prepareToPlay for the active precision
+    juce::AudioBuffer<double> crossfadeBufferDouble;
+    int crossfadeLengthSamples = 0;
+    int crossfadeSamplesRemaining = 0;
+
+    static constexpr double programCrossfadeSeconds = 0.03;
+
+    // Transport
+    double freeRunningPosition = 0.0; // Used when the host provides no timeline
+    std::atomic<double> lastTransportPosition{ 0.0 };
+    std::atomic<double> lastTransportBpm{ 120.0 };
+    std::vector<TimelineEvent> scheduledEvents; // Message thread: the latest events scheduled, for exports
+
+    void gatherParameters(EngineParameterSet& params, float& masterGain) const noexcept;
+    void beginProgramCrossfade(int programIndex);
+    TransportState readTransport(int numSamples);
+    void setEngineLayout(const std::vector<MechaSoundEngine::EngineType>& layout);
+
+    template <typename SampleType>
+    void processBlockInternal(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getCrossfadeBuffer() noexcept;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MechaSoundGeneratorAudioProcessor)
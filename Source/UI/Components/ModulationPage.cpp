@@ -0,0 +1,192 @@
+// Source/UI/Components/ModulationPage.cpp
+#include "ModulationPage.h"
+#include "../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int rowHeight = 24;
+    constexpr int labelWidth = 110;
+    constexpr int spacing = 8;
+    constexpr int buttonWidth = 90;
+    constexpr int textBoxWidth = 70;
+
+    juce::String describeRoute(const ModulationMatrix::Route& route)
+    {
+        return ModulationMatrix::getSourceName(route.source) + "  ->  "
+             + ParameterDescriptors::table[static_cast<size_t>(route.destination)].name + "  "
+             + (route.depth >= 0.0f ? "+" : "") + juce::String(route.depth, 2);
+    }
+}
+
+ModulationPage::ModulationPage(MechaSoundGeneratorAudioProcessor& processorToUse)
+    : processorRef(processorToUse)
+{
+    initialiseRateSlider(lfo1RateSlider, lfo1RateLabel, "LFO 1 rate");
+    initialiseRateSlider(lfo2RateSlider, lfo2RateLabel, "LFO 2 rate");
+    initialiseRateSlider(randomRateSlider, randomRateLabel, "Random rate");
+
+    for (int source = 0; source < ModulationMatrix::numSources; ++source)
+        sourceBox.addItem(ModulationMatrix::getSourceName(static_cast<ModulationMatrix::Source>(source)), source + 1);
+    sourceBox.setSelectedId(1, juce::dontSendNotification);
+    addAndMakeVisible(sourceBox);
+
+    for (int index = 0; index < ParameterIndex::numParameters; ++index)
+        if (ModulationMatrix::isValidDestination(index))
+            destinationBox.addItem(ParameterDescriptors::table[static_cast<size_t>(index)].name, index + 1);
+    destinationBox.setSelectedItemIndex(0, juce::dontSendNotification);
+    addAndMakeVisible(destinationBox);
+
+    depthSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    depthSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, textBoxWidth, rowHeight);
+    depthSlider.setRange(-1.0, 1.0, 0.01);
+    depthSlider.setValue(0.25, juce::dontSendNotification);
+    depthSlider.setDoubleClickReturnValue(true, 0.0);
+    addAndMakeVisible(depthSlider);
+
+    addButton.onClick = [this] { addRoute(); };
+    addAndMakeVisible(addButton);
+
+    routeList.setRowHeight(rowHeight);
+    addAndMakeVisible(routeList);
+    removeButton.onClick = [this] { removeSelectedRoute(); };
+    addAndMakeVisible(removeButton);
+
+    refresh();
+}
+
+void ModulationPage::initialiseRateSlider(juce::Slider& slider, juce::Label& label, const juce::String& name)
+{
+    label.setText(name, juce::dontSendNotification);
+    addAndMakeVisible(label);
+
+    slider.setSliderStyle(juce::Slider::LinearHorizontal);
+    slider.setTextBoxStyle(juce::Slider::TextBoxRight, false, textBoxWidth, rowHeight);
+    slider.setRange(0.01, 20.0, 0.01);
+    slider.setSkewFactorFromMidPoint(1.0);
+    slider.setTextValueSuffix(" Hz");
+    slider.onValueChange = [this]
+    {
+        settings.lfo1Rate = static_cast<float>(lfo1RateSlider.getValue());
+        settings.lfo2Rate = static_cast<float>(lfo2RateSlider.getValue());
+        settings.randomRate = static_cast<float>(randomRateSlider.getValue());
+        publish();
+    };
+    addAndMakeVisible(slider);
+}
+
+//==============================================================================
+void ModulationPage::visibilityChanged()
+{
+    if (isVisible())
+        refresh();
+}
+
+void ModulationPage::refresh()
+{
+    settings = processorRef.getModulationSettings();
+
+    lfo1RateSlider.setValue(settings.lfo1Rate, juce::dontSendNotification);
+    lfo2RateSlider.setValue(settings.lfo2Rate, juce::dontSendNotification);
+    randomRateSlider.setValue(settings.randomRate, juce::dontSendNotification);
+
+    routeList.updateContent();
+    routeList.deselectAllRows();
+    routeList.repaint();
+    updateButtons();
+}
+
+void ModulationPage::addRoute()
+{
+    ModulationMatrix::Route route;
+    route.source = static_cast<ModulationMatrix::Source>(sourceBox.getSelectedId() - 1);
+    route.destination = destinationBox.getSelectedId() - 1;
+    route.depth = static_cast<float>(depthSlider.getValue());
+
+    if (!settings.addRoute(route))
+        return;
+
+    publish();
+    routeList.updateContent();
+    routeList.selectRow(settings.numRoutes - 1);
+    updateButtons();
+}
+
+void ModulationPage::removeSelectedRoute()
+{
+    const int row = routeList.getSelectedRow();
+    if (row < 0 || row >= settings.numRoutes)
+        return;
+
+    settings.removeRoute(row);
+    publish();
+    routeList.updateContent();
+    routeList.deselectAllRows();
+    routeList.repaint();
+    updateButtons();
+}
+
+void ModulationPage::publish()
+{
+    processorRef.setModulationSettings(settings);
+}
+
+void ModulationPage::updateButtons()
+{
+    addButton.setEnabled(settings.numRoutes < ModulationMatrix::maxRoutes);
+    removeButton.setEnabled(routeList.getSelectedRow() >= 0);
+}
+
+//==============================================================================
+int ModulationPage::getNumRows()
+{
+    return settings.numRoutes;
+}
+
+void ModulationPage::paintListBoxItem(int row, juce::Graphics& g, int width, int height, bool rowIsSelected)
+{
+    if (row < 0 || row >= settings.numRoutes)
+        return;
+
+    if (rowIsSelected)
+        g.fillAll(findColour(juce::TextEditor::highlightColourId));
+
+    g.setColour(findColour(juce::Label::textColourId));
+    g.drawText(describeRoute(settings.routes[static_cast<size_t>(row)]), 6, 0, width - 12, height, juce::Justification::centredLeft, true);
+}
+
+void ModulationPage::selectedRowsChanged(int)
+{
+    updateButtons();
+}
+
+//==============================================================================
+void ModulationPage::resized()
+{
+    auto bounds = getLocalBounds().reduced(12);
+
+    for (auto [slider, label] : { std::pair{ &lfo1RateSlider, &lfo1RateLabel },
+                                  std::pair{ &lfo2RateSlider, &lfo2RateLabel },
+                                  std::pair{ &randomRateSlider, &randomRateLabel } })
+    {
+        auto row = bounds.removeFromTop(rowHeight);
+        label->setBounds(row.removeFromLeft(labelWidth));
+        slider->setBounds(row);
+        bounds.removeFromTop(spacing);
+    }
+
+    bounds.removeFromTop(spacing);
+    auto addRow = bounds.removeFromTop(rowHeight);
+    addButton.setBounds(addRow.removeFromRight(buttonWidth));
+    addRow.removeFromRight(spacing);
+    sourceBox.setBounds(addRow.removeFromLeft(labelWidth + 20));
+    addRow.removeFromLeft(spacing);
+    destinationBox.setBounds(addRow.removeFromLeft(addRow.getWidth() / 2));
+    addRow.removeFromLeft(spacing);
+    depthSlider.setBounds(addRow);
+
+    bounds.removeFromTop(spacing);
+    auto removeRow = bounds.removeFromBottom(rowHeight);
+    removeButton.setBounds(removeRow.removeFromRight(buttonWidth));
+    bounds.removeFromBottom(spacing);
+    routeList.setBounds(bounds);
+}
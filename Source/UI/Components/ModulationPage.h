@@ -0,0 +1,59 @@
+// Source/UI/Components/ModulationPage.h
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "../Source/AudioEngine/ModulationMatrix.h"
+
+class MechaSoundGeneratorAudioProcessor;
+
+//==============================================================================
+/*
+    Editor page for the modulation matrix: the source rates, the route list,
+    and a row that adds a route from a source to a parameter at a depth.
+
+    The page edits a copy of the processor's settings and hands every change
+    back through setModulationSettings(), which stores it with the plugin
+    state and passes it to the engines. The copy is reloaded whenever the page
+    is shown, so a state restored by the host while the page is hidden shows up.
+*/
+class ModulationPage : public juce::Component,
+                       private juce::ListBoxModel
+{
+public:
+    explicit ModulationPage(MechaSoundGeneratorAudioProcessor& processorToUse);
+    ~ModulationPage() override = default;
+
+    void resized() override;
+    void visibilityChanged() override;
+
+    /** @brief Reloads the settings from the processor. */
+    void refresh();
+
+private:
+    // ListBoxModel: one row per route
+    int getNumRows() override;
+    void paintListBoxItem(int row, juce::Graphics& g, int width, int height, bool rowIsSelected) override;
+    void selectedRowsChanged(int lastRowSelected) override;
+
+    void initialiseRateSlider(juce::Slider& slider, juce::Label& label, const juce::String& name);
+    void addRoute();
+    void removeSelectedRoute();
+    void publish();
+    void updateButtons();
+
+    MechaSoundGeneratorAudioProcessor& processorRef;
+    ModulationMatrix::Settings settings; // Copy being edited
+
+    juce::Label lfo1RateLabel, lfo2RateLabel, randomRateLabel;
+    juce::Slider lfo1RateSlider, lfo2RateSlider, randomRateSlider;
+
+    juce::ComboBox sourceBox;
+    juce::ComboBox destinationBox; // Item IDs are ParameterIndex + 1
+    juce::Slider depthSlider;
+    juce::TextButton addButton{ "Add Route" };
+
+    juce::ListBox routeList{ "Routes", this };
+    juce::TextButton removeButton{ "Remove" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulationPage)
+};
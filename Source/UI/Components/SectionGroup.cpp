@@ -1,11 +1,130 @@
-/*
-  ==============================================================================
+// Source/UI/Components/SectionGroup.cpp
+#include "SectionGroup.h"
 
-    SectionGroup.cpp
-    Created: 3 Jun 2025 7:21:53pm
-    Author:  marce
+namespace
+{
+    constexpr int knobSize = 72;
+    constexpr int buttonHeight = 24;
+    constexpr int labelHeight = 20; // Labels are attached above their control
+    constexpr int spacing = 8;
+    constexpr int textBoxWidth = 80;
+    constexpr int textBoxHeight = 20;
+}
 
-  ==============================================================================
-*/
+SectionGroup::SectionGroup(Section sectionToShow, juce::AudioProcessorValueTreeState& apvtsToUse)
+    : section(sectionToShow), apvts(apvtsToUse)
+{
+}
 
-#include "SectionGroup.h"
+juce::String SectionGroup::getSectionName(Section section)
+{
+    switch (section)
+    {
+        case Section::hiss:      return "Hiss";
+        case Section::servo:     return "Servo";
+        case Section::powerCore: return "Power Core";
+        case Section::texture:   return "Grain & Foley";
+        case Section::motion:    return "Motion";
+        case Section::output:    return "Space & Output";
+    }
+
+    jassertfalse;
+    return {};
+}
+
+//==============================================================================
+void SectionGroup::visibilityChanged()
+{
+    if (isVisible())
+    {
+        if (controls.empty())
+        {
+            createControls();
+            resized();
+        }
+    }
+    else
+    {
+        controls.clear();
+    }
+}
+
+void SectionGroup::createControls()
+{
+    for (const auto& descriptor : ParameterDescriptors::table)
+        if (descriptor.section == section)
+            createControl(descriptor);
+}
+
+void SectionGroup::createControl(const ParameterDescriptor& descriptor)
+{
+    using Attachments = juce::AudioProcessorValueTreeState;
+
+    auto control = std::make_unique<Control>();
+    control->kind = descriptor.kind;
+
+    switch (descriptor.kind)
+    {
+        case ParameterDescriptor::Kind::continuous:
+        {
+            auto slider = std::make_unique<juce::Slider>();
+            slider->setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+            slider->setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
+            control->sliderAttachment = std::make_unique<Attachments::SliderAttachment>(apvts, descriptor.id, *slider);
+            control->component = std::move(slider);
+            break;
+        }
+
+        case ParameterDescriptor::Kind::choice:
+        {
+            auto box = std::make_unique<juce::ComboBox>();
+            box->addItemList(juce::StringArray::fromTokens(descriptor.choices, "|", ""), 1); // Items must exist before the attachment is created
+            control->comboBoxAttachment = std::make_unique<Attachments::ComboBoxAttachment>(apvts, descriptor.id, *box);
+            control->component = std::move(box);
+            break;
+        }
+
+        case ParameterDescriptor::Kind::toggle:
+        {
+            auto button = std::make_unique<juce::ToggleButton>("On");
+            control->buttonAttachment = std::make_unique<Attachments::ButtonAttachment>(apvts, descriptor.id, *button);
+            control->component = std::move(button);
+            break;
+        }
+    }
+
+    addAndMakeVisible(*control->component);
+    addAndMakeVisible(control->label);
+    control->label.setText(descriptor.label, juce::dontSendNotification);
+    control->label.attachToComponent(control->component.get(), false);
+    control->label.setJustificationType(juce::Justification::centredTop);
+
+    controls.push_back(std::move(control));
+}
+
+//==============================================================================
+void SectionGroup::resized()
+{
+    auto bounds = getLocalBounds().reduced(spacing);
+    const int knobsPerRow = juce::jmax(1, (bounds.getWidth() + spacing) / (knobSize + spacing));
+
+    int column = 0;
+    int y = bounds.getY() + labelHeight;
+
+    for (auto& control : controls)
+    {
+        const int x = bounds.getX() + column * (knobSize + spacing);
+
+        // Buttons and combo boxes are centred in the space of a knob
+        if (control->kind == ParameterDescriptor::Kind::continuous)
+            control->component->setBounds(x, y, knobSize, knobSize);
+        else
+            control->component->setBounds(x, y + (knobSize - buttonHeight) / 2, knobSize, buttonHeight);
+
+        if (++column == knobsPerRow)
+        {
+            column = 0;
+            y += knobSize + labelHeight + spacing;
+        }
+    }
+}
@@ -1,11 +1,59 @@
-/*
-  ==============================================================================
+// Source/UI/Components/SectionGroup.h
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "../Source/Parameters/Parameters.h"
+#include <memory>
+#include <vector>
 
-    SectionGroup.h
-    Created: 3 Jun 2025 7:21:53pm
-    Author:  marce
+//==============================================================================
+/*
+    One editor page: the controls for every parameter in a section of
+    ParameterDescriptors::table, laid out as a knob grid.
 
-  ==============================================================================
+    The controls are built lazily. Sliders, labels and APVTS attachments are
+    created the first time the page becomes visible, and are destroyed again
+    when it is hidden. A hidden page is an empty component, so opening the
+    editor costs one page, not the whole table. Each attachment also stops
+    listening to its parameter when it is destroyed.
 */
+class SectionGroup : public juce::Component
+{
+public:
+    using Section = ParameterDescriptor::Section;
 
-#pragma once
+    SectionGroup(Section sectionToShow, juce::AudioProcessorValueTreeState& apvtsToUse);
+    ~SectionGroup() override = default;
+
+    void resized() override;
+    void visibilityChanged() override;
+
+    Section getSection() const noexcept { return section; }
+    bool hasControls() const noexcept { return !controls.empty(); }
+
+    /** @brief Tab title for a section. */
+    static juce::String getSectionName(Section section);
+
+private:
+    // Only the attachment matching the kind of component is set; attachments
+    // are declared after the component so they are destroyed first
+    struct Control
+    {
+        ParameterDescriptor::Kind kind;
+        std::unique_ptr<juce::Component> component;
+        juce::Label label;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> sliderAttachment;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> comboBoxAttachment;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> buttonAttachment;
+    };
+
+    void createControls();
+    void createControl(const ParameterDescriptor& descriptor);
+
+    const Section section;
+    juce::AudioProcessorValueTreeState& apvts;
+    std::vector<std::unique_ptr<Control>> controls; // Empty while hidden
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SectionGroup)
+};
@@ -1,6 +1,257 @@
 // Source/UI/Components/UIGraph.cpp
 #include "UIGraph.h"
 
-// Any non-inline member function definitions for UIGraph would go here.
-// For now, since all methods in the header are simple, this file might remain
-// empty other than the include.
\ No newline at end of file
+UIGraph::UIGraph(ParameterMorpher& morpherToUse, juce::AudioProcessorValueTreeState& apvtsToUse, SpectrumAnalyser& analyserToShow)
+    : morpher(morpherToUse), apvts(apvtsToUse), analyser(analyserToShow)
+{
+    addAndMakeVisible(morphEnableButton);
+    morphEnableButton.setToggleState(morpher.isEnabled(), juce::dontSendNotification);
+    morphEnableButton.onClick = [this]
+    {
+        morpher.setEnabled(morphEnableButton.getToggleState());
+        repaint();
+    };
+
+    analyser.setActive(true);
+    addAndMakeVisible(engineSpectraButton);
+    engineSpectraButton.setToggleState(analyser.isTapEnabled(1), juce::dontSendNotification);
+    engineSpectraButton.onClick = [this]
+    {
+        for (int tap = 1; tap < SpectrumAnalyser::numTaps; ++tap)
+            analyser.setTapEnabled(tap, engineSpectraButton.getToggleState());
+    };
+    startTimerHz(spectrumRefreshHz);
+}
+
+UIGraph::~UIGraph()
+{
+    stopTimer();
+    analyser.setActive(false);
+}
+
+void UIGraph::timerCallback()
+{
+    const auto version = analyser.getVersion();
+    if (version == spectrumVersion)
+        return;
+
+    spectrumVersion = version;
+    for (int tap = 0; tap < SpectrumAnalyser::numTaps; ++tap)
+    {
+        const bool shown = tap == SpectrumAnalyser::masterTap || engineSpectraButton.getToggleState();
+        hasSpectrum[static_cast<size_t>(tap)] = shown && analyser.getPath(tap, spectrumPaths[static_cast<size_t>(tap)]);
+    }
+
+    repaint();
+}
+
+void UIGraph::paintSpectrum(juce::Graphics& g, juce::Rectangle<float> pad) const
+{
+    const juce::Graphics::ScopedSaveState state(g);
+    g.reduceClipRegion(pad.toNearestInt());
+
+    const auto toPad = juce::AffineTransform::scale(pad.getWidth(), pad.getHeight()).translated(pad.getX(), pad.getY());
+
+    // Engines first, one hue each, so the master curve stays on top
+    for (int tap = 1; tap < SpectrumAnalyser::numTaps; ++tap)
+    {
+        if (!hasSpectrum[static_cast<size_t>(tap)])
+            continue;
+
+        const float hue = static_cast<float>(tap - 1) / static_cast<float>(SpectrumAnalyser::numTaps - 1);
+        g.setColour(juce::Colour::fromHSV(hue, 0.6f, 0.9f, 0.6f));
+        g.strokePath(spectrumPaths[static_cast<size_t>(tap)], juce::PathStrokeType(1.0f), toPad);
+    }
+
+    if (hasSpectrum[static_cast<size_t>(SpectrumAnalyser::masterTap)])
+    {
+        const auto& master = spectrumPaths[static_cast<size_t>(SpectrumAnalyser::masterTap)];
+        auto area = master;
+        area.lineTo(1.0f, 1.0f);
+        area.lineTo(0.0f, 1.0f);
+        area.closeSubPath();
+
+        g.setColour(juce::Colours::lightgrey.withAlpha(0.12f));
+        g.fillPath(area, toPad);
+        g.setColour(juce::Colours::lightgrey.withAlpha(0.5f));
+        g.strokePath(master, juce::PathStrokeType(1.5f), toPad);
+    }
+}
+
+void UIGraph::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::darkgrey.darker(0.8f));
+
+    const auto pad = getPadBounds();
+    const auto accent = juce::Colour(0xff78C0A8);
+
+    // Grid
+    g.setColour(juce::Colours::lightgrey.withAlpha(0.1f));
+    for (int i = 1; i < 4; ++i)
+    {
+        const float fraction = static_cast<float>(i) / 4.0f;
+        g.drawVerticalLine(juce::roundToInt(pad.getX() + pad.getWidth() * fraction), pad.getY(), pad.getBottom());
+        g.drawHorizontalLine(juce::roundToInt(pad.getY() + pad.getHeight() * fraction), pad.getX(), pad.getRight());
+    }
+    paintSpectrum(g, pad);
+
+    g.setColour(juce::Colours::black.withAlpha(0.5f));
+    g.drawRect(pad);
+
+    const int numSnapshots = morpher.getNumSnapshots();
+    if (numSnapshots == 0)
+    {
+        g.setColour(juce::Colours::lightgrey);
+        g.setFont(14.0f);
+        g.drawFittedText("Double-click to capture a snapshot", pad.toNearestInt(), juce::Justification::centred, 2);
+        return;
+    }
+
+    // Blend weights at the cursor, drawn as links from the cursor to each snapshot
+    const auto cursor = morpher.getCursor();
+    const auto cursorLocal = toLocal(cursor);
+    float weights[ParameterMorpher::maxSnapshots];
+    morpher.getWeightsAt(cursor, weights);
+
+    for (int s = 0; s < numSnapshots; ++s)
+    {
+        const auto position = toLocal(morpher.getSnapshotPosition(s));
+        g.setColour(accent.withAlpha(juce::jlimit(0.05f, 1.0f, weights[s])));
+        g.drawLine({ cursorLocal, position }, 1.0f + 3.0f * weights[s]);
+    }
+
+    // Snapshots
+    g.setFont(12.0f);
+    for (int s = 0; s < numSnapshots; ++s)
+    {
+        const auto position = toLocal(morpher.getSnapshotPosition(s));
+        const auto circle = juce::Rectangle<float>(snapshotRadius * 2.0f, snapshotRadius * 2.0f).withCentre(position);
+        g.setColour(s == draggedSnapshot ? accent.brighter() : accent);
+        g.fillEllipse(circle);
+        g.setColour(juce::Colours::black);
+        g.drawText(juce::String(s + 1), circle, juce::Justification::centred, false);
+    }
+
+    // Cursor
+    const auto cursorColour = morpher.isEnabled() ? juce::Colours::white : juce::Colours::grey;
+    g.setColour(cursorColour);
+    g.drawEllipse(juce::Rectangle<float>(12.0f, 12.0f).withCentre(cursorLocal), 2.0f);
+    g.drawLine(cursorLocal.x - 10.0f, cursorLocal.y, cursorLocal.x + 10.0f, cursorLocal.y, 1.0f);
+    g.drawLine(cursorLocal.x, cursorLocal.y - 10.0f, cursorLocal.x, cursorLocal.y + 10.0f, 1.0f);
+}
+
+void UIGraph::resized()
+{
+    auto buttonRow = getLocalBounds().removeFromTop(24);
+    morphEnableButton.setBounds(buttonRow.removeFromLeft(90).reduced(2));
+    engineSpectraButton.setBounds(buttonRow.removeFromRight(90).reduced(2));
+}
+
+//==============================================================================
+void UIGraph::mouseDown(const juce::MouseEvent& event)
+{
+    const auto position = event.position;
+    const int hit = findSnapshotAt(position);
+
+    if (event.mods.isPopupMenu())
+    {
+        if (hit >= 0)
+            showSnapshotMenu(hit);
+        return;
+    }
+
+    if (hit >= 0)
+    {
+        draggedSnapshot = hit;
+    }
+    else if (getPadBounds().contains(position))
+    {
+        draggingCursor = true;
+        morpher.setCursor(toNormalised(position));
+    }
+
+    repaint();
+}
+
+void UIGraph::mouseDrag(const juce::MouseEvent& event)
+{
+    if (draggedSnapshot >= 0)
+        morpher.moveSnapshot(draggedSnapshot, toNormalised(event.position));
+    else if (draggingCursor)
+        morpher.setCursor(toNormalised(event.position));
+    else
+        return;
+
+    repaint();
+}
+
+void UIGraph::mouseUp(const juce::MouseEvent&)
+{
+    draggedSnapshot = -1;
+    draggingCursor = false;
+    repaint();
+}
+
+void UIGraph::mouseDoubleClick(const juce::MouseEvent& event)
+{
+    if (!getPadBounds().contains(event.position) || findSnapshotAt(event.position) >= 0)
+        return;
+
+    morpher.addSnapshot(toNormalised(event.position), ParameterMorpher::captureNormalisedSnapshot(apvts));
+    repaint();
+}
+
+//==============================================================================
+juce::Rectangle<float> UIGraph::getPadBounds() const
+{
+    auto bounds = getLocalBounds().toFloat();
+    bounds.removeFromTop(24.0f); // Enable button row
+    return bounds.reduced(snapshotRadius);
+}
+
+juce::Point<float> UIGraph::toNormalised(juce::Point<float> localPosition) const
+{
+    const auto pad = getPadBounds();
+    return { juce::jlimit(0.0f, 1.0f, (localPosition.x - pad.getX()) / pad.getWidth()),
+             juce::jlimit(0.0f, 1.0f, (localPosition.y - pad.getY()) / pad.getHeight()) };
+}
+
+juce::Point<float> UIGraph::toLocal(juce::Point<float> normalisedPosition) const
+{
+    const auto pad = getPadBounds();
+    return { pad.getX() + normalisedPosition.x * pad.getWidth(),
+             pad.getY() + normalisedPosition.y * pad.getHeight() };
+}
+
+int UIGraph::findSnapshotAt(juce::Point<float> localPosition) const
+{
+    // Search from the top-most (last drawn) snapshot down
+    for (int s = morpher.getNumSnapshots() - 1; s >= 0; --s)
+    {
+        if (toLocal(morpher.getSnapshotPosition(s)).getDistanceFrom(localPosition) <= snapshotRadius)
+            return s;
+    }
+    return -1;
+}
+
+void UIGraph::showSnapshotMenu(int snapshotIndex)
+{
+    juce::PopupMenu menu;
+    menu.addItem(1, "Recapture current values");
+    menu.addItem(2, "Remove snapshot");
+
+    juce::Component::SafePointer<UIGraph> safeThis(this);
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this),
+        [safeThis, snapshotIndex](int result)
+        {
+            if (safeThis == nullptr)
+                return;
+
+            if (result == 1)
+                safeThis->morpher.recaptureSnapshot(snapshotIndex, ParameterMorpher::captureNormalisedSnapshot(safeThis->apvts));
+            else if (result == 2)
+                safeThis->morpher.removeSnapshot(snapshotIndex);
+
+            safeThis->repaint();
+        });
+}
@@ -2,55 +2,68 @@
 #pragma once
 
 #include <juce_gui_basics/juce_gui_basics.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "../Source/Parameters/ParameterMorpher.h"
+#include "../Source/Diagnostics/SpectrumAnalyser.h"
+#include <array>
 
 //==============================================================================
 /*
-    This component will display a visual graph for controlling and
-    visualizing sound effect parameters over time.
-    (Placeholder for future implementation)
+    Morph pad for blending between parameter snapshots.
+
+    - Double-click an empty spot to capture the current parameter values as a snapshot.
+    - Drag a snapshot to move it; right-click it to recapture or remove it.
+    - Click or drag anywhere else to move the morph cursor.
+
+    The pad only edits the ParameterMorpher; the interpolation itself runs on
+    the audio thread.
+
+    Behind the pad, the live spectrum of the master output is drawn, and with
+    'Engines' on, one curve per engine slot. The analyser runs while the pad
+    exists; the pad only polls for finished paths and scales them.
 */
-class UIGraph : public juce::Component
+class UIGraph : public juce::Component,
+                private juce::Timer
 {
 public:
-    UIGraph()
-    {
-        // Constructor:
-        // You might want to set some initial properties or add child components here
-        // when you start implementing its features.
-        // For now, we can leave it empty or add a simple background color for visibility.
-        // setLookAndFeel(&customLookAndFeel); // If you have a custom LookAndFeel
-    }
-
-    ~UIGraph() override
-    {
-        // Destructor:
-        // Clean up any resources if needed.
-        // setLookAndFeel(nullptr);
-    }
-
-    void paint(juce::Graphics& g) override
-    {
-        // --- Placeholder Drawing ---
-        g.fillAll(juce::Colours::darkgrey.darker(0.8f)); // Placeholder background
-
-        g.setColour(juce::Colours::lightgrey);
-        g.setFont(15.0f);
-        g.drawText("UIGraph - Placeholder", getLocalBounds(), juce::Justification::centred, true);
-        // --- End Placeholder Drawing ---
-
-        // Future implementation will involve drawing the graph lines, control points, etc.
-        // based on the sound effect data or user input.
-    }
-
-    void resized() override
-    {
-        // Layout child components if any.
-        // For example, if you have control points or sub-elements for the graph,
-        // their bounds would be set here.
-    }
+    UIGraph(ParameterMorpher& morpherToUse, juce::AudioProcessorValueTreeState& apvtsToUse, SpectrumAnalyser& analyserToShow);
+    ~UIGraph() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    void mouseDown(const juce::MouseEvent& event) override;
+    void mouseDrag(const juce::MouseEvent& event) override;
+    void mouseUp(const juce::MouseEvent& event) override;
+    void mouseDoubleClick(const juce::MouseEvent& event) override;
 
 private:
-    // juce::LookAndFeel_V4 customLookAndFeel; // Example if you want a specific L&F for this component
+    juce::Rectangle<float> getPadBounds() const;
+    juce::Point<float> toNormalised(juce::Point<float> localPosition) const;
+    juce::Point<float> toLocal(juce::Point<float> normalisedPosition) const;
+    int findSnapshotAt(juce::Point<float> localPosition) const;
+    void showSnapshotMenu(int snapshotIndex);
+    void paintSpectrum(juce::Graphics& g, juce::Rectangle<float> pad) const;
+    void timerCallback() override;
+
+    ParameterMorpher& morpher;
+    juce::AudioProcessorValueTreeState& apvts;
+
+    SpectrumAnalyser& analyser;
+
+    juce::ToggleButton morphEnableButton{ "Morph" };
+    juce::ToggleButton engineSpectraButton{ "Engines" };
+
+    // Latest analyser paths, in normalised coordinates
+    std::array<juce::Path, SpectrumAnalyser::numTaps> spectrumPaths;
+    std::array<bool, SpectrumAnalyser::numTaps> hasSpectrum{};
+    juce::uint32 spectrumVersion = 0;
+
+    int draggedSnapshot = -1;
+    bool draggingCursor = false;
+
+    static constexpr float snapshotRadius = 9.0f;
+    static constexpr int spectrumRefreshHz = 30;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UIGraph)
-};
\ No newline at end of file
+};
@@ -13,221 +13,112 @@
 #include "../Source/PluginProcessor.h"
 #include "../UI/PluginEditor.h"
 #include "../Source/UI/Components/UIGraph.h"
+#include "../Source/UI/Components/SectionGroup.h"
+#include "../Source/UI/Components/ModulationPage.h"
 
 //==============================================================================
 MechaSoundGeneratorAudioProcessorEditor::MechaSoundGeneratorAudioProcessorEditor(MechaSoundGeneratorAudioProcessor& p)
     : AudioProcessorEditor(&p), processorRef(p)
 {
-    // --- Hiss Section ---
-    // Hiss Level Slider & Label
-    addAndMakeVisible(hissLevelSlider);
-    addAndMakeVisible(hissLevelLabel);
-    hissLevelSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    hissLevelSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    hissLevelLabel.setText("Hiss Level", juce::dontSendNotification);
-    hissLevelLabel.attachToComponent(&hissLevelSlider, false);
-    hissLevelLabel.setJustificationType(juce::Justification::centredTop);
-    hissLevelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::hissLevel, hissLevelSlider);
-
-    // Hiss Cutoff Slider & Label
-    addAndMakeVisible(hissCutoffSlider);
-    addAndMakeVisible(hissCutoffLabel);
-    hissCutoffSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    hissCutoffSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    hissCutoffSlider.setSkewFactorFromMidPoint(1000.0); // Logarithmic scale for frequency
-    hissCutoffLabel.setText("Hiss Cutoff", juce::dontSendNotification);
-    hissCutoffLabel.attachToComponent(&hissCutoffSlider, false);
-    hissCutoffLabel.setJustificationType(juce::Justification::centredTop);
-    hissCutoffAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::hissCutoff, hissCutoffSlider);
-
-    // Hiss Resonance Slider & Label
-    addAndMakeVisible(hissResonanceSlider);
-    addAndMakeVisible(hissResonanceLabel);
-    hissResonanceSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    hissResonanceSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    hissResonanceLabel.setText("Hiss Reso", juce::dontSendNotification);
-    hissResonanceLabel.attachToComponent(&hissResonanceSlider, false);
-    hissResonanceLabel.setJustificationType(juce::Justification::centredTop);
-    hissResonanceAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::hissResonance, hissResonanceSlider);
-
-    // --- Servo Section ---
-    // Servo Level Slider & Label
-    addAndMakeVisible(servoLevelSlider);
-    addAndMakeVisible(servoLevelLabel);
-    servoLevelSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    servoLevelSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    servoLevelLabel.setText("Servo Level", juce::dontSendNotification);
-    servoLevelLabel.attachToComponent(&servoLevelSlider, false);
-    servoLevelLabel.setJustificationType(juce::Justification::centredTop);
-    servoLevelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::servoLevel, servoLevelSlider);
-
-    // Servo Pitch Slider & Label
-    addAndMakeVisible(servoPitchSlider);
-    addAndMakeVisible(servoPitchLabel);
-    servoPitchSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    servoPitchSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    servoPitchSlider.setSkewFactorFromMidPoint(500.0); // Logarithmic scale for frequency
-    servoPitchLabel.setText("Servo Pitch", juce::dontSendNotification);
-    servoPitchLabel.attachToComponent(&servoPitchSlider, false);
-    servoPitchLabel.setJustificationType(juce::Justification::centredTop);
-    servoPitchAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::servoPitch, servoPitchSlider);
-
-    // Servo Mod Depth Slider & Label
-    addAndMakeVisible(servoModDepthSlider);
-    addAndMakeVisible(servoModDepthLabel);
-    servoModDepthSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    servoModDepthSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    servoModDepthLabel.setText("Servo Mod Depth", juce::dontSendNotification);
-    servoModDepthLabel.attachToComponent(&servoModDepthSlider, false);
-    servoModDepthLabel.setJustificationType(juce::Justification::centredTop);
-    servoModDepthAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::servoModDepth, servoModDepthSlider);
-
-    // Servo Mod Rate Slider & Label
-    addAndMakeVisible(servoModRateSlider);
-    addAndMakeVisible(servoModRateLabel);
-    servoModRateSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    servoModRateSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    servoModRateSlider.setSkewFactorFromMidPoint(3.0); // Slight skew for rate
-    servoModRateLabel.setText("Servo Mod Rate", juce::dontSendNotification);
-    servoModRateLabel.attachToComponent(&servoModRateSlider, false);
-    servoModRateLabel.setJustificationType(juce::Justification::centredTop);
-    servoModRateAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::servoModRate, servoModRateSlider);
-
-    // --- PowerCore Section --- [cite: 35]
-// Hum Level
-    addAndMakeVisible(powerCoreHumLevelSlider);
-    addAndMakeVisible(powerCoreHumLevelLabel);
-    powerCoreHumLevelSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    powerCoreHumLevelSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    powerCoreHumLevelLabel.setText("PC Hum Level", juce::dontSendNotification);
-    powerCoreHumLevelLabel.attachToComponent(&powerCoreHumLevelSlider, false);
-    powerCoreHumLevelLabel.setJustificationType(juce::Justification::centredTop);
-    powerCoreHumLevelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::powerCoreHumLevel, powerCoreHumLevelSlider);
-
-    // Fundamental Pitch
-    addAndMakeVisible(powerCorePitchSlider);
-    addAndMakeVisible(powerCorePitchLabel);
-    powerCorePitchSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    powerCorePitchSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    powerCorePitchSlider.setSkewFactorFromMidPoint(100.0); // Log for pitch [cite: 10]
-    powerCorePitchLabel.setText("PC Pitch", juce::dontSendNotification);
-    powerCorePitchLabel.attachToComponent(&powerCorePitchSlider, false);
-    powerCorePitchLabel.setJustificationType(juce::Justification::centredTop);
-    powerCorePitchAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::powerCoreFundamentalPitch, powerCorePitchSlider);
-
-    // Hum Complexity
-    addAndMakeVisible(powerCoreComplexitySlider);
-    addAndMakeVisible(powerCoreComplexityLabel);
-    powerCoreComplexitySlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    powerCoreComplexitySlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    powerCoreComplexityLabel.setText("PC Complexity", juce::dontSendNotification);
-    powerCoreComplexityLabel.attachToComponent(&powerCoreComplexitySlider, false);
-    powerCoreComplexityLabel.setJustificationType(juce::Justification::centredTop);
-    powerCoreComplexityAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::powerCoreHumComplexity, powerCoreComplexitySlider);
-
-    // Pulsation Rate
-    addAndMakeVisible(powerCorePulsationRateSlider);
-    addAndMakeVisible(powerCorePulsationRateLabel);
-    powerCorePulsationRateSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    powerCorePulsationRateSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    powerCorePulsationRateLabel.setText("PC Pulse Rate", juce::dontSendNotification);
-    powerCorePulsationRateLabel.attachToComponent(&powerCorePulsationRateSlider, false);
-    powerCorePulsationRateLabel.setJustificationType(juce::Justification::centredTop);
-    powerCorePulsationRateAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::powerCorePulsationRate, powerCorePulsationRateSlider);
-
-    // Pulsation Depth
-    addAndMakeVisible(powerCorePulsationDepthSlider);
-    addAndMakeVisible(powerCorePulsationDepthLabel);
-    powerCorePulsationDepthSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    powerCorePulsationDepthSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    powerCorePulsationDepthLabel.setText("PC Pulse Depth", juce::dontSendNotification);
-    powerCorePulsationDepthLabel.attachToComponent(&powerCorePulsationDepthSlider, false);
-    powerCorePulsationDepthLabel.setJustificationType(juce::Justification::centredTop);
-    powerCorePulsationDepthAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::powerCorePulsationDepth, powerCorePulsationDepthSlider);
-
-    // Activation Trigger Button [cite: 10]
-    addAndMakeVisible(powerCoreActivationButton);
-    addAndMakeVisible(powerCoreActivationLabel);
-    powerCoreActivationButton.setButtonText("Activate");
-    powerCoreActivationLabel.setText("PC Activation", juce::dontSendNotification);
-    powerCoreActivationLabel.attachToComponent(&powerCoreActivationButton, false); // Adjust attachment if needed
-    powerCoreActivationLabel.setJustificationType(juce::Justification::centredTop); // Or leftOfComponent
-    powerCoreActivationAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
-        processorRef.apvts, ParameterIDs::powerCoreActivationTrigger, powerCoreActivationButton);
-
-    // Activation Time
-    addAndMakeVisible(powerCoreActivationTimeSlider);
-    addAndMakeVisible(powerCoreActivationTimeLabel);
-    powerCoreActivationTimeSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    powerCoreActivationTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    powerCoreActivationTimeLabel.setText("PC Act Time", juce::dontSendNotification);
-    powerCoreActivationTimeLabel.attachToComponent(&powerCoreActivationTimeSlider, false);
-    powerCoreActivationTimeLabel.setJustificationType(juce::Justification::centredTop);
-    powerCoreActivationTimeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::powerCoreActivationTime, powerCoreActivationTimeSlider);
-
-    // Energy Type
-    addAndMakeVisible(powerCoreEnergyTypeSlider);
-    addAndMakeVisible(powerCoreEnergyTypeLabel);
-    powerCoreEnergyTypeSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    powerCoreEnergyTypeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    powerCoreEnergyTypeLabel.setText("PC Energy Type", juce::dontSendNotification);
-    powerCoreEnergyTypeLabel.attachToComponent(&powerCoreEnergyTypeSlider, false);
-    powerCoreEnergyTypeLabel.setJustificationType(juce::Justification::centredTop);
-    powerCoreEnergyTypeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::powerCoreEnergyType, powerCoreEnergyTypeSlider);
-
-    // Filter Cutoff
-    addAndMakeVisible(powerCoreFilterCutoffSlider);
-    addAndMakeVisible(powerCoreFilterCutoffLabel);
-    powerCoreFilterCutoffSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    powerCoreFilterCutoffSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    powerCoreFilterCutoffSlider.setSkewFactorFromMidPoint(1000.0); // Log for frequency
-    powerCoreFilterCutoffLabel.setText("PC Filter Cutoff", juce::dontSendNotification);
-    powerCoreFilterCutoffLabel.attachToComponent(&powerCoreFilterCutoffSlider, false);
-    powerCoreFilterCutoffLabel.setJustificationType(juce::Justification::centredTop);
-    powerCoreFilterCutoffAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::powerCoreFilterCutoff, powerCoreFilterCutoffSlider);
-
-    // Filter Resonance
-    addAndMakeVisible(powerCoreFilterResonanceSlider);
-    addAndMakeVisible(powerCoreFilterResonanceLabel);
-    powerCoreFilterResonanceSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    powerCoreFilterResonanceSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    powerCoreFilterResonanceLabel.setText("PC Filter Reso", juce::dontSendNotification);
-    powerCoreFilterResonanceLabel.attachToComponent(&powerCoreFilterResonanceSlider, false);
-    powerCoreFilterResonanceLabel.setJustificationType(juce::Justification::centredTop);
-    powerCoreFilterResonanceAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::powerCoreFilterResonance, powerCoreFilterResonanceSlider);
-
-
-    // --- Master Section ---
-    // Master Gain Slider & Label
-    addAndMakeVisible(masterGainSlider);
-    addAndMakeVisible(masterGainLabel);
-    masterGainSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
-    masterGainSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 20);
-    masterGainLabel.setText("Master Gain", juce::dontSendNotification);
-    masterGainLabel.attachToComponent(&masterGainSlider, false);
-    masterGainLabel.setJustificationType(juce::Justification::centredTop);
-    masterGainAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        processorRef.apvts, ParameterIDs::masterGain, masterGainSlider);
+    // --- Parameter pages ---
+    // Only the page on screen builds its controls (see SectionGroup)
+    using Section = ParameterDescriptor::Section;
+    for (const auto section : { Section::hiss, Section::servo, Section::powerCore, Section::texture, Section::motion, Section::output })
+    {
+        sectionPages.push_back(std::make_unique<SectionGroup>(section, processorRef.apvts));
+        sectionTabs.addTab(SectionGroup::getSectionName(section), sectionBgColour, sectionPages.back().get(), false);
+    }
+    modulationPage = std::make_unique<ModulationPage>(processorRef);
+    sectionTabs.addTab("Modulation", sectionBgColour, modulationPage.get(), false);
+    sectionTabs.setCurrentTabIndex(0);
+    addAndMakeVisible(sectionTabs);
+
+    // --- Morph Pad ---
+    uiGraphArea = std::make_unique<UIGraph>(processorRef.getMorpher(), processorRef.apvts, processorRef.getSpectrumAnalyser());
+    addAndMakeVisible(*uiGraphArea);
+
+    // --- Engine Rack ---
+    addAndMakeVisible(engineListLabel);
+    engineListLabel.setJustificationType(juce::Justification::centredLeft);
+    addAndMakeVisible(addServoButton);
+    addAndMakeVisible(addPowerCoreButton);
+    addAndMakeVisible(addServoBankButton);
+    addAndMakeVisible(addGranularButton);
+    addAndMakeVisible(addFoleyButton);
+    addAndMakeVisible(loadFoleyButton);
+    addAndMakeVisible(loadGrainSourceButton);
+    addAndMakeVisible(removeEngineButton);
+    addServoButton.onClick = [this] { processorRef.addEngine(MechaSoundEngine::EngineType::servo); updateEngineListLabel(); };
+    addPowerCoreButton.onClick = [this] { processorRef.addEngine(MechaSoundEngine::EngineType::powerCore); updateEngineListLabel(); };
+    addServoBankButton.onClick = [this] { processorRef.addEngine(MechaSoundEngine::EngineType::servoBank); updateEngineListLabel(); };
+    addGranularButton.onClick = [this] { processorRef.addEngine(MechaSoundEngine::EngineType::granular); updateEngineListLabel(); };
+    addFoleyButton.onClick = [this] { processorRef.addEngine(MechaSoundEngine::EngineType::samplePlayback); updateEngineListLabel(); };
+    loadFoleyButton.onClick = [this] { chooseFoleyFile(); };
+    loadGrainSourceButton.onClick = [this] { chooseGrainSourceFile(); };
+    removeEngineButton.onClick = [this]
+    {
+        processorRef.removeEngine(static_cast<int>(processorRef.getEngineLayout().size()) - 1);
+        updateEngineListLabel();
+    };
+    updateEngineListLabel();
+
+    // --- Export ---
+    addAndMakeVisible(exportLengthBox);
+    addAndMakeVisible(exportButton);
+    addAndMakeVisible(exportProgressBar);
+    for (const int seconds : { 5, 10, 30, 60 })
+        exportLengthBox.addItem(juce::String(seconds) + " s", seconds);
+    exportLengthBox.setSelectedId(10, juce::dontSendNotification);
+    exportButton.onClick = [this] { exportOrCancel(); };
+    exportProgressBar.setTextToDisplay("Export a file");
+    if (processorRef.getExporter().isRendering()) // Reopened during an export
+    {
+        exportButton.setButtonText("Cancel Export");
+        exportProgressBar.setTextToDisplay({});
+        startTimerHz(15);
+    }
+
+    // --- Timeline ---
+    addAndMakeVisible(timelineLabel);
+    timelineLabel.setText("Timeline: at the next bar", juce::dontSendNotification);
+    addAndMakeVisible(activateAtBarButton);
+    addAndMakeVisible(deactivateAtBarButton);
+    addAndMakeVisible(sweepAtBarButton);
+    addAndMakeVisible(clearTimelineButton);
+    activateAtBarButton.onClick = [this]
+    {
+        TimelineEvent event;
+        event.type = TimelineEvent::Type::powerCoreActivate;
+        scheduleAtNextBar(event);
+    };
+    deactivateAtBarButton.onClick = [this]
+    {
+        TimelineEvent event;
+        event.type = TimelineEvent::Type::powerCoreDeactivate;
+        scheduleAtNextBar(event);
+    };
+    sweepAtBarButton.onClick = [this]
+    {
+        // One octave up from the current servo pitch, over two bars
+        const auto range = processorRef.apvts.getParameterRange(ParameterIDs::servoPitch);
+        const float pitch = processorRef.apvts.getRawParameterValue(ParameterIDs::servoPitch)->load();
+
+        TimelineEvent event;
+        event.type = TimelineEvent::Type::servoSweep;
+        event.lengthInBeats = sweepLengthBars * beatsPerBar;
+        event.startValue = pitch;
+        event.endValue = juce::jmin(range.end, 2.0f * pitch);
+        scheduleAtNextBar(event);
+    };
+    clearTimelineButton.onClick = [this]
+    {
+        processorRef.clearTimeline();
+        timelineLabel.setText("Timeline: cleared", juce::dontSendNotification);
+    };
 
     // Set the size of the editor window.
     // This size can be adjusted based on the number of controls and desired layout.
-    setSize(800, 500); // Increased height for more sliders
+    setSize(980, 600); // Parameter pages plus the morph pad on the right
 }
 
 MechaSoundGeneratorAudioProcessorEditor::~MechaSoundGeneratorAudioProcessorEditor()
@@ -235,6 +126,120 @@ MechaSoundGeneratorAudioProcessorEditor::~MechaSoundGeneratorAudioProcessorEdito
     // Attachments are std::unique_ptr, so they will be automatically cleaned up.
 }
 
+void MechaSoundGeneratorAudioProcessorEditor::updateEngineListLabel()
+{
+    const auto layout = processorRef.getEngineLayout();
+
+    juce::StringArray names;
+    for (const auto type : layout)
+        names.add(MechaSoundEngine::getEngineTypeName(type));
+    const auto foleyFile = processorRef.getFoleyFile();
+    const auto grainSourceFile = processorRef.getGrainSourceFile();
+    engineListLabel.setText("Engines: " + (names.isEmpty() ? juce::String("none") : names.joinIntoString(", "))
+                                + "\nFoley: " + (foleyFile == juce::File() ? juce::String("none") : foleyFile.getFileName())
+                                + "\nGrains: " + (grainSourceFile == juce::File() ? juce::String("gear grind") : grainSourceFile.getFileName()),
+                            juce::dontSendNotification);
+
+    const bool full = static_cast<int>(layout.size()) >= MechaSoundEngine::maxEngines;
+    addServoButton.setEnabled(!full);
+    addPowerCoreButton.setEnabled(!full);
+    addServoBankButton.setEnabled(!full);
+    addGranularButton.setEnabled(!full);
+    addFoleyButton.setEnabled(!full);
+    removeEngineButton.setEnabled(!layout.empty());
+}
+
+void MechaSoundGeneratorAudioProcessorEditor::exportOrCancel()
+{
+    if (processorRef.getExporter().isRendering())
+    {
+        processorRef.cancelExport();
+        return;
+    }
+
+    const auto defaultFile = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("MechaSound.wav");
+    exportChooser = std::make_unique<juce::FileChooser>("Export to WAV", defaultFile, "*.wav");
+    exportChooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles
+                                   | juce::FileBrowserComponent::warnAboutOverwriting,
+                               [this](const juce::FileChooser& chooser)
+    {
+        const auto file = chooser.getResult();
+        if (file == juce::File())
+            return;
+
+        if (!processorRef.startExport(file.withFileExtension("wav"), static_cast<double>(exportLengthBox.getSelectedId())))
+        {
+            exportProgressBar.setTextToDisplay("Export failed");
+            return;
+        }
+
+        exportButton.setButtonText("Cancel Export");
+        exportProgressBar.setTextToDisplay({}); // Shows the percentage
+        startTimerHz(15);
+    });
+}
+
+void MechaSoundGeneratorAudioProcessorEditor::timerCallback()
+{
+    const auto& exporter = processorRef.getExporter();
+    exportProgress = exporter.getProgress();
+
+    if (exporter.isRendering())
+        return;
+
+    stopTimer();
+    exportButton.setButtonText("Export...");
+    exportProgressBar.setTextToDisplay(exporter.getState() == OfflineRenderer::State::finished
+                                           ? "Exported " + exporter.getOutputFile().getFileName()
+                                           : juce::String("Export cancelled"));
+}
+
+void MechaSoundGeneratorAudioProcessorEditor::scheduleAtNextBar(TimelineEvent event)
+{
+    // The latest block's position is at most one buffer old, well short of a bar
+    const double bar = std::floor(processorRef.getLastTransportPosition() / beatsPerBar) + 1.0;
+    event.beat = bar * beatsPerBar;
+
+    timelineLabel.setText(processorRef.scheduleTimelineEvent(event)
+                              ? "Timeline: scheduled at bar " + juce::String(static_cast<int>(bar) + 1)
+                              : juce::String("Timeline: queue full, try again"),
+                          juce::dontSendNotification);
+}
+
+void MechaSoundGeneratorAudioProcessorEditor::chooseFoleyFile()
+{
+    foleyChooser = std::make_unique<juce::FileChooser>("Load a foley recording", processorRef.getFoleyFile(), "*.wav;*.raw");
+    foleyChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                              [this](const juce::FileChooser& chooser)
+    {
+        const auto file = chooser.getResult();
+        if (file == juce::File())
+            return;
+
+        if (!processorRef.loadFoleyFile(file))
+            juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Load Foley",
+                                                   "Could not map " + file.getFileName() + ".");
+        updateEngineListLabel();
+    });
+}
+
+void MechaSoundGeneratorAudioProcessorEditor::chooseGrainSourceFile()
+{
+    grainSourceChooser = std::make_unique<juce::FileChooser>("Load a grain source", processorRef.getGrainSourceFile(), "*.wav;*.aif;*.aiff;*.flac");
+    grainSourceChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                                    [this](const juce::FileChooser& chooser)
+    {
+        const auto file = chooser.getResult();
+        if (file == juce::File())
+            return;
+
+        if (!processorRef.loadGrainSourceFile(file))
+            juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Load Grain Source",
+                                                   "Could not read " + file.getFileName() + ".");
+        updateEngineListLabel();
+    });
+}
+
 //==============================================================================
 void MechaSoundGeneratorAudioProcessorEditor::paint(juce::Graphics& g)
 {
@@ -250,147 +255,61 @@ void MechaSoundGeneratorAudioProcessorEditor::paint(juce::Graphics& g)
 
 void MechaSoundGeneratorAudioProcessorEditor::resized()
 {
-    // This creates a grid layout with 8 knobs per row
-    // and reduces knob size by 20%
-
     auto bounds = getLocalBounds();
     bounds.reduce(20, 20); // Add some padding around the edges
 
-    // Reduced knob size by 20% (from 90 to 72)
-    int sliderWidth = 72;
-    int sliderHeight = 72;
-    int buttonHeight = 24; // For toggle button (also reduced by 20%)
-    int verticalSpacing = 8; // Space between rows
-    int horizontalSpacing = 8; // Space between columns
-    int sectionSpacing = 20; // Space between sections
-
-    // Calculate how many knobs can fit per row (max 8)
-    int knobsPerRow = 8;
-    int totalRowWidth = (knobsPerRow * sliderWidth) + ((knobsPerRow - 1) * horizontalSpacing);
-
-    // Center the grid if the window is wider than needed
-    int gridStartX = bounds.getX() + (bounds.getWidth() - totalRowWidth) / 2;
-    if (gridStartX < bounds.getX()) gridStartX = bounds.getX(); // Don't go outside bounds
-
-    int currentX = gridStartX;
-    int currentY = bounds.getY();
-    int currentKnobInRow = 0;
-
-    // Helper lambda to place a knob and advance position
-    auto placeKnob = [&](juce::Component& knob) {
-        knob.setBounds(currentX, currentY, sliderWidth, sliderHeight);
-        currentX += sliderWidth + horizontalSpacing;
-        currentKnobInRow++;
-
-        // Check if we need to move to next row
-        if (currentKnobInRow >= knobsPerRow) {
-            currentX = gridStartX;
-            currentY += sliderHeight + verticalSpacing;
-            currentKnobInRow = 0;
-        }
-        };
-
-    // Helper lambda to place a button (different height)
-    auto placeButton = [&](juce::Component& button) {
-        // Center the button vertically within the knob height space
-        int buttonY = currentY + (sliderHeight - buttonHeight) / 2;
-        button.setBounds(currentX, buttonY, sliderWidth, buttonHeight);
-        currentX += sliderWidth + horizontalSpacing;
-        currentKnobInRow++;
-
-        // Check if we need to move to next row
-        if (currentKnobInRow >= knobsPerRow) {
-            currentX = gridStartX;
-            currentY += sliderHeight + verticalSpacing;
-            currentKnobInRow = 0;
-        }
-        };
-
-    // Helper lambda to start a new section
-    auto startNewSection = [&]() {
-        if (currentKnobInRow > 0) {
-            // Move to next row if current row is not empty
-            currentX = gridStartX;
-            currentY += sliderHeight + verticalSpacing;
-            currentKnobInRow = 0;
-        }
-        // Add section spacing
-        currentY += sectionSpacing;
-        };
-
-    // --- Hiss Section ---
-    placeKnob(hissLevelSlider);
-    placeKnob(hissCutoffSlider);
-    placeKnob(hissResonanceSlider);
-
-    startNewSection();
-
-    // --- Servo Section ---
-    placeKnob(servoLevelSlider);
-    placeKnob(servoPitchSlider);
-    placeKnob(servoModDepthSlider);
-    placeKnob(servoModRateSlider);
-
-    startNewSection();
-
-    // --- PowerCore Section ---
-    placeKnob(powerCoreHumLevelSlider);
-    placeKnob(powerCorePitchSlider);
-    placeKnob(powerCoreComplexitySlider);
-    placeKnob(powerCorePulsationRateSlider);
-    placeKnob(powerCorePulsationDepthSlider);
-
-    // Special handling for the activation button
-    placeButton(powerCoreActivationButton);
-
-    placeKnob(powerCoreActivationTimeSlider);
-    placeKnob(powerCoreEnergyTypeSlider);
-    placeKnob(powerCoreFilterCutoffSlider);
-    placeKnob(powerCoreFilterResonanceSlider);
-
-    startNewSection();
-
-    // --- Master Section ---
-    placeKnob(masterGainSlider);
-
-    // Calculate the total height needed and update window size if necessary
-    int totalHeight = currentY + sliderHeight + 40; // Add bottom padding
-    if (currentKnobInRow > 0) {
-        // Account for the last row
-        totalHeight = currentY + sliderHeight + 40;
+    // Morph pad takes a square on the right, the parameter pages use the rest
+    if (uiGraphArea != nullptr)
+    {
+        auto graphBounds = bounds.removeFromRight(280);
+        bounds.removeFromRight(20);
+        uiGraphArea->setBounds(graphBounds.removeFromTop(280));
+
+        graphBounds.removeFromTop(12);
+        engineListLabel.setBounds(graphBounds.removeFromTop(54));
+        auto buttonRow = graphBounds.removeFromTop(24);
+        const int buttonWidth = (buttonRow.getWidth() - 24) / 4;
+        addServoButton.setBounds(buttonRow.removeFromLeft(buttonWidth));
+        buttonRow.removeFromLeft(8);
+        addPowerCoreButton.setBounds(buttonRow.removeFromLeft(buttonWidth));
+        buttonRow.removeFromLeft(8);
+        addServoBankButton.setBounds(buttonRow.removeFromLeft(buttonWidth));
+        buttonRow.removeFromLeft(8);
+        addGranularButton.setBounds(buttonRow);
+
+        graphBounds.removeFromTop(8);
+        auto secondRow = graphBounds.removeFromTop(24);
+        const int secondWidth = (secondRow.getWidth() - 24) / 4;
+        addFoleyButton.setBounds(secondRow.removeFromLeft(secondWidth));
+        secondRow.removeFromLeft(8);
+        loadFoleyButton.setBounds(secondRow.removeFromLeft(secondWidth));
+        secondRow.removeFromLeft(8);
+        loadGrainSourceButton.setBounds(secondRow.removeFromLeft(secondWidth));
+        secondRow.removeFromLeft(8);
+        removeEngineButton.setBounds(secondRow);
+
+        graphBounds.removeFromTop(16);
+        auto exportRow = graphBounds.removeFromTop(24);
+        exportLengthBox.setBounds(exportRow.removeFromLeft(exportRow.getWidth() / 3));
+        exportRow.removeFromLeft(8);
+        exportButton.setBounds(exportRow);
+
+        graphBounds.removeFromTop(8);
+        exportProgressBar.setBounds(graphBounds.removeFromTop(20));
+
+        graphBounds.removeFromTop(12);
+        timelineLabel.setBounds(graphBounds.removeFromTop(20));
+        auto timelineRow = graphBounds.removeFromTop(24);
+        const int timelineWidth = (timelineRow.getWidth() - 24) / 4;
+        activateAtBarButton.setBounds(timelineRow.removeFromLeft(timelineWidth));
+        timelineRow.removeFromLeft(8);
+        deactivateAtBarButton.setBounds(timelineRow.removeFromLeft(timelineWidth));
+        timelineRow.removeFromLeft(8);
+        sweepAtBarButton.setBounds(timelineRow.removeFromLeft(timelineWidth));
+        timelineRow.removeFromLeft(8);
+        clearTimelineButton.setBounds(timelineRow);
     }
 
-    // Update the plugin window size if needed
-    // Note: You might want to call this in the constructor instead
-    // setSize(totalRowWidth + 40, totalHeight);
-}
-
-// Updated constructor section - Add this to your constructor after creating all sliders:
-void MechaSoundGeneratorAudioProcessorEditor::setupSlidersWithReducedSize()
-{
-    // Set reduced text box size for all sliders (20% smaller)
-    int textBoxWidth = 64;  // Reduced from 80
-    int textBoxHeight = 16; // Reduced from 20
-
-    // Apply to all sliders
-    hissLevelSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    hissCutoffSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    hissResonanceSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-
-    servoLevelSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    servoPitchSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    servoModDepthSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    servoModRateSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-
-    powerCoreHumLevelSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    powerCorePitchSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    powerCoreComplexitySlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    powerCorePulsationRateSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    powerCorePulsationDepthSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    powerCoreActivationTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    powerCoreEnergyTypeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    powerCoreFilterCutoffSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-    powerCoreFilterResonanceSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
-
-    masterGainSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, textBoxWidth, textBoxHeight);
+    // Parameter pages fill the rest
+    sectionTabs.setBounds(bounds);
 }
\ No newline at end of file
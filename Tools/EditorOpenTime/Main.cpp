@@ -0,0 +1,99 @@
+// Tools/EditorOpenTime/Main.cpp
+//
+// Editor open-time check. Build as a JUCE console application from the
+// plugin's Source folder and JUCE modules (including juce_gui_basics),
+// without a plugin wrapper.
+//
+//   EditorOpenTime [--opens N] [--budget MS]
+//
+// Opens the editor N times (10 by default) the way a host does: the
+// processor creates it, it is laid out at its own size and its first frame
+// is painted. Each open is timed from createEditor() to the end of that
+// paint, and fails if it takes longer than the budget (50 ms by default).
+// The first open counts too, since that is the one the user waits for.
+//
+// Only the parameter page on screen builds its controls (SectionGroup), so
+// the time should not grow with the size of the parameter table. The exit
+// code is the number of opens over budget.
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <iostream>
+#include <memory>
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    struct OpenTime
+    {
+        double constructMs = 0.0;
+        double paintMs = 0.0;
+    };
+
+    OpenTime openEditor(MechaSoundGeneratorAudioProcessor& processor)
+    {
+        OpenTime time;
+        const auto startMs = juce::Time::getMillisecondCounterHiRes();
+
+        std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditorIfNeeded());
+        const auto constructedMs = juce::Time::getMillisecondCounterHiRes();
+
+        // Paints the whole tree once, as the first frame on screen would
+        editor->createComponentSnapshot(editor->getLocalBounds());
+        const auto paintedMs = juce::Time::getMillisecondCounterHiRes();
+
+        time.constructMs = constructedMs - startMs;
+        time.paintMs = paintedMs - constructedMs;
+        return time; // Deleting the editor detaches it from the processor
+    }
+
+    juce::String column(const juce::String& text, int width)
+    {
+        return text.substring(0, width).paddedRight(' ', width + 1);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser; // Components need a message manager
+
+    int opens = 10;
+    double budgetMs = 50.0;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        const juce::String flag(argv[i]);
+        const juce::String value(argv[i + 1]);
+        if (flag == "--opens")
+            opens = juce::jmax(1, value.getIntValue());
+        else if (flag == "--budget")
+            budgetMs = juce::jmax(1.0, value.getDoubleValue());
+    }
+
+    MechaSoundGeneratorAudioProcessor processor;
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    std::cout << opens << " opens, budget " << budgetMs << " ms\n\n";
+    std::cout << column("Open", 5) << column("Construct ms", 13) << column("Paint ms", 9) << column("Total ms", 9) << "Result\n";
+
+    int failures = 0;
+    for (int open = 1; open <= opens; ++open)
+    {
+        const auto time = openEditor(processor);
+        const double totalMs = time.constructMs + time.paintMs;
+        const bool passed = totalMs <= budgetMs;
+        failures += passed ? 0 : 1;
+
+        std::cout << column(juce::String(open), 5) << column(juce::String(time.constructMs, 2), 13)
+                  << column(juce::String(time.paintMs, 2), 9) << column(juce::String(totalMs, 2), 9)
+                  << (passed ? "pass" : "OVER BUDGET") << "\n" << std::flush;
+    }
+
+    processor.releaseResources();
+
+    std::cout << "\n" << (failures == 0 ? juce::String("All opens within budget") : juce::String(failures) + " over budget") << "\n";
+    return failures;
+}
@@ -0,0 +1,116 @@
+// Tools/FastMathTests/Main.cpp
+//
+// Unit tests for the FastMath kernels. FastMath.h needs nothing but the
+// standard library, so this builds as a plain console application:
+//
+//   c++ -std=c++17 -O2 Tools/FastMathTests/Main.cpp -o FastMathTests
+//
+// Sweeps every kernel at both approximate precisions densely over the domain
+// its documented error is quoted for, against the std double-precision
+// result, and fails when the measured maximum error exceeds the figure in
+// the table at the top of FastMath.h. It also checks the edges the sweeps do
+// not reach: sin/cos far outside one period, at the int conversion limit and
+// at inf/NaN (bounded, no undefined behaviour), exp2 clamping and tanh
+// saturation. The exit code is the number of failed checks.
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include "../../Source/AudioEngine/FastMath.h"
+
+namespace
+{
+    using FastMath::Precision;
+
+    constexpr int sweepPoints = 1 << 20;
+
+    enum class ErrorKind
+    {
+        absolute,
+        relative
+    };
+
+    int failures = 0;
+
+    void report(const std::string& name, bool passed, const std::string& detail)
+    {
+        failures += passed ? 0 : 1;
+        std::cout << std::left << std::setw(28) << name << std::setw(6) << (passed ? "pass" : "FAIL") << detail << "\n";
+    }
+
+    // Maximum error of 'approximation' against 'reference' over [low, high]
+    double sweep(const std::function<float(float)>& approximation, const std::function<double(double)>& reference,
+                 double low, double high, ErrorKind kind)
+    {
+        double maxError = 0.0;
+        for (int i = 0; i <= sweepPoints; ++i)
+        {
+            const auto x = static_cast<float>(low + (high - low) * i / sweepPoints);
+            const double expected = reference(static_cast<double>(x));
+            const double error = std::abs(static_cast<double>(approximation(x)) - expected);
+            maxError = std::max(maxError, kind == ErrorKind::relative ? error / std::abs(expected) : error);
+        }
+        return maxError;
+    }
+
+    void checkSweep(const std::string& name, const std::function<float(float)>& approximation,
+                    const std::function<double(double)>& reference, double low, double high, ErrorKind kind, double limit)
+    {
+        const double error = sweep(approximation, reference, low, high, kind);
+        std::ostringstream detail;
+        detail << std::scientific << std::setprecision(2) << error << (kind == ErrorKind::relative ? " rel" : " abs")
+               << " (limit " << limit << ")";
+        report(name, error <= limit, detail.str());
+    }
+
+    template <Precision P>
+    void checkPrecision(const std::string& suffix, double sinLimit, double tanhLimit, double exp2Limit, double tanLimit)
+    {
+        const double pi = 3.14159265358979323846;
+
+        checkSweep("sin " + suffix, FastMath::sin<P>, [](double x) { return std::sin(x); }, -pi, pi, ErrorKind::absolute, sinLimit);
+        checkSweep("cos " + suffix, FastMath::cos<P>, [](double x) { return std::cos(x); }, -pi, pi, ErrorKind::absolute, sinLimit);
+        checkSweep("tanh " + suffix, FastMath::tanh<P>, [](double x) { return std::tanh(x); }, -20.0, 20.0, ErrorKind::absolute, tanhLimit);
+        checkSweep("exp2 " + suffix, FastMath::exp2<P>, [](double x) { return std::exp2(x); }, -126.0, 127.0, ErrorKind::relative, exp2Limit);
+        checkSweep("tan " + suffix, FastMath::tan<P>, [](double x) { return std::tan(x); }, 1.0e-3, 0.45 * pi, ErrorKind::relative, tanLimit);
+
+        // Phases a long way from zero, as a free-running oscillator produces them
+        checkSweep("sin " + suffix + " |x| <= 64", FastMath::sin<P>, [](double x) { return std::sin(x); }, -64.0, 64.0,
+                   ErrorKind::absolute, sinLimit + 3.0e-6);
+
+        // Past the int conversion limit, at infinity and at NaN the result must stay finite and bounded
+        const float extremes[] = { 6.7e9f, -6.7e9f, 1.0e20f, -1.0e30f, std::numeric_limits<float>::max(),
+                                   std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                                   std::numeric_limits<float>::quiet_NaN() };
+        bool bounded = true;
+        for (const float x : extremes)
+        {
+            const float s = FastMath::sin<P>(x);
+            const float c = FastMath::cos<P>(x);
+            bounded = bounded && std::isfinite(s) && std::isfinite(c) && std::abs(s) <= 1.001f && std::abs(c) <= 1.001f;
+        }
+        report("sin/cos " + suffix + " extremes", bounded, "finite and within +-1");
+
+        // exp2 clamps to the normal range, tanh saturates exactly
+        const bool exp2Clamped = FastMath::exp2<P>(-1000.0f) > 0.0f && std::isfinite(FastMath::exp2<P>(1000.0f));
+        report("exp2 " + suffix + " clamping", exp2Clamped, "positive and finite outside -126 .. 127");
+
+        const bool tanhSaturates = FastMath::tanh<P>(100.0f) == 1.0f && FastMath::tanh<P>(-100.0f) == -1.0f;
+        report("tanh " + suffix + " saturation", tanhSaturates, "exactly +-1 at |x| = 100");
+    }
+}
+
+int main()
+{
+    // Limits from the table in FastMath.h, rounded up in the last digit
+    checkPrecision<Precision::accurate>("accurate", 7.8e-7, 2.1e-7, 1.7e-7, 4.2e-6);
+    checkPrecision<Precision::fast>("fast", 6.9e-5, 2.5e-2, 7.6e-5, 3.8e-4);
+
+    std::cout << "\n" << (failures == 0 ? std::string("All checks passed") : std::to_string(failures) + " failed") << "\n";
+    return failures;
+}
@@ -0,0 +1,344 @@
+// Tools/GoldenRender/Main.cpp
+//
+// Golden-render regression suite. Build as a JUCE console application from
+// the plugin's Source folder and JUCE modules, without a plugin wrapper.
+//
+//   GoldenRender [--references DIR] [--tolerance DB]
+//   GoldenRender --update --baseline REVISION [--references DIR]
+//
+// Renders a fixed set of parameter sets through MechaSoundEngine and the
+// master limiter, the way OfflineRenderer does, with a fixed noise seed. Every
+// other random source in the engines is seeded already, so each render is
+// the same on every run and build. Each case is compared sample by sample
+// against its stored reference, DIR/<case>.wav (32-bit float), and passes
+// when the largest difference is at or below the tolerance (in dBFS, -90 by
+// default). A missing or unreadable reference fails its case, and a missing
+// DIR/baseline.txt fails them all. The exit code is the number of failed cases.
+//
+// References must come from the engines as they were before the optimisation
+// under test, or the suite only compares the new code with itself. Build this
+// tool against that revision and run it with --update --baseline REVISION: it
+// writes the renders and records REVISION in DIR/baseline.txt, which every
+// comparison run prints. --update never replaces an existing reference; to
+// move to a new baseline, delete the old files deliberately first. 'max dBFS'
+// then shows how far the optimised engines moved from the baseline, or -inf
+// when they are bit-exact.
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include "../../Source/AudioEngine/MechaSoundEngine.h"
+#include "../../Source/AudioEngine/ImpulseResponseLibrary.h"
+#include "../../Source/AudioEngine/LookaheadLimiter.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numChannels = 2;
+    constexpr int blockSize = 512;
+    constexpr double caseSeconds = 2.0;
+    constexpr juce::int64 noiseSeed = 20240601;
+    constexpr int kernelTimeoutMilliseconds = 10000;
+
+    struct Case
+    {
+        juce::String name;
+        EngineParameterSet params;
+    };
+
+    constexpr const char* baselineFileName = "baseline.txt";
+
+    struct Comparison
+    {
+        bool hasReference = false;
+        double maxErrorDb = -std::numeric_limits<double>::infinity();
+        double rmsErrorDb = -std::numeric_limits<double>::infinity();
+    };
+
+    double toDb(double gain)
+    {
+        return gain > 0.0 ? 20.0 * std::log10(gain) : -std::numeric_limits<double>::infinity();
+    }
+
+    //==============================================================================
+    // The reference sounds: each engine on its own, then the shared stages
+    std::vector<Case> createCases()
+    {
+        std::vector<Case> cases;
+
+        auto addCase = [&cases](const char* name, auto&& configure)
+        {
+            Case c{ name, {} };
+            configure(c.params);
+            cases.push_back(c);
+        };
+
+        auto powerCore = [](EngineParameterSet& p)
+        {
+            p.powerCore.humLevel = 0.7f;
+            p.powerCore.activationTrigger = true;
+            p.powerCore.activationTime = 0.5f;
+            p.powerCore.humComplexity = 0.6f;
+            p.powerCore.filterCutoff = 3000.0f;
+            p.powerCore.filterResonance = 2.0f;
+        };
+
+        addCase("powercore", powerCore);
+
+        addCase("hiss-pink", [](EngineParameterSet& p)
+        {
+            p.hiss.level = 0.3f;
+            p.hiss.colour = 1;
+            p.hiss.cutoff = 4000.0f;
+            p.hiss.resonanceQ = 2.0f;
+        });
+
+        addCase("servo", [](EngineParameterSet& p)
+        {
+            p.servo.level = 0.4f;
+            p.servo.pitch = 300.0f;
+            p.servo.modDepth = 0.2f;
+            p.servo.modRate = 2.0f;
+        });
+
+        addCase("granular", [](EngineParameterSet& p)
+        {
+            p.granular.level = 0.5f;
+            p.granular.density = 40.0f;
+            p.granular.spray = 0.4f;
+        });
+
+        addCase("hull", [&](EngineParameterSet& p)
+        {
+            powerCore(p);
+            p.convolution.space = ImpulseResponseLibrary::metalHull;
+            p.convolution.mix = 0.5f;
+        });
+
+        addCase("motion", [&](EngineParameterSet& p)
+        {
+            powerCore(p);
+            p.servo.level = 0.4f;
+            p.spatial.enabled = true;
+            p.spatial.azimuth = 30.0f;
+            p.spatial.distance = 5.0f;
+        });
+
+        addCase("limited", [&](EngineParameterSet& p)
+        {
+            powerCore(p);
+            p.powerCore.humLevel = 1.0f;
+            p.hiss.level = 0.5f;
+            p.servo.level = 0.8f;
+            p.granular.level = 0.8f;
+            p.limiter.enabled = true;
+            p.limiter.ceilingDb = -3.0f;
+        });
+
+        return cases;
+    }
+
+    //==============================================================================
+    bool waitForKernel(const ImpulseResponseLibrary& library, int space)
+    {
+        for (int waited = 0; space != ImpulseResponseLibrary::off && library.getKernel(space) == nullptr; waited += 10)
+        {
+            if (waited >= kernelTimeoutMilliseconds)
+                return false;
+            juce::Thread::sleep(10);
+        }
+        return true;
+    }
+
+    juce::AudioBuffer<float> render(const Case& c, const ImpulseResponseLibrary& library)
+    {
+        const juce::dsp::ProcessSpec spec{ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) };
+
+        MechaSoundEngine engine;
+        engine.setImpulseResponseLibrary(&library);
+        engine.setNoiseSeed(noiseSeed);
+        engine.setNonRealtime(true);
+        engine.prepare(spec);
+
+        LookaheadLimiter limiter;
+        limiter.prepare(spec);
+        limiter.setParameters(c.params.limiter);
+
+        const int totalSamples = static_cast<int>(caseSeconds * sampleRate);
+        juce::AudioBuffer<float> output(numChannels, totalSamples);
+        output.clear();
+
+        TransportState transport;
+        transport.isPlaying = true;
+
+        for (int start = 0; start < totalSamples; start += blockSize)
+        {
+            const int numSamples = juce::jmin(blockSize, totalSamples - start);
+            const auto block = juce::dsp::AudioBlock<float>(output).getSubBlock(static_cast<size_t>(start), static_cast<size_t>(numSamples));
+
+            engine.setTransport(transport);
+            engine.process(block, c.params);
+            limiter.process(block);
+
+            transport.ppqPosition += numSamples * transport.bpm / (60.0 * sampleRate);
+        }
+
+        return output;
+    }
+
+    //==============================================================================
+    bool writeReference(const juce::File& file, const juce::AudioBuffer<float>& audio)
+    {
+        file.deleteFile();
+        auto stream = file.createOutputStream();
+        if (stream == nullptr || stream->failedToOpen())
+            return false;
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(juce::WavAudioFormat().createWriterFor(
+            stream.get(), sampleRate, static_cast<unsigned int>(numChannels), 32, {}, 0));
+        if (writer == nullptr)
+            return false;
+        stream.release(); // Owned by the writer from here on
+
+        return writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+    }
+
+    Comparison compare(const juce::File& file, const juce::AudioBuffer<float>& audio)
+    {
+        Comparison result;
+
+        std::unique_ptr<juce::AudioFormatReader> reader(juce::WavAudioFormat().createReaderFor(file.createInputStream().release(), true));
+        if (reader == nullptr || static_cast<int>(reader->numChannels) != audio.getNumChannels()
+            || reader->lengthInSamples != audio.getNumSamples())
+            return result;
+
+        juce::AudioBuffer<float> reference(audio.getNumChannels(), audio.getNumSamples());
+        if (!reader->read(&reference, 0, reference.getNumSamples(), 0, true, true))
+            return result;
+
+        double maxError = 0.0;
+        double sumSquares = 0.0;
+        for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+        {
+            const float* rendered = audio.getReadPointer(channel);
+            const float* expected = reference.getReadPointer(channel);
+            for (int i = 0; i < audio.getNumSamples(); ++i)
+            {
+                const double error = static_cast<double>(rendered[i]) - expected[i];
+                maxError = juce::jmax(maxError, std::abs(error));
+                sumSquares += error * error;
+            }
+        }
+
+        result.hasReference = true;
+        result.maxErrorDb = toDb(maxError);
+        result.rmsErrorDb = toDb(std::sqrt(sumSquares / (static_cast<double>(audio.getNumChannels()) * audio.getNumSamples())));
+        return result;
+    }
+
+    juce::String column(const juce::String& text, int width)
+    {
+        return text.substring(0, width).paddedRight(' ', width + 1);
+    }
+
+    juce::String formatDb(double db)
+    {
+        return std::isfinite(db) ? juce::String(db, 1) : juce::String("-inf");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser; // The kernel builder and prefetch threads expect a message manager
+
+    auto referenceDirectory = juce::File::getCurrentWorkingDirectory().getChildFile("Tools/GoldenRender/References");
+    double toleranceDb = -90.0;
+    bool update = false;
+    juce::String baseline;
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String flag(argv[i]);
+        const juce::String value(i + 1 < argc ? argv[i + 1] : "");
+        if (flag == "--update")
+            update = true;
+        else if (flag == "--references" && value.isNotEmpty())
+            referenceDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+        else if (flag == "--tolerance" && value.isNotEmpty())
+            toleranceDb = value.getDoubleValue();
+        else if (flag == "--baseline" && value.isNotEmpty())
+            baseline = value;
+    }
+
+    const auto cases = createCases();
+    const auto baselineFile = referenceDirectory.getChildFile(baselineFileName);
+
+    if (update)
+    {
+        if (baseline.isEmpty())
+        {
+            std::cout << "--update needs --baseline REVISION: the revision this build renders\n";
+            return 1;
+        }
+        if (!referenceDirectory.createDirectory() || !baselineFile.replaceWithText(baseline + "\n"))
+        {
+            std::cout << "Cannot write to " << referenceDirectory.getFullPathName() << "\n";
+            return 1;
+        }
+    }
+    else if (!baselineFile.existsAsFile())
+    {
+        std::cout << "No references in " << referenceDirectory.getFullPathName()
+                  << ": render them from the baseline engines with --update --baseline REVISION\n";
+        return static_cast<int>(cases.size());
+    }
+    else
+    {
+        baseline = baselineFile.loadFileAsString().trim();
+    }
+
+    ImpulseResponseLibrary library;
+    library.prepare(sampleRate);
+
+    std::cout << (update ? "Updating references in " : "Comparing against ") << referenceDirectory.getFullPathName()
+              << " (baseline " << baseline << ", seed " << noiseSeed << ", " << caseSeconds << " s at " << sampleRate << " Hz"
+              << (update ? ")\n\n" : ", tolerance " + juce::String(toleranceDb, 1) + " dBFS)\n\n");
+    std::cout << column("Case", 12) << column("max dBFS", 9) << column("rms dBFS", 9) << "Result\n";
+
+    int failures = 0;
+    for (const auto& c : cases)
+    {
+        if (!waitForKernel(library, c.params.convolution.space))
+        {
+            std::cout << column(c.name, 12) << "no kernel\n";
+            ++failures;
+            continue;
+        }
+
+        const auto audio = render(c, library);
+        const auto file = referenceDirectory.getChildFile(c.name + ".wav");
+
+        if (update)
+        {
+            // A reference that exists may be the baseline; it is never overwritten
+            const bool exists = file.existsAsFile();
+            const bool written = !exists && writeReference(file, audio);
+            failures += (exists || written) ? 0 : 1;
+            std::cout << column(c.name, 12) << column("", 9) << column("", 9)
+                      << (exists ? "kept existing" : (written ? "written" : "write failed")) << "\n";
+            continue;
+        }
+
+        const auto comparison = compare(file, audio);
+        const bool passed = comparison.hasReference && comparison.maxErrorDb <= toleranceDb;
+        failures += passed ? 0 : 1;
+
+        std::cout << column(c.name, 12) << column(formatDb(comparison.maxErrorDb), 9) << column(formatDb(comparison.rmsErrorDb), 9)
+                  << (comparison.hasReference ? (passed ? "pass" : "FAIL") : "FAIL: reference missing or unreadable") << "\n" << std::flush;
+    }
+
+    std::cout << "\n" << (failures == 0 ? juce::String("All cases passed") : juce::String(failures) + " failed") << "\n";
+    return failures;
+}
@@ -0,0 +1,237 @@
+// Tools/LatencyHarness/Main.cpp
+//
+// Worst-case block latency harness. Build as a JUCE console application from
+// the plugin's Source folder and JUCE modules, without a plugin wrapper.
+//
+//   LatencyHarness [--blocks N] [--block B] [--rate R] [--seed S]
+//
+// Drives processBlock for N blocks (a million by default) while automating
+// parameters the way a host would between blocks:
+//
+//   activation toggles   powerCoreActivationTrigger flips every few seconds
+//   complexity jumps     powerCoreHumComplexity jumps to a random value
+//   filter sweeps        bursts of per-block moves of the PowerCore and hiss
+//                        cutoffs, a few hundred milliseconds long
+//
+// Event times are drawn from a seeded juce::Random, so runs are repeatable.
+// The processor times each block itself (BlockLatencyHistogram) and tags the
+// parameter events that preceded each outlier. The harness prints the
+// histogram, p50/p99/p99.9/max, how many outliers followed each kind of
+// event, and the most recent outliers.
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_events/juce_events.h>
+#include <iostream>
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int kernelBuildMilliseconds = 1000;
+    constexpr int histogramBarWidth = 50;
+
+    // Mean gaps between events, in seconds of audio
+    constexpr double activationTogglePeriod = 4.0;
+    constexpr double complexityJumpPeriod = 1.0;
+    constexpr double filterSweepPeriod = 2.0;
+    constexpr double filterSweepLength = 0.25;
+
+    struct Settings
+    {
+        juce::int64 blocks = 1000000;
+        int blockSize = 256;
+        double sampleRate = 48000.0;
+        juce::int64 seed = 1;
+    };
+
+    void setParameter(MechaSoundGeneratorAudioProcessor& processor, const char* id, float value)
+    {
+        if (auto* parameter = processor.apvts.getParameter(id))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    //==============================================================================
+    // Host-side automation: decides, before each block, which parameters move
+    class Automation
+    {
+    public:
+        Automation(MechaSoundGeneratorAudioProcessor& processorToDrive, const Settings& settings)
+            : processor(processorToDrive),
+              random(settings.seed),
+              blockSeconds(settings.blockSize / settings.sampleRate),
+              sweepBlocks(juce::jmax(1, juce::roundToInt(filterSweepLength / blockSeconds)))
+        {
+        }
+
+        // A sound where every event has something to act on
+        void setUp()
+        {
+            setParameter(processor, ParameterIDs::powerCoreHumLevel, 0.7f);
+            setParameter(processor, ParameterIDs::powerCoreActivationTrigger, 1.0f);
+            setParameter(processor, ParameterIDs::powerCoreHumComplexity, 0.5f);
+            setParameter(processor, ParameterIDs::hissLevel, 0.2f);
+            setParameter(processor, ParameterIDs::servoLevel, 0.3f);
+        }
+
+        void beforeBlock()
+        {
+            if (happens(activationTogglePeriod))
+            {
+                activated = !activated;
+                setParameter(processor, ParameterIDs::powerCoreActivationTrigger, activated ? 1.0f : 0.0f);
+                ++activationToggles;
+            }
+
+            if (happens(complexityJumpPeriod))
+            {
+                setParameter(processor, ParameterIDs::powerCoreHumComplexity, random.nextFloat());
+                ++complexityJumps;
+            }
+
+            if (sweepRemaining == 0 && happens(filterSweepPeriod))
+            {
+                sweepRemaining = sweepBlocks;
+                ++filterSweeps;
+            }
+
+            if (sweepRemaining > 0)
+            {
+                // One exponential sweep from 100 Hz to 10 kHz over the burst
+                const float position = 1.0f - static_cast<float>(--sweepRemaining) / static_cast<float>(sweepBlocks);
+                const float cutoff = 100.0f * std::pow(100.0f, position);
+                setParameter(processor, ParameterIDs::powerCoreFilterCutoff, cutoff);
+                setParameter(processor, ParameterIDs::hissCutoff, cutoff);
+            }
+        }
+
+        juce::int64 activationToggles = 0;
+        juce::int64 complexityJumps = 0;
+        juce::int64 filterSweeps = 0;
+
+    private:
+        // True with the probability that gives one event per 'periodSeconds' on average
+        bool happens(double periodSeconds)
+        {
+            return random.nextDouble() < blockSeconds / periodSeconds;
+        }
+
+        MechaSoundGeneratorAudioProcessor& processor;
+        juce::Random random;
+        const double blockSeconds;
+        const int sweepBlocks;
+        int sweepRemaining = 0;
+        bool activated = true;
+    };
+
+    //==============================================================================
+    juce::String column(const juce::String& text, int width)
+    {
+        return text.substring(0, width).paddedRight(' ', width + 1);
+    }
+
+    void printHistogram(const BlockLatencyHistogram::Report& report)
+    {
+        juce::uint64 largest = 0;
+        for (const auto count : report.bucketCounts)
+            largest = juce::jmax(largest, count);
+        if (largest == 0)
+            return;
+
+        std::cout << column("<= us", 10) << column("Blocks", 10) << "\n";
+        for (size_t bucket = 0; bucket < report.bucketCounts.size(); ++bucket)
+        {
+            const auto count = report.bucketCounts[bucket];
+            if (count == 0)
+                continue;
+
+            // Log scale, so single outliers still show
+            const auto bar = juce::jmax(1, juce::roundToInt(histogramBarWidth * std::log1p(static_cast<double>(count))
+                                                            / std::log1p(static_cast<double>(largest))));
+            std::cout << column(juce::String(BlockLatencyHistogram::getBucketUpperEdge(static_cast<int>(bucket)), 1), 10)
+                      << column(juce::String(static_cast<juce::int64>(count)), 10)
+                      << juce::String::repeatedString("#", bar) << "\n";
+        }
+    }
+
+    void printOutliersByEvent(const BlockLatencyHistogram::Report& report)
+    {
+        std::cout << "\nOutliers (over " << BlockLatencyHistogram::outlierFactor << "x the running average): "
+                  << static_cast<juce::int64>(report.numOutliers) << "\n";
+
+        for (int flag = 0; flag < ParameterEvent::numFlags; ++flag)
+        {
+            const auto count = report.outliersByEvent[static_cast<size_t>(flag)];
+            if (count > 0)
+                std::cout << "  after " << column(ParameterEvent::toString(1u << flag), 18)
+                          << static_cast<juce::int64>(count) << "\n";
+        }
+    }
+
+    Settings parseArguments(const juce::StringArray& args)
+    {
+        Settings settings;
+
+        auto valueAfter = [&](const char* flag) -> juce::String
+        {
+            const int index = args.indexOf(flag);
+            return index >= 0 && index + 1 < args.size() ? args[index + 1] : juce::String();
+        };
+
+        if (const auto value = valueAfter("--blocks"); value.isNotEmpty())
+            settings.blocks = juce::jmax<juce::int64>(1, value.getLargeIntValue());
+        if (const auto value = valueAfter("--block"); value.isNotEmpty())
+            settings.blockSize = juce::jmax(16, value.getIntValue());
+        if (const auto value = valueAfter("--rate"); value.isNotEmpty())
+            settings.sampleRate = juce::jmax(8000.0, value.getDoubleValue());
+        if (const auto value = valueAfter("--seed"); value.isNotEmpty())
+            settings.seed = value.getLargeIntValue();
+
+        return settings;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser; // Processors expect a message manager
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    const auto settings = parseArguments(args);
+
+    MechaSoundGeneratorAudioProcessor processor;
+    Automation automation(processor, settings);
+    automation.setUp();
+
+    processor.setRateAndBufferSizeDetails(settings.sampleRate, settings.blockSize);
+    processor.prepareToPlay(settings.sampleRate, settings.blockSize);
+    juce::Thread::sleep(kernelBuildMilliseconds);
+
+    juce::AudioBuffer<float> buffer(processor.getTotalNumOutputChannels(), settings.blockSize);
+    juce::MidiBuffer midi;
+
+    // Start counting once the kernels are in and the first blocks have warmed the caches
+    for (int block = 0; block < 100; ++block)
+        processor.processBlock(buffer, midi);
+    processor.getLatencyHistogram().reset();
+
+    std::cout << settings.blocks << " blocks of " << settings.blockSize << " at " << settings.sampleRate
+              << " Hz (budget " << juce::String(1.0e6 * settings.blockSize / settings.sampleRate, 0) << " us)\n" << std::flush;
+
+    for (juce::int64 block = 0; block < settings.blocks; ++block)
+    {
+        automation.beforeBlock();
+        processor.processBlock(buffer, midi);
+    }
+
+    processor.releaseResources();
+
+    const auto report = processor.getLatencyHistogram().getReport();
+    std::cout << automation.activationToggles << " activation toggles, " << automation.complexityJumps
+              << " complexity jumps, " << automation.filterSweeps << " filter sweeps\n\n";
+
+    printHistogram(report);
+    std::cout << "\n" << report.toString();
+    printOutliersByEvent(report);
+    return 0;
+}
@@ -0,0 +1,126 @@
+// Tools/LimiterBenchmark/Main.cpp
+//
+// CPU cost of the master limiter. Build as a JUCE console application with
+// juce_audio_processors and juce_dsp, plus Source/AudioEngine/LookaheadLimiter.cpp.
+//
+//   LimiterBenchmark [--seconds S]
+//
+// Runs LookaheadLimiter on stereo noise that is pushed 6 dB over the ceiling,
+// so the detector and the gain computer work on every sample. It covers the
+// usual sample rates and block sizes, with the limiter on and off, and prints:
+//
+//   ns/frame   time per stereo sample frame
+//   % RT       share of one core at that sample rate
+//   Peak dB    highest output sample, as a check that the ceiling held
+//
+// The "off" rows are the price of the constant latency: the delay line runs
+// even when the limiter is off.
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include <iostream>
+#include <vector>
+#include "../../Source/AudioEngine/LookaheadLimiter.h"
+
+namespace
+{
+    constexpr int numChannels = 2;
+    constexpr float ceilingDb = -1.0f;
+    constexpr float driveDb = 6.0f; // Input level above the ceiling
+
+    struct Result
+    {
+        double nanosecondsPerFrame = 0.0;
+        double realtimePercent = 0.0;
+        float peakDb = -100.0f;
+        int latencySamples = 0;
+    };
+
+    Result run(double sampleRate, int blockSize, bool enabled, double seconds)
+    {
+        LookaheadLimiter limiter;
+        limiter.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+
+        LimiterParams params;
+        params.enabled = enabled;
+        params.ceilingDb = ceilingDb;
+        limiter.setParameters(params);
+
+        // One second of noise, replayed; regenerating it would be measured too
+        juce::Random random(1234);
+        const auto gain = juce::Decibels::decibelsToGain(ceilingDb + driveDb);
+        const int sourceLength = static_cast<int>(sampleRate);
+        juce::AudioBuffer<float> source(numChannels, sourceLength);
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < sourceLength; ++i)
+                source.setSample(channel, i, gain * (2.0f * random.nextFloat() - 1.0f));
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        const auto numBlocks = static_cast<juce::int64>(seconds * sampleRate / blockSize);
+        double processSeconds = 0.0;
+        float peak = 0.0f;
+        int position = 0;
+
+        for (juce::int64 b = 0; b < numBlocks; ++b)
+        {
+            if (position + blockSize > sourceLength)
+                position = 0;
+            for (int channel = 0; channel < numChannels; ++channel)
+                buffer.copyFrom(channel, 0, source, channel, position, blockSize);
+            position += blockSize;
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            limiter.process(juce::dsp::AudioBlock<float>(buffer));
+            processSeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            // Skip the first second: the limiter starts from unity gain
+            if (b * blockSize >= static_cast<juce::int64>(sampleRate))
+                for (int channel = 0; channel < numChannels; ++channel)
+                    peak = juce::jmax(peak, buffer.getMagnitude(channel, 0, blockSize));
+        }
+
+        const double frames = static_cast<double>(numBlocks * blockSize);
+        Result result;
+        result.nanosecondsPerFrame = 1.0e9 * processSeconds / frames;
+        result.realtimePercent = 100.0 * processSeconds / (frames / sampleRate);
+        result.peakDb = juce::Decibels::gainToDecibels(peak, -100.0f);
+        result.latencySamples = limiter.getLatencySamples();
+        return result;
+    }
+
+    juce::String column(const juce::String& text, int width)
+    {
+        return text.substring(0, width).paddedRight(' ', width + 1);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    double seconds = 20.0;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (juce::String(argv[i]) == "--seconds")
+            seconds = juce::jmax(1.0, juce::String(argv[i + 1]).getDoubleValue());
+
+    std::cout << "Stereo noise " << driveDb << " dB over a " << ceilingDb << " dBTP ceiling, "
+              << seconds << " s per row\n\n";
+    std::cout << column("Rate", 7) << column("Block", 6) << column("Limiter", 8) << column("Latency", 8)
+              << column("ns/frame", 9) << column("% RT", 7) << "Peak dB\n";
+
+    for (const double sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+    {
+        for (const int blockSize : { 64, 512 })
+        {
+            for (const bool enabled : { false, true })
+            {
+                const auto result = run(sampleRate, blockSize, enabled, seconds);
+                std::cout << column(juce::String(sampleRate, 0), 7) << column(juce::String(blockSize), 6)
+                          << column(enabled ? "on" : "off", 8) << column(juce::String(result.latencySamples), 8)
+                          << column(juce::String(result.nanosecondsPerFrame, 1), 9)
+                          << column(juce::String(result.realtimePercent, 3), 7)
+                          << juce::String(result.peakDb, 2) << "\n" << std::flush;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+// Tools/NoiseBenchmark/Main.cpp
+//
+// Cost of each hiss noise colour. Build as a JUCE console application with
+// juce_dsp, plus Source/AudioEngine/NoiseGenerator.cpp.
+//
+//   NoiseBenchmark [--seconds S] [--rate R]
+//
+// Runs SimpleNoiseGenerator on stereo sub-blocks of MechaSoundEngine's size,
+// the way the hiss stage calls it, once per colour. For comparison it also
+// times white noise shaped by stacked StateVariableTPTFilter stages, which is
+// how a colour would otherwise be approximated. For each row it prints:
+//
+//   ns/frame   time per stereo sample frame
+//   x white    cost relative to plain white noise
+//   dB/oct     measured spectral slope between 250 Hz and 8 kHz, as a check
+//              that the colour is right (white 0, pink -3, brown -6, blue +3)
+
+#include <juce_dsp/juce_dsp.h>
+#include <iostream>
+#include <vector>
+#include "../../Source/AudioEngine/NoiseGenerator.h"
+
+namespace
+{
+    constexpr int numChannels = 2;
+    constexpr int blockSize = 32;     // MechaSoundEngine::subBlockSize
+    constexpr int fftOrder = 12;
+    constexpr int numSpectrumFrames = 64;
+    constexpr juce::uint32 seed = 1234;
+
+    struct Row
+    {
+        juce::String name;
+        NoiseColour colour = NoiseColour::white;
+        int filterStages = 0; // StateVariableTPTFilter lowpasses after the generator
+    };
+
+    struct Result
+    {
+        double nanosecondsPerFrame = 0.0;
+        double slopeDbPerOctave = 0.0;
+    };
+
+    class Source
+    {
+    public:
+        Source(const Row& row, double sampleRate)
+        {
+            const juce::dsp::ProcessSpec spec{ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) };
+            noise.setSeed(seed);
+            noise.prepare(spec);
+            noise.setColour(row.colour);
+
+            filters.resize(static_cast<size_t>(row.filterStages));
+            for (auto& filter : filters)
+            {
+                filter.prepare(spec);
+                filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+                filter.setCutoffFrequency(1000.0f);
+            }
+        }
+
+        void process(juce::dsp::AudioBlock<float>& block)
+        {
+            juce::dsp::ProcessContextReplacing<float> context(block);
+            noise.process(context);
+            for (auto& filter : filters)
+                filter.process(context);
+        }
+
+    private:
+        SimpleNoiseGenerator noise;
+        std::vector<juce::dsp::StateVariableTPTFilter<float>> filters;
+    };
+
+    double measureSlope(const Row& row, double sampleRate)
+    {
+        Source source(row, sampleRate);
+        constexpr int fftSize = 1 << fftOrder;
+        juce::dsp::FFT fft(fftOrder);
+        juce::dsp::WindowingFunction<float> window(fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+
+        juce::AudioBuffer<float> buffer(numChannels, fftSize);
+        std::vector<float> frame(2 * fftSize);
+        std::vector<double> power(fftSize / 2 + 1, 0.0);
+
+        for (int f = 0; f < numSpectrumFrames; ++f)
+        {
+            juce::dsp::AudioBlock<float> whole(buffer);
+            for (int start = 0; start < fftSize; start += blockSize)
+            {
+                auto part = whole.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(blockSize));
+                source.process(part);
+            }
+
+            std::fill(frame.begin(), frame.end(), 0.0f);
+            std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + fftSize, frame.begin());
+            window.multiplyWithWindowingTable(frame.data(), fftSize);
+            fft.performFrequencyOnlyForwardTransform(frame.data());
+
+            for (size_t bin = 0; bin < power.size(); ++bin)
+                power[bin] += static_cast<double>(frame[bin]) * frame[bin];
+        }
+
+        // Mean power density over an octave band starting at 'low'
+        auto bandDensity = [&](double low)
+        {
+            const auto first = static_cast<size_t>(low * fftSize / sampleRate);
+            const auto last = static_cast<size_t>(2.0 * low * fftSize / sampleRate);
+            double sum = 0.0;
+            for (size_t bin = first; bin < last; ++bin)
+                sum += power[bin];
+            return sum / static_cast<double>(last - first);
+        };
+
+        constexpr double lowBand = 250.0, highBand = 4000.0; // Four octaves apart
+        return 10.0 * std::log10(bandDensity(highBand) / bandDensity(lowBand)) / 4.0;
+    }
+
+    Result run(const Row& row, double sampleRate, double seconds)
+    {
+        Source source(row, sampleRate);
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::dsp::AudioBlock<float> block(buffer);
+
+        const auto numBlocks = static_cast<juce::int64>(seconds * sampleRate / blockSize);
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (juce::int64 b = 0; b < numBlocks; ++b)
+            source.process(block);
+        const double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        Result result;
+        result.nanosecondsPerFrame = 1.0e9 * elapsed / static_cast<double>(numBlocks * blockSize);
+        result.slopeDbPerOctave = measureSlope(row, sampleRate);
+        return result;
+    }
+
+    juce::String column(const juce::String& text, int width)
+    {
+        return text.substring(0, width).paddedRight(' ', width + 1);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    double seconds = 10.0;
+    double sampleRate = 48000.0;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        const juce::String flag(argv[i]);
+        const juce::String value(argv[i + 1]);
+        if (flag == "--seconds")
+            seconds = juce::jmax(1.0, value.getDoubleValue());
+        else if (flag == "--rate")
+            sampleRate = juce::jmax(8000.0, value.getDoubleValue());
+    }
+
+    const Row rows[] = {
+        { "White", NoiseColour::white, 0 },
+        { "Pink", NoiseColour::pink, 0 },
+        { "Brown", NoiseColour::brown, 0 },
+        { "Blue", NoiseColour::blue, 0 },
+        { "White + 1 TPT", NoiseColour::white, 1 },
+        { "White + 3 TPT", NoiseColour::white, 3 },
+    };
+
+    std::cout << "Stereo, " << blockSize << "-sample blocks at " << sampleRate << " Hz, "
+              << seconds << " s per row\n\n";
+    std::cout << column("Source", 14) << column("ns/frame", 9) << column("x white", 8) << "dB/oct\n";
+
+    double whiteCost = 0.0;
+    for (const auto& row : rows)
+    {
+        const auto result = run(row, sampleRate, seconds);
+        if (row.colour == NoiseColour::white && row.filterStages == 0)
+            whiteCost = result.nanosecondsPerFrame;
+
+        std::cout << column(row.name, 14) << column(juce::String(result.nanosecondsPerFrame, 1), 9)
+                  << column(juce::String(result.nanosecondsPerFrame / whiteCost, 2), 8)
+                  << juce::String(result.slopeDbPerOctave, 1) << "\n" << std::flush;
+    }
+
+    return 0;
+}
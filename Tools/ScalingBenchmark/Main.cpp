@@ -0,0 +1,344 @@
+// Tools/ScalingBenchmark/Main.cpp
+//
+// Multi-instance scaling benchmark. Build as a JUCE console application from
+// the plugin's Source folder and JUCE modules, without a plugin wrapper.
+//
+//   ScalingBenchmark [--threads M] [--instances N] [--seconds S] [--block B] [--rate R] [--foley FILE]
+//
+// Renders N processors from M worker threads the way a host with multicore
+// rendering does. Each block cycle hands the instances to the workers
+// through a shared counter, and the cycle ends when every instance has
+// processed its block. N doubles from 1 up to --instances (256 by default).
+//
+// For each N the table shows:
+//   RTF        audio rendered per second of wall time, summed over instances
+//   Eff %      RTF / (workers x RTF of one instance on one thread): 100 % is
+//              perfect scaling, lower means shared state or memory bandwidth
+//              is getting in the way
+//   p99 load   99th percentile cycle time as a share of the block duration
+//
+// The last line gives the largest N for which it and every smaller N keep
+// the p99 load under maxCycleLoad: how many instances this machine can
+// sustain live.
+//
+// Every instance plays the default engines at typical levels (core, hiss,
+// servo, granular) in the longest space, so all of them do real work.
+// --foley streams FILE under them too.
+//
+// What processBlock shares or synchronises with:
+//   - Parameter IDs are constexpr, and the convolution kernels are one
+//     read-only set per sample rate (see ImpulseResponseLibrary).
+//   - The morph pad and the modulation matrix only try-lock a SpinLock and
+//     keep their previous values when it is busy, so they never wait.
+//   - Telemetry goes to a memory-mapped file per instance, with plain stores.
+//   - A program change resets the foley engines from processBlock. That
+//     reset only sets a flag, which the prefetch thread polls; it does not
+//     signal it, because Thread::notify() takes a lock. Stale frames are
+//     skipped by a counter, so neither side waits for the other.
+// Other threads per instance compete with the workers for cores:
+//   - One prefetch thread serves the foley engines of both engine slots. It
+//     runs only while a file is loaded (--foley), and wakes every few
+//     milliseconds.
+//   - The spectrum analyser thread runs only while an editor shows it, so it
+//     is idle here.
+// So without --foley, a drop in efficiency points at the caches. With it,
+// the prefetch threads can also take cores from the workers.
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_events/juce_events.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double maxCycleLoad = 0.8; // Headroom a live host needs for everything else
+    constexpr double warmUpSeconds = 0.5;
+    constexpr int kernelBuildMilliseconds = 1000;
+
+    struct Settings
+    {
+        int threads = juce::jmax(1, static_cast<int>(std::thread::hardware_concurrency()));
+        int maxInstances = 256;
+        double seconds = 5.0; // Audio rendered by each instance
+        int blockSize = 256;
+        double sampleRate = 48000.0;
+        juce::File foleyFile;
+    };
+
+    struct Instance
+    {
+        std::unique_ptr<MechaSoundGeneratorAudioProcessor> processor;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+    };
+
+    struct Result
+    {
+        int instances = 0;
+        int threads = 0;
+        double realtimeFactor = 0.0;
+        double averageCycleMilliseconds = 0.0;
+        double p99CycleMilliseconds = 0.0;
+        double budgetMilliseconds = 0.0;
+        int missedCycles = 0; // Cycles longer than the block itself
+    };
+
+    //==============================================================================
+    // M workers that process every instance once per cycle, like a host's render threads
+    class RenderPool
+    {
+    public:
+        RenderPool(std::vector<Instance>& instancesToRender, int numThreads)
+            : instances(instancesToRender)
+        {
+            for (int i = 0; i < numThreads; ++i)
+                workers.emplace_back([this] { workerLoop(); });
+        }
+
+        ~RenderPool()
+        {
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                quit = true;
+            }
+            wake.notify_all();
+
+            for (auto& worker : workers)
+                worker.join();
+        }
+
+        /** @brief Processes one block on every instance and returns when all are done. */
+        void renderCycle()
+        {
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                nextInstance.store(0, std::memory_order_relaxed);
+                remaining = static_cast<int>(workers.size());
+                ++generation;
+            }
+            wake.notify_all();
+
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return remaining == 0; });
+        }
+
+    private:
+        void workerLoop()
+        {
+            juce::uint64 seenGeneration = 0;
+
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [&] { return quit || generation != seenGeneration; });
+                    if (quit)
+                        return;
+                    seenGeneration = generation;
+                }
+
+                for (;;)
+                {
+                    const auto index = nextInstance.fetch_add(1, std::memory_order_relaxed);
+                    if (index >= instances.size())
+                        break;
+
+                    auto& instance = instances[index];
+                    instance.midi.clear();
+                    instance.processor->processBlock(instance.buffer, instance.midi);
+                }
+
+                const std::lock_guard<std::mutex> lock(mutex);
+                if (--remaining == 0)
+                    done.notify_one();
+            }
+        }
+
+        std::vector<Instance>& instances;
+        std::vector<std::thread> workers;
+        std::atomic<size_t> nextInstance{ 0 };
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        juce::uint64 generation = 0;
+        int remaining = 0;
+        bool quit = false;
+    };
+
+    //==============================================================================
+    void setParameter(MechaSoundGeneratorAudioProcessor& processor, const char* id, float value)
+    {
+        if (auto* parameter = processor.apvts.getParameter(id))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    std::vector<Instance> createInstances(int count, const Settings& settings)
+    {
+        std::vector<Instance> instances(static_cast<size_t>(count));
+
+        for (auto& instance : instances)
+        {
+            instance.processor = std::make_unique<MechaSoundGeneratorAudioProcessor>();
+
+            // Every default engine sounding, in the longest space: the heaviest realistic load
+            auto& processor = *instance.processor;
+            setParameter(processor, ParameterIDs::powerCoreHumLevel, 0.7f);
+            setParameter(processor, ParameterIDs::powerCoreActivationTrigger, 1.0f);
+            setParameter(processor, ParameterIDs::powerCoreHumComplexity, 0.5f);
+            setParameter(processor, ParameterIDs::hissLevel, 0.2f);
+            setParameter(processor, ParameterIDs::servoLevel, 0.3f);
+            setParameter(processor, ParameterIDs::granularLevel, 0.3f);
+            setParameter(processor, ParameterIDs::convolutionSpace, static_cast<float>(ImpulseResponseLibrary::hangar));
+            setParameter(processor, ParameterIDs::convolutionMix, 0.4f);
+
+            if (settings.foleyFile != juce::File() && processor.loadFoleyFile(settings.foleyFile))
+                setParameter(processor, ParameterIDs::foleyLevel, 0.3f);
+
+            instance.processor->setRateAndBufferSizeDetails(settings.sampleRate, settings.blockSize);
+            instance.processor->prepareToPlay(settings.sampleRate, settings.blockSize);
+            instance.buffer.setSize(instance.processor->getTotalNumOutputChannels(), settings.blockSize);
+        }
+
+        return instances;
+    }
+
+    Result runConfiguration(int numInstances, int numThreads, const Settings& settings)
+    {
+        auto instances = createInstances(numInstances, settings);
+        juce::Thread::sleep(kernelBuildMilliseconds);
+
+        Result result;
+        result.instances = numInstances;
+        result.threads = numThreads;
+        result.budgetMilliseconds = 1000.0 * settings.blockSize / settings.sampleRate;
+
+        const int warmUpCycles = juce::roundToInt(warmUpSeconds * settings.sampleRate / settings.blockSize);
+        const int numCycles = juce::jmax(1, juce::roundToInt(settings.seconds * settings.sampleRate / settings.blockSize));
+        std::vector<double> cycleMilliseconds;
+        cycleMilliseconds.reserve(static_cast<size_t>(numCycles));
+
+        {
+            RenderPool pool(instances, numThreads);
+
+            for (int cycle = 0; cycle < warmUpCycles; ++cycle)
+                pool.renderCycle();
+
+            for (int cycle = 0; cycle < numCycles; ++cycle)
+            {
+                const auto start = juce::Time::getHighResolutionTicks();
+                pool.renderCycle();
+                cycleMilliseconds.push_back(1000.0 * juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+            }
+        }
+
+        double totalMilliseconds = 0.0;
+        for (const auto milliseconds : cycleMilliseconds)
+        {
+            totalMilliseconds += milliseconds;
+            if (milliseconds > result.budgetMilliseconds)
+                ++result.missedCycles;
+        }
+
+        const double audioSeconds = numInstances * numCycles * settings.blockSize / settings.sampleRate;
+        result.realtimeFactor = totalMilliseconds > 0.0 ? 1000.0 * audioSeconds / totalMilliseconds : 0.0;
+        result.averageCycleMilliseconds = totalMilliseconds / numCycles;
+
+        const auto p99 = cycleMilliseconds.begin() + static_cast<std::ptrdiff_t>(0.99 * (cycleMilliseconds.size() - 1));
+        std::nth_element(cycleMilliseconds.begin(), p99, cycleMilliseconds.end());
+        result.p99CycleMilliseconds = *p99;
+
+        return result;
+    }
+
+    //==============================================================================
+    juce::String column(const juce::String& text, int width)
+    {
+        return text.substring(0, width).paddedRight(' ', width + 1);
+    }
+
+    void printHeader()
+    {
+        std::cout << column("Instances", 9) << column("Threads", 7) << column("RTF", 9) << column("Eff %", 6)
+                  << column("Avg ms", 8) << column("p99 ms", 8) << column("p99 load", 8) << "Missed\n";
+    }
+
+    void printRow(const Result& r, double singleRealtimeFactor)
+    {
+        const double efficiency = singleRealtimeFactor > 0.0 ? 100.0 * r.realtimeFactor / (r.threads * singleRealtimeFactor) : 0.0;
+
+        std::cout << column(juce::String(r.instances), 9) << column(juce::String(r.threads), 7)
+                  << column(juce::String(r.realtimeFactor, 1), 9) << column(juce::String(efficiency, 0), 6)
+                  << column(juce::String(r.averageCycleMilliseconds, 3), 8) << column(juce::String(r.p99CycleMilliseconds, 3), 8)
+                  << column(juce::String(100.0 * r.p99CycleMilliseconds / r.budgetMilliseconds, 0) + " %", 8)
+                  << r.missedCycles << "\n" << std::flush;
+    }
+
+    Settings parseArguments(const juce::StringArray& args)
+    {
+        Settings settings;
+
+        auto valueAfter = [&](const char* flag) -> juce::String
+        {
+            const int index = args.indexOf(flag);
+            return index >= 0 && index + 1 < args.size() ? args[index + 1] : juce::String();
+        };
+
+        if (const auto value = valueAfter("--threads"); value.isNotEmpty())
+            settings.threads = juce::jmax(1, value.getIntValue());
+        if (const auto value = valueAfter("--instances"); value.isNotEmpty())
+            settings.maxInstances = juce::jmax(1, value.getIntValue());
+        if (const auto value = valueAfter("--seconds"); value.isNotEmpty())
+            settings.seconds = juce::jmax(0.1, value.getDoubleValue());
+        if (const auto value = valueAfter("--block"); value.isNotEmpty())
+            settings.blockSize = juce::jmax(16, value.getIntValue());
+        if (const auto value = valueAfter("--rate"); value.isNotEmpty())
+            settings.sampleRate = juce::jmax(8000.0, value.getDoubleValue());
+        if (const auto value = valueAfter("--foley"); value.isNotEmpty())
+            settings.foleyFile = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+
+        return settings;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser; // Processors expect a message manager
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    const auto settings = parseArguments(args);
+
+    std::cout << "Block " << settings.blockSize << " at " << settings.sampleRate << " Hz, "
+              << settings.seconds << " s per instance, up to " << settings.threads << " threads\n\n";
+
+    // Reference for efficiency: one instance alone on one thread
+    const auto single = runConfiguration(1, 1, settings);
+
+    printHeader();
+    printRow(single, single.realtimeFactor);
+
+    int sustainable = single.p99CycleMilliseconds < maxCycleLoad * single.budgetMilliseconds ? 1 : 0;
+
+    for (int instances = 2; instances <= settings.maxInstances; instances *= 2)
+    {
+        // A host never runs more render threads than it has tracks
+        const auto result = runConfiguration(instances, juce::jmin(settings.threads, instances), settings);
+        printRow(result, single.realtimeFactor);
+
+        if (sustainable == instances / 2 && result.p99CycleMilliseconds < maxCycleLoad * result.budgetMilliseconds)
+            sustainable = instances;
+    }
+
+    std::cout << "\nSustainable live: " << sustainable << " instances (p99 cycle under "
+              << juce::roundToInt(100.0 * maxCycleLoad) << " % of the block)\n";
+    return 0;
+}
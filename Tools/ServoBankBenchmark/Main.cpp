@@ -0,0 +1,119 @@
+// Tools/ServoBankBenchmark/Main.cpp
+//
+// Cost per servo of ServoBankEngine against separate ServoEngines. Build as a
+// JUCE console application with juce_dsp, plus Source/AudioEngine/ServoEngine.cpp
+// and Source/AudioEngine/ServoBankEngine.cpp. Build it once per target (for
+// example plain x86-64 and -march=x86-64-v3) to compare instruction sets.
+//
+//   ServoBankBenchmark [--seconds S] [--rate R]
+//
+// For 1, 4, 8 and 16 servos it renders stereo sub-blocks of MechaSoundEngine's
+// size, the way the engine list calls them, once through a single bank with
+// servoBankSize set to the count and once through that many ServoEngines
+// adding into the same block. It prints the time per servo per sample frame
+// for both, and their ratio. These are the figures quoted in ServoBankEngine.h.
+
+#include <juce_dsp/juce_dsp.h>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "../../Source/AudioEngine/ServoEngine.h"
+#include "../../Source/AudioEngine/ServoBankEngine.h"
+
+namespace
+{
+    constexpr int numChannels = 2;
+    constexpr int blockSize = 32; // MechaSoundEngine::subBlockSize
+
+    EngineParameterSet createParameters(int numServos)
+    {
+        EngineParameterSet params;
+        params.servo.level = 0.5f;
+        params.servo.pitch = 440.0f;
+        params.servo.modDepth = 0.2f;
+        params.servo.modRate = 3.0f;
+        params.servo.bankSize = numServos;
+        return params;
+    }
+
+    // Nanoseconds per servo per sample frame for 'engines' adding into one stereo block
+    double measure(std::vector<std::unique_ptr<SoundEngineBase>>& engines, int numServos, double sampleRate, double seconds)
+    {
+        const juce::dsp::ProcessSpec spec{ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) };
+        const auto params = createParameters(numServos);
+        for (auto& engine : engines)
+        {
+            engine->prepare(spec);
+            engine->updateParameters(params);
+        }
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::dsp::AudioBlock<float> block(buffer);
+        juce::dsp::ProcessContextReplacing<float> context(block);
+
+        auto renderBlock = [&]
+        {
+            block.clear();
+            for (auto& engine : engines)
+                engine->processAddingTo(context);
+        };
+
+        // Warm up the caches and branch predictors first
+        for (int b = 0; b < 1000; ++b)
+            renderBlock();
+
+        const auto numBlocks = static_cast<juce::int64>(seconds * sampleRate / blockSize);
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (juce::int64 b = 0; b < numBlocks; ++b)
+            renderBlock();
+        const double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        // Keeps the output observable, so the loop cannot be dropped
+        if (buffer.getMagnitude(0, blockSize) > 1000.0f)
+            std::cout << "(unexpected level)\n";
+
+        return 1.0e9 * elapsed / static_cast<double>(numBlocks * blockSize * numServos);
+    }
+
+    juce::String column(const juce::String& text, int width)
+    {
+        return text.substring(0, width).paddedRight(' ', width + 1);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    double seconds = 5.0;
+    double sampleRate = 48000.0;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        const juce::String flag(argv[i]);
+        const juce::String value(argv[i + 1]);
+        if (flag == "--seconds")
+            seconds = juce::jmax(1.0, value.getDoubleValue());
+        else if (flag == "--rate")
+            sampleRate = juce::jmax(8000.0, value.getDoubleValue());
+    }
+
+    std::cout << "Stereo, " << blockSize << "-sample blocks at " << sampleRate << " Hz, "
+              << seconds << " s per measurement\n\n";
+    std::cout << column("Servos", 7) << column("Bank ns", 8) << column("Separate ns", 12) << "Separate / bank\n";
+
+    for (const int numServos : { 1, 4, 8, 16 })
+    {
+        std::vector<std::unique_ptr<SoundEngineBase>> bank;
+        bank.push_back(std::make_unique<ServoBankEngine>());
+
+        std::vector<std::unique_ptr<SoundEngineBase>> separate;
+        for (int i = 0; i < numServos; ++i)
+            separate.push_back(std::make_unique<ServoEngine>());
+
+        const double bankCost = measure(bank, numServos, sampleRate, seconds);
+        const double separateCost = measure(separate, numServos, sampleRate, seconds);
+
+        std::cout << column(juce::String(numServos), 7) << column(juce::String(bankCost, 1), 8)
+                  << column(juce::String(separateCost, 1), 12) << juce::String(separateCost / bankCost, 2) << "\n" << std::flush;
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Tools/TelemetryMonitor/Main.cpp
+//
+// Console monitor for every running MechaSound instance on this machine.
+// Build as a JUCE console application with juce_core only.
+//
+//   TelemetryMonitor           refresh the table once a second
+//   TelemetryMonitor --once    print the table once and exit
+//
+// Each instance publishes a TelemetryRecord in a memory-mapped file (see
+// Source/Diagnostics/TelemetryRecord.h). The monitor only reads: it maps each
+// file read-only and copies the record through its seqlock, so it never
+// slows down the audio thread that writes it.
+
+#include <juce_core/juce_core.h>
+#include <cstring>
+#include <iostream>
+#include "../../Source/Diagnostics/TelemetryRecord.h"
+
+namespace
+{
+    constexpr int refreshMilliseconds = 1000;
+    constexpr double staleSeconds = 2.0; // No block for this long: host stopped, or instance crashed
+
+    struct InstanceRow
+    {
+        juce::String id;
+        juce::String host;
+        TelemetryRecord::Snapshot snapshot;
+        bool consistent = false;
+    };
+
+    std::vector<InstanceRow> readInstances()
+    {
+        std::vector<InstanceRow> rows;
+        const auto files = TelemetryRecord::getTelemetryDirectory().findChildFiles(
+            juce::File::findFiles, false, juce::String("*") + TelemetryRecord::fileExtension);
+
+        for (const auto& file : files)
+        {
+            juce::MemoryMappedFile mapping(file, juce::MemoryMappedFile::readOnly);
+            if (mapping.getData() == nullptr || mapping.getSize() < sizeof(TelemetryRecord))
+                continue;
+
+            const auto* record = static_cast<const TelemetryRecord*>(mapping.getData());
+            if (!record->isValid())
+                continue;
+
+            InstanceRow row;
+            row.id = file.getFileNameWithoutExtension();
+            row.host = juce::String::fromUTF8(record->hostName, static_cast<int>(strnlen(record->hostName, TelemetryRecord::hostNameLength)));
+            row.consistent = record->read(row.snapshot);
+            rows.push_back(row);
+        }
+
+        return rows;
+    }
+
+    juce::String column(const juce::String& text, int width)
+    {
+        return text.substring(0, width).paddedRight(' ', width + 1);
+    }
+
+    void printTable(const std::vector<InstanceRow>& rows)
+    {
+        const auto now = juce::Time::getHighResolutionTicks();
+
+        std::cout << column("Instance", 16) << column("Host", 16) << column("Rate", 7) << column("Block", 6)
+                  << column("Avg us", 8) << column("Max us", 8) << column("Load %", 7) << column("Overruns", 9)
+                  << column("Engines", 8) << column("Peak dB", 8) << "State\n";
+
+        for (const auto& row : rows)
+        {
+            const auto& s = row.snapshot;
+            const double age = juce::Time::highResolutionTicksToSeconds(now - s.updateTicks);
+            const double load = s.blockBudgetMicroseconds > 0.0f ? 100.0 * s.averageBlockMicroseconds / s.blockBudgetMicroseconds : 0.0;
+
+            juce::String state = "ok";
+            if (!row.consistent)
+                state = "busy";
+            else if (s.blocksProcessed == 0)
+                state = "idle";
+            else if (age > staleSeconds)
+                state = "stale " + juce::String(age, 0) + " s";
+
+            std::cout << column(row.id, 16) << column(row.host, 16)
+                      << column(juce::String(s.sampleRate, 0), 7) << column(juce::String(s.blockSize), 6)
+                      << column(juce::String(s.averageBlockMicroseconds, 1), 8) << column(juce::String(s.maxBlockMicroseconds, 1), 8)
+                      << column(juce::String(load, 1), 7) << column(juce::String(static_cast<juce::int64>(s.overruns)), 9)
+                      << column(juce::String(s.activeEngines), 8)
+                      << column(juce::String(juce::Decibels::gainToDecibels(s.outputPeak, -120.0f), 1), 8)
+                      << state << "\n";
+        }
+
+        if (rows.empty())
+            std::cout << "No instances in " << TelemetryRecord::getTelemetryDirectory().getFullPathName() << "\n";
+
+        std::cout << std::flush;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const bool once = argc > 1 && juce::String(argv[1]) == "--once";
+
+    for (;;)
+    {
+        const auto rows = readInstances();
+
+        if (!once)
+            std::cout << "\x1b[2J\x1b[H"; // Clear the terminal between refreshes
+
+        printTable(rows);
+
+        if (once)
+            return 0;
+
+        juce::Thread::sleep(refreshMilliseconds);
+    }
+}